@@ -9,7 +9,7 @@
 // specifications, and documentation provided by HTC to You."
 
 #include "Eye/FWaveVREyeRunnable.h"
-#include "HAL/RunnableThread.h"
+#include "FWaveVRServiceThread.h"
 
 #include "wvr_eyetracking.h"
 #include "Platforms/WaveVRAPIWrapper.h"
@@ -24,120 +24,88 @@ FWaveVREyeRunnable* FWaveVREyeRunnable::Runnable = NULL;
 //***********************************************************
 
 FWaveVREyeRunnable::FWaveVREyeRunnable()
-	: shutDownThread(false)
-	, getSupportedFeature(false)
-	, eyeTrackingStatus(EWaveVREyeTrackingStatus::NOT_START)
+	: eyeTrackingStatus(EWaveVREyeTrackingStatus::NOT_START)
 {
-	Thread = FRunnableThread::Create(this, TEXT("FWaveVREyeRunnable"));
+	FWaveVRServiceThread::Get()->Enqueue([this]() { CheckSupportedFeature(); });
 }
 
 FWaveVREyeRunnable::~FWaveVREyeRunnable()
 {
-	delete Thread;
-	Thread = NULL;
 }
 
-//Init
-bool FWaveVREyeRunnable::Init()
+void FWaveVREyeRunnable::CheckSupportedFeature()
 {
-	return true;
+	uint64_t supportedFeatures = FWaveVRAPIWrapper::GetInstance()->GetSupportedFeatures();
+	if ((supportedFeatures & (uint64_t)WVR_SupportedFeature::WVR_SupportedFeature_EyeTracking) == 0)
+	{
+		eyeTrackingStatus = EWaveVREyeTrackingStatus::UNSUPPORT;
+	}
+	else
+	{
+		eyeTrackingStatus = EWaveVREyeTrackingStatus::NOT_START;
+	}
+
+	LOGD(LogWaveVREyeRunnable, "CheckSupportedFeature() supportedFeatures %d, eyeTrackingStatus %d", (int)supportedFeatures, (int)eyeTrackingStatus);
 }
 
-//Run
-uint32 FWaveVREyeRunnable::Run()
+void FWaveVREyeRunnable::RunAction(Actions action)
 {
-	//Initial wait before starting
-	FPlatformProcess::Sleep(0.03);
-
-	while (!shutDownThread)
+	m_mutex.Lock();
+	switch (action)
 	{
-		if (!getSupportedFeature)
+	case Actions::StartTracking:
+		if (eyeTrackingStatus == EWaveVREyeTrackingStatus::NOT_START ||
+			eyeTrackingStatus == EWaveVREyeTrackingStatus::START_FAILURE)
 		{
-			uint64_t supportedFeatures = FWaveVRAPIWrapper::GetInstance()->GetSupportedFeatures();
-			if ((supportedFeatures & (uint64_t)WVR_SupportedFeature::WVR_SupportedFeature_EyeTracking) == 0)
+			eyeTrackingStatus = EWaveVREyeTrackingStatus::STARTING;
+			LOGD(LogWaveVREyeRunnable, "RunAction() Start eye tracking.");
+			WVR_Result result = FWaveVRAPIWrapper::GetInstance()->StartEyeTracking();
+			switch (result)
 			{
+			case WVR_Result::WVR_Error_FeatureNotSupport:
 				eyeTrackingStatus = EWaveVREyeTrackingStatus::UNSUPPORT;
-			}
-			else
-			{
-				eyeTrackingStatus = EWaveVREyeTrackingStatus::NOT_START;
-			}
-
-			LOGD(LogWaveVREyeRunnable, "Run() supportedFeatures %d, eyeTrackingStatus %d", (int)supportedFeatures, (int)eyeTrackingStatus);
-			getSupportedFeature = true;
-		}
-
-		bool has_action = qActions.Dequeue(action);
-		if (has_action)
-		{
-			m_mutex.Lock();
-			switch (action)
-			{
-			case Actions::StartTracking:
-				if (eyeTrackingStatus == EWaveVREyeTrackingStatus::NOT_START ||
-					eyeTrackingStatus == EWaveVREyeTrackingStatus::START_FAILURE)
-				{
-					eyeTrackingStatus = EWaveVREyeTrackingStatus::STARTING;
-					LOGD(LogWaveVREyeRunnable, "Run() Start eye tracking.");
-					WVR_Result result = FWaveVRAPIWrapper::GetInstance()->StartEyeTracking();
-					switch (result)
-					{
-					case WVR_Result::WVR_Error_FeatureNotSupport:
-						eyeTrackingStatus = EWaveVREyeTrackingStatus::UNSUPPORT;
-						break;
-					case WVR_Result::WVR_Success:
-						eyeTrackingStatus = EWaveVREyeTrackingStatus::AVAILABLE;
-						break;
-					default:
-						eyeTrackingStatus = EWaveVREyeTrackingStatus::START_FAILURE;
-						break;
-					}
-					LOGD(LogWaveVREyeRunnable, "Run() Start eye tracking result: %d", (uint8)result);
-				}
 				break;
-			case Actions::StopTracking:
-				if (eyeTrackingStatus == EWaveVREyeTrackingStatus::AVAILABLE)
-				{
-					eyeTrackingStatus = EWaveVREyeTrackingStatus::STOPPING;
-					LOGD(LogWaveVREyeRunnable, "Run() Stop eye tracking.");
-					FWaveVRAPIWrapper::GetInstance()->StopEyeTracking();
-					eyeTrackingStatus = EWaveVREyeTrackingStatus::NOT_START;
-					LOGD(LogWaveVREyeRunnable, "Run() Eye tracking stopped.");
-				}
+			case WVR_Result::WVR_Success:
+				eyeTrackingStatus = EWaveVREyeTrackingStatus::AVAILABLE;
 				break;
 			default:
+				eyeTrackingStatus = EWaveVREyeTrackingStatus::START_FAILURE;
 				break;
 			}
-			m_mutex.Unlock();
+			LOGD(LogWaveVREyeRunnable, "RunAction() Start eye tracking result: %d", (uint8)result);
+		}
+		break;
+	case Actions::StopTracking:
+		if (eyeTrackingStatus == EWaveVREyeTrackingStatus::AVAILABLE)
+		{
+			eyeTrackingStatus = EWaveVREyeTrackingStatus::STOPPING;
+			LOGD(LogWaveVREyeRunnable, "RunAction() Stop eye tracking.");
+			FWaveVRAPIWrapper::GetInstance()->StopEyeTracking();
+			eyeTrackingStatus = EWaveVREyeTrackingStatus::NOT_START;
+			LOGD(LogWaveVREyeRunnable, "RunAction() Eye tracking stopped.");
 		}
-		FPlatformProcess::Sleep(0.1);
+		break;
+	default:
+		break;
 	}
-
-	return 0;
-}
-
-//stop
-void FWaveVREyeRunnable::Stop()
-{
+	m_mutex.Unlock();
 }
 
 FWaveVREyeRunnable* FWaveVREyeRunnable::JoyInit()
 {
-	//Create new instance of thread if it does not exist
+	//Create new instance if it does not exist
 	//		and the platform supports multi threading!
-	if (!Runnable && FPlatformProcess::SupportsMultithreading())
+	if (!Runnable && FWaveVRServiceThread::Get())
 	{
 		Runnable = new FWaveVREyeRunnable();
-		LOGD(LogWaveVREyeRunnable, "JoyInit() Create new thread.");
+		LOGD(LogWaveVREyeRunnable, "JoyInit() Create new instance.");
 	}
 	return Runnable;
 }
 
 void FWaveVREyeRunnable::EnsureCompletion()
 {
-	shutDownThread = true;
-	Stop();
-	Thread->WaitForCompletion();
+	FWaveVRServiceThread::Get()->Flush();
 }
 
 void FWaveVREyeRunnable::Shutdown()
@@ -152,16 +120,21 @@ void FWaveVREyeRunnable::Shutdown()
 
 void FWaveVREyeRunnable::StartEyeTracking()
 {
-	qActions.Enqueue(Actions::StartTracking);
+	RequestAction(Actions::StartTracking);
 }
 
 void FWaveVREyeRunnable::StopEyeTracking()
 {
-	qActions.Enqueue(Actions::StopTracking);
+	RequestAction(Actions::StopTracking);
 }
 
 void FWaveVREyeRunnable::RestartEyeTracking()
 {
-	qActions.Enqueue(Actions::StopTracking);
-	qActions.Enqueue(Actions::StartTracking);
+	RequestAction(Actions::StopTracking);
+	RequestAction(Actions::StartTracking);
+}
+
+void FWaveVREyeRunnable::RequestAction(Actions action)
+{
+	FWaveVRServiceThread::Get()->Enqueue([this, action]() { RunAction(action); });
 }
@@ -16,6 +16,7 @@
 #include "Platforms/WaveVRAPIWrapper.h"
 #include "Platforms/WaveVRLogWrapper.h"
 #include "WaveVRUtils.h"
+#include "WaveVRDeviceSnapshot.h"
 using namespace wvr::utils;
 
 DEFINE_LOG_CATEGORY_STATIC(LogWaveVREyeManager, Log, All);
@@ -67,7 +68,7 @@ void WaveVREyeManager::InitEyeData()
 	LOGD(LogWaveVREyeManager, "InitEyeData()");
 }
 
-void WaveVREyeManager::TickEyeData()
+void WaveVREyeManager::TickEyeData(const FWaveVRDeviceSnapshot& snapshot)
 {
 	logCount++;
 	logCount %= 500;
@@ -94,7 +95,7 @@ void WaveVREyeManager::TickEyeData()
 		else
 		{
 			hasEyeData = (FWaveVRAPIWrapper::GetInstance()->GetEyeTracking(&eyeData, static_cast<WVR_CoordinateSystem>(locationSpace)) == WVR_Result::WVR_Success);
-			if (hasEyeData) UpdateEyeData();
+			if (hasEyeData) UpdateEyeData(snapshot.WorldToMeters);
 
 			if (printable)
 			{
@@ -119,7 +120,7 @@ void WaveVREyeManager::TickEyeData()
 	}
 }
 
-void WaveVREyeManager::UpdateEyeData()
+void WaveVREyeManager::UpdateEyeData(float worldToMeters)
 {
 	if (!hasEyeData)
 		return;
@@ -127,20 +128,20 @@ void WaveVREyeManager::UpdateEyeData()
 	/* Combined Eye */
 	combinedMask = eyeData.combined.eyeTrackingValidBitMask;
 	if ((combinedMask & (uint64_t)WVR_EyeTrackingStatus::WVR_GazeOriginValid) != 0)
-		combinedOrigin = CoordinateUtil::GetVector3(eyeData.combined.gazeOrigin, GetWorldToMetersScale());
+		combinedOrigin = CoordinateUtil::GetVector3(eyeData.combined.gazeOrigin, worldToMeters);
 	if ((combinedMask & (uint64_t)WVR_EyeTrackingStatus::WVR_GazeDirectionNormalizedValid) != 0)
 	{
-		combinedDirection = CoordinateUtil::GetVector3(eyeData.combined.gazeDirectionNormalized, GetWorldToMetersScale());
+		combinedDirection = CoordinateUtil::GetVector3(eyeData.combined.gazeDirectionNormalized, worldToMeters);
 		if (NormalizeX) { CoordinateUtil::Vector3NormalizeX(combinedDirection); }
 	}
 
 	/* Left Eye */
 	leftMask = eyeData.left.eyeTrackingValidBitMask;
 	if ((leftMask & (uint64_t)WVR_EyeTrackingStatus::WVR_GazeOriginValid) != 0)
-		leftOrigin = CoordinateUtil::GetVector3(eyeData.left.gazeOrigin, GetWorldToMetersScale());
+		leftOrigin = CoordinateUtil::GetVector3(eyeData.left.gazeOrigin, worldToMeters);
 	if ((leftMask & (uint64_t)WVR_EyeTrackingStatus::WVR_GazeDirectionNormalizedValid) != 0)
 	{
-		leftDirection = CoordinateUtil::GetVector3(eyeData.left.gazeDirectionNormalized, GetWorldToMetersScale());
+		leftDirection = CoordinateUtil::GetVector3(eyeData.left.gazeDirectionNormalized, worldToMeters);
 		if (NormalizeX) { CoordinateUtil::Vector3NormalizeX(leftDirection); }
 	}
 	if ((leftMask & (uint64_t)WVR_EyeTrackingStatus::WVR_EyeOpennessValid) != 0)
@@ -148,15 +149,15 @@ void WaveVREyeManager::UpdateEyeData()
 	if ((leftMask & (uint64_t)WVR_EyeTrackingStatus::WVR_PupilDiameterValid) != 0)
 		leftPupilDiameter = eyeData.left.pupilDiameter;
 	if ((leftMask & (uint64_t)WVR_EyeTrackingStatus::WVR_PupilPositionInSensorAreaValid) != 0)
-		leftPupilPosition = CoordinateUtil::GetVector2(eyeData.left.pupilPositionInSensorArea, GetWorldToMetersScale());
+		leftPupilPosition = CoordinateUtil::GetVector2(eyeData.left.pupilPositionInSensorArea, worldToMeters);
 
 	/* Right Eye */
 	rightMask = eyeData.right.eyeTrackingValidBitMask;
 	if ((rightMask & (uint64_t)WVR_EyeTrackingStatus::WVR_GazeOriginValid) != 0)
-		rightOrigin = CoordinateUtil::GetVector3(eyeData.right.gazeOrigin, GetWorldToMetersScale());
+		rightOrigin = CoordinateUtil::GetVector3(eyeData.right.gazeOrigin, worldToMeters);
 	if ((rightMask & (uint64_t)WVR_EyeTrackingStatus::WVR_GazeDirectionNormalizedValid) != 0)
 	{
-		rightDirection = CoordinateUtil::GetVector3(eyeData.right.gazeDirectionNormalized, GetWorldToMetersScale());
+		rightDirection = CoordinateUtil::GetVector3(eyeData.right.gazeDirectionNormalized, worldToMeters);
 		if (NormalizeX) { CoordinateUtil::Vector3NormalizeX(rightDirection); }
 	}
 	if ((rightMask & (uint64_t)WVR_EyeTrackingStatus::WVR_EyeOpennessValid) != 0)
@@ -164,7 +165,7 @@ void WaveVREyeManager::UpdateEyeData()
 	if ((rightMask & (uint64_t)WVR_EyeTrackingStatus::WVR_PupilDiameterValid) != 0)
 		rightPupilDiameter = eyeData.right.pupilDiameter;
 	if ((rightMask & (uint64_t)WVR_EyeTrackingStatus::WVR_PupilPositionInSensorAreaValid) != 0)
-		rightPupilPosition = CoordinateUtil::GetVector2(eyeData.right.pupilPositionInSensorArea, GetWorldToMetersScale());
+		rightPupilPosition = CoordinateUtil::GetVector2(eyeData.right.pupilPositionInSensorArea, worldToMeters);
 }
 
 void WaveVREyeManager::SetEyeSpace(EWVR_CoordinateSystem space)
@@ -294,17 +295,3 @@ bool WaveVREyeManager::GetRightEyePupilPositionInSensorArea(FVector2D& position)
 	}
 	return false;
 }
-
-#pragma region
-float WaveVREyeManager::GetWorldToMetersScale()
-{
-	if (IsInGameThread() && GWorld != nullptr)
-	{
-		// For example, One world unit need multiply 100 to become 1 meter.
-		float wtm = GWorld->GetWorldSettings()->WorldToMeters;
-		//LOGI(LogWaveVREyeManager, "GWorld->GetWorldSettings()->WorldToMeters = %f", wtm);
-		return wtm;
-	}
-	return 100.0f;
-}
-#pragma endregion Major Standalone Function
@@ -9,7 +9,7 @@
 // specifications, and documentation provided by HTC to You."
 
 #include "EyeExpression/FWaveVREyeExpThread.h"
-#include "HAL/RunnableThread.h"
+#include "FWaveVRServiceThread.h"
 
 #include "Platforms/WaveVRAPIWrapper.h"
 #include "Platforms/WaveVRLogWrapper.h"
@@ -23,121 +23,87 @@ FWaveVREyeExpThread* FWaveVREyeExpThread::Runnable = NULL;
 //***********************************************************
 
 FWaveVREyeExpThread::FWaveVREyeExpThread()
-	: shutDownThread(false)
-	, getSupportedFeature(false)
-	, eyeExpStatus(EWaveVREyeExpStatus::NOT_START)
+	: eyeExpStatus(EWaveVREyeExpStatus::NOT_START)
 {
-	Thread = FRunnableThread::Create(this, TEXT("FWaveVREyeExpThread"));
+	FWaveVRServiceThread::Get()->Enqueue([this]() { CheckSupportedFeature(); });
 }
 
 FWaveVREyeExpThread::~FWaveVREyeExpThread()
 {
-	delete Thread;
-	Thread = NULL;
 }
 
-//Init
-bool FWaveVREyeExpThread::Init()
+void FWaveVREyeExpThread::CheckSupportedFeature()
 {
-	LOGD(LogFWaveVREyeExpThread, "Init()");
-	return true;
+	uint64_t supportedFeatures = FWaveVRAPIWrapper::GetInstance()->GetSupportedFeatures();
+	if ((supportedFeatures & (uint64_t)WVR_SupportedFeature::WVR_SupportedFeature_EyeExp) == 0)
+	{
+		eyeExpStatus = EWaveVREyeExpStatus::NO_SUPPORT;
+	}
+	else
+	{
+		eyeExpStatus = EWaveVREyeExpStatus::NOT_START;
+	}
+
+	LOGD(LogFWaveVREyeExpThread, "CheckSupportedFeature() supportedFeatures %d, eyeExpStatus %d", (int)supportedFeatures, (int)eyeExpStatus);
 }
 
-//Run
-uint32 FWaveVREyeExpThread::Run()
+void FWaveVREyeExpThread::RunAction(Actions action)
 {
-	//Initial wait before starting
-	FPlatformProcess::Sleep(0.03);
-
-	while (!shutDownThread)
+	m_mutex.Lock();
+	switch (action)
 	{
-		if (!getSupportedFeature)
+	case Actions::Activate:
+		if (eyeExpStatus == EWaveVREyeExpStatus::NOT_START || eyeExpStatus == EWaveVREyeExpStatus::START_FAILURE)
 		{
-			uint64_t supportedFeatures = FWaveVRAPIWrapper::GetInstance()->GetSupportedFeatures();
-			if ((supportedFeatures & (uint64_t)WVR_SupportedFeature::WVR_SupportedFeature_EyeExp) == 0)
-			{
-				eyeExpStatus = EWaveVREyeExpStatus::NO_SUPPORT;
-			}
-			else
-			{
-				eyeExpStatus = EWaveVREyeExpStatus::NOT_START;
-			}
-			getSupportedFeature = true;
-
-			LOGD(LogFWaveVREyeExpThread, "Run() supportedFeatures %d, eyeExpStatus %d", (int)supportedFeatures, (int)eyeExpStatus);
-		}
+			eyeExpStatus = EWaveVREyeExpStatus::STARTING;
 
-		bool has_action = qActions.Dequeue(action);
-		if (has_action)
-		{
-			m_mutex.Lock();
-			switch (action)
+			LOGD(LogFWaveVREyeExpThread, "RunAction() Start EyeExp.");
+			WVR_Result result = FWaveVRAPIWrapper::GetInstance()->StartEyeExp();
+			switch (result)
 			{
-			case Actions::Activate:
-				if (eyeExpStatus == EWaveVREyeExpStatus::NOT_START || eyeExpStatus == EWaveVREyeExpStatus::START_FAILURE)
-				{
-					eyeExpStatus = EWaveVREyeExpStatus::STARTING;
-
-					LOGD(LogFWaveVREyeExpThread, "Run() Start EyeExp.");
-					WVR_Result result = FWaveVRAPIWrapper::GetInstance()->StartEyeExp();
-					switch (result)
-					{
-					case WVR_Result::WVR_Success:
-						eyeExpStatus = EWaveVREyeExpStatus::AVAILABLE;
-						break;
-					case WVR_Result::WVR_Error_FeatureNotSupport:
-						eyeExpStatus = EWaveVREyeExpStatus::NO_SUPPORT;
-						break;
-					default:
-						eyeExpStatus = EWaveVREyeExpStatus::START_FAILURE;
-						break;
-					}
-					LOGD(LogFWaveVREyeExpThread, "Run() Start EyeExp result: %d", (uint8)result);
-				}
+			case WVR_Result::WVR_Success:
+				eyeExpStatus = EWaveVREyeExpStatus::AVAILABLE;
 				break;
-			case Actions::Deactivate:
-				if (eyeExpStatus == EWaveVREyeExpStatus::AVAILABLE)
-				{
-					eyeExpStatus = EWaveVREyeExpStatus::STOPING;
-					LOGD(LogFWaveVREyeExpThread, "Run() Stop EyeExp.");
-					FWaveVRAPIWrapper::GetInstance()->StopEyeExp();
-					eyeExpStatus = EWaveVREyeExpStatus::NOT_START;
-				}
+			case WVR_Result::WVR_Error_FeatureNotSupport:
+				eyeExpStatus = EWaveVREyeExpStatus::NO_SUPPORT;
 				break;
 			default:
+				eyeExpStatus = EWaveVREyeExpStatus::START_FAILURE;
 				break;
 			}
-			m_mutex.Unlock();
+			LOGD(LogFWaveVREyeExpThread, "RunAction() Start EyeExp result: %d", (uint8)result);
 		}
-
-		FPlatformProcess::Sleep(0.1);
+		break;
+	case Actions::Deactivate:
+		if (eyeExpStatus == EWaveVREyeExpStatus::AVAILABLE)
+		{
+			eyeExpStatus = EWaveVREyeExpStatus::STOPING;
+			LOGD(LogFWaveVREyeExpThread, "RunAction() Stop EyeExp.");
+			FWaveVRAPIWrapper::GetInstance()->StopEyeExp();
+			eyeExpStatus = EWaveVREyeExpStatus::NOT_START;
+		}
+		break;
+	default:
+		break;
 	}
-
-	return 0;
-}
-
-//stop
-void FWaveVREyeExpThread::Stop()
-{
+	m_mutex.Unlock();
 }
 
 FWaveVREyeExpThread* FWaveVREyeExpThread::JoyInit()
 {
-	//Create new instance of thread if it does not exist
+	//Create new instance if it does not exist
 	//		and the platform supports multi threading!
-	if (!Runnable && FPlatformProcess::SupportsMultithreading())
+	if (!Runnable && FWaveVRServiceThread::Get())
 	{
 		Runnable = new FWaveVREyeExpThread();
-		LOGD(LogFWaveVREyeExpThread, "JoyInit() Create new thread.");
+		LOGD(LogFWaveVREyeExpThread, "JoyInit() Create new instance.");
 	}
 	return Runnable;
 }
 
 void FWaveVREyeExpThread::EnsureCompletion()
 {
-	shutDownThread = true;
-	Stop();
-	Thread->WaitForCompletion();
+	FWaveVRServiceThread::Get()->Flush();
 }
 
 void FWaveVREyeExpThread::Shutdown()
@@ -149,3 +115,8 @@ void FWaveVREyeExpThread::Shutdown()
 		Runnable = NULL;
 	}
 }
+
+void FWaveVREyeExpThread::RequestAction(Actions action)
+{
+	FWaveVRServiceThread::Get()->Enqueue([this, action]() { RunAction(action); });
+}
@@ -0,0 +1,104 @@
+// "WaveVR SDK
+// © 2019 HTC Corporation. All Rights Reserved.
+//
+// Unless otherwise required by copyright law and practice,
+// upon the execution of HTC SDK license agreement,
+// HTC grants you access to and use of the WaveVR SDK(s).
+// You shall fully comply with all of HTC’s SDK license agreement terms and
+// conditions signed by you and all SDK and API requirements,
+// specifications, and documentation provided by HTC to You."
+
+#include "FWaveVRServiceThread.h"
+#include "HAL/RunnableThread.h"
+#include "HAL/Event.h"
+
+#include "Platforms/WaveVRLogWrapper.h"
+
+DEFINE_LOG_CATEGORY_STATIC(LogWaveVRServiceThread, Log, All);
+
+FWaveVRServiceThread* FWaveVRServiceThread::Instance = nullptr;
+
+FWaveVRServiceThread::FWaveVRServiceThread()
+	: Thread(nullptr)
+	, WakeEvent(FPlatformProcess::GetSynchEventFromPool(false))
+	, bStopping(false)
+{
+	Thread = FRunnableThread::Create(this, TEXT("FWaveVRServiceThread"));
+}
+
+FWaveVRServiceThread::~FWaveVRServiceThread()
+{
+	delete Thread;
+	Thread = nullptr;
+
+	FPlatformProcess::ReturnSynchEventToPool(WakeEvent);
+	WakeEvent = nullptr;
+}
+
+FWaveVRServiceThread* FWaveVRServiceThread::Get()
+{
+	if (!Instance && FPlatformProcess::SupportsMultithreading())
+	{
+		Instance = new FWaveVRServiceThread();
+		LOGD(LogWaveVRServiceThread, "Get() Create new thread.");
+	}
+	return Instance;
+}
+
+void FWaveVRServiceThread::Shutdown()
+{
+	if (Instance)
+	{
+		Instance->Stop();
+		Instance->Thread->WaitForCompletion();
+		delete Instance;
+		Instance = nullptr;
+	}
+}
+
+void FWaveVRServiceThread::Enqueue(TUniqueFunction<void()>&& Command)
+{
+	Commands.Enqueue(MoveTemp(Command));
+	WakeEvent->Trigger();
+}
+
+void FWaveVRServiceThread::Flush()
+{
+	FEvent* Done = FPlatformProcess::GetSynchEventFromPool(true);
+	Enqueue([Done]() { Done->Trigger(); });
+	Done->Wait();
+	FPlatformProcess::ReturnSynchEventToPool(Done);
+}
+
+bool FWaveVRServiceThread::Init()
+{
+	LOGD(LogWaveVRServiceThread, "Init()");
+	return true;
+}
+
+uint32 FWaveVRServiceThread::Run()
+{
+	TUniqueFunction<void()> Command;
+	while (true)
+	{
+		while (Commands.Dequeue(Command))
+		{
+			Command();
+		}
+
+		if (bStopping)
+			break;
+
+		// The event stays triggered if a command came in after the queue was drained, so nothing is missed.
+		WakeEvent->Wait();
+	}
+
+	LOGD(LogWaveVRServiceThread, "Run() Stopped.");
+	return 0;
+}
+
+void FWaveVRServiceThread::Stop()
+{
+	bStopping = true;
+	WakeEvent->Trigger();
+}
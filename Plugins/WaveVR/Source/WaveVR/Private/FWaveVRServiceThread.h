@@ -0,0 +1,56 @@
+// "WaveVR SDK
+// © 2019 HTC Corporation. All Rights Reserved.
+//
+// Unless otherwise required by copyright law and practice,
+// upon the execution of HTC SDK license agreement,
+// HTC grants you access to and use of the WaveVR SDK(s).
+// You shall fully comply with all of HTC’s SDK license agreement terms and
+// conditions signed by you and all SDK and API requirements,
+// specifications, and documentation provided by HTC to You."
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "HAL/Runnable.h"
+#include "Containers/Queue.h"
+#include "Templates/Atomic.h"
+
+/**
+ * One worker thread for the slow runtime calls of hand, eye, tracker, lip expression and eye expression,
+ * like starting and stopping their trackers.
+ *
+ * The thread sleeps on an event and wakes as soon as a command is enqueued.  Commands run one at a time in
+ * the order they were enqueued, so the runtime never sees two of these calls at once.
+ */
+class FWaveVRServiceThread : public FRunnable
+{
+public:
+	/** Creates the worker on first use.  Returns nullptr if the platform does not support multithreading. */
+	static FWaveVRServiceThread* Get();
+
+	/** Runs the commands already enqueued, then stops and deletes the worker. */
+	static void Shutdown();
+
+	/** Runs Command on the worker.  Any thread. */
+	void Enqueue(TUniqueFunction<void()>&& Command);
+
+	/** Waits until every command enqueued before this call has run.  Do not call from a command. */
+	void Flush();
+
+	// Begin FRunnable interface.
+	virtual bool Init() override;
+	virtual uint32 Run() override;
+	virtual void Stop() override;
+	// End FRunnable interface
+
+private:
+	FWaveVRServiceThread();
+	virtual ~FWaveVRServiceThread();
+
+	static FWaveVRServiceThread* Instance;
+
+	FRunnableThread* Thread;
+	FEvent* WakeEvent;
+	TAtomic<bool> bStopping;
+	TQueue<TUniqueFunction<void()>, EQueueMode::Mpsc> Commands;
+};
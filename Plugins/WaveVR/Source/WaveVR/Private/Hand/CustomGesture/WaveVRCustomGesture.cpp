@@ -19,18 +19,23 @@ AWaveVRCustomGesture::AWaveVRCustomGesture()
 {
  	// Set this actor to call Tick() every frame.  You can turn this off to improve performance if you don't need it.
 	PrimaryActorTick.bCanEverTick = true;
-
-	s_JointPositionsLeft.Init(FVector::ZeroVector, EWaveVRHandJointCount); // count of WVR_HandJoint
-	s_JointPositionsRight.Init(FVector::ZeroVector, EWaveVRHandJointCount); // count of WVR_HandJoint
-	s_JointRotationsLeft.Init(FQuat::Identity, EWaveVRHandJointCount); // count of WVR_HandJoint
-	s_JointRotationsRight.Init(FQuat::Identity, EWaveVRHandJointCount); // count of WVR_HandJoint
 }
 
 // Called when the game starts or when spawned
 void AWaveVRCustomGesture::BeginPlay()
 {
 	Super::BeginPlay();
-	
+
+	CompileGestures();
+}
+
+void AWaveVRCustomGesture::CompileGestures()
+{
+	m_LeftTable.Compile(LeftGestures);
+	m_RightTable.Compile(RightGestures);
+	m_DualTable.Compile(DualHandGestures);
+
+	LOGD(LogWaveVRCustomGesture, "CompileGestures() left %d, right %d, dual %d", m_LeftTable.Num(), m_RightTable.Num(), m_DualTable.Num());
 }
 
 // Called every frame
@@ -38,82 +43,48 @@ void AWaveVRCustomGesture::Tick(float DeltaTime)
 {
 	Super::Tick(DeltaTime);
 
-	validPoseLeft = UWaveVRHandBPLibrary::GetAllHandJointPoses(EWaveVRTrackerType::Natural, EWaveVRHandType::Left, s_JointPositionsLeft, s_JointRotationsLeft);
-	validPoseRight = UWaveVRHandBPLibrary::GetAllHandJointPoses(EWaveVRTrackerType::Natural, EWaveVRHandType::Right, s_JointPositionsRight, s_JointRotationsRight);
+	// Borrows the joints of this frame, the poses are only read when valid.
+	m_JointsLeft = UWaveVRHandBPLibrary::GetHandJointsView(EWaveVRTrackerType::Natural, EWaveVRHandType::Left);
+	m_JointsRight = UWaveVRHandBPLibrary::GetHandJointsView(EWaveVRTrackerType::Natural, EWaveVRHandType::Right);
+	validPoseLeft = m_JointsLeft.bValid;
+	validPoseRight = m_JointsRight.bValid;
 
 	/// Updates all fingers' states.
 	UpdateFingerState();
 
-	/// Checks left gestures.
-	bool matchLeft = false;
-	for (int i = 0; i < LeftGestures.Num(); i++)
-	{
-		if (MatchGestureSingle(LeftGestures[i].Setting, true))
-		{
-			if (!m_LeftHandGesture.Equals(LeftGestures[i].Name))
-			{
-				m_LeftHandGesture = LeftGestures[i].Name;
-				LOGD(LogWaveVRCustomGesture, "Tick() broadcast Left custome gesture %s", PLATFORM_CHAR((*m_LeftHandGesture)));
-				UWaveVRHandGestureComponent::OnCustomGestureNative_Left.Broadcast(m_LeftHandGesture);
-			}
+	const int32 poseLeft = validPoseLeft ?
+		FWaveVRCustomGestureTable::GetHandPose(m_ThumbStateLeft, m_IndexStateLeft, m_MiddleStateLeft, m_RingStateLeft, m_PinkyStateLeft) : INDEX_NONE;
+	const int32 poseRight = validPoseRight ?
+		FWaveVRCustomGestureTable::GetHandPose(m_ThumbStateRight, m_IndexStateRight, m_MiddleStateRight, m_RingStateRight, m_PinkyStateRight) : INDEX_NONE;
 
-			matchLeft = true;
-			break; // Leaves if matched gesture.
-		}
-	}
-	if (!matchLeft && !m_LeftHandGesture.Equals(kUnknownGesture))
+	/// Checks left gestures.
+	const int32 leftId = m_LeftTable.Match(poseLeft, m_JointsLeft.Positions);
+	if (leftId != m_LeftGestureId)
 	{
-		m_LeftHandGesture = kUnknownGesture;
-		LOGD(LogWaveVRCustomGesture, "Tick() broadcast Left custome gesture %s", PLATFORM_CHAR((*m_LeftHandGesture)));
-		UWaveVRHandGestureComponent::OnCustomGestureNative_Left.Broadcast(m_LeftHandGesture);
+		m_LeftGestureId = leftId;
+		const FString& gesture = LeftGestures.IsValidIndex(leftId) ? LeftGestures[leftId].Name : kUnknownGesture;
+		LOGD(LogWaveVRCustomGesture, "Tick() broadcast Left custome gesture %s", PLATFORM_CHAR((*gesture)));
+		UWaveVRHandGestureComponent::OnCustomGestureNative_Left.Broadcast(gesture);
 	}
 
 	/// Checks right gestures.
-	bool matchRight = false;
-	for (int i = 0; i < RightGestures.Num(); i++)
+	const int32 rightId = m_RightTable.Match(poseRight, m_JointsRight.Positions);
+	if (rightId != m_RightGestureId)
 	{
-		if (MatchGestureSingle(RightGestures[i].Setting, false))
-		{
-			if (!m_RightHandGesture.Equals(RightGestures[i].Name))
-			{
-				m_RightHandGesture = RightGestures[i].Name;
-				LOGD(LogWaveVRCustomGesture, "Tick() broadcast Right custome gesture %s", PLATFORM_CHAR((*m_RightHandGesture)));
-				UWaveVRHandGestureComponent::OnCustomGestureNative_Right.Broadcast(m_RightHandGesture);
-			}
-
-			matchRight = true;
-			break; // Leaves if matched gesture.
-		}
+		m_RightGestureId = rightId;
+		const FString& gesture = RightGestures.IsValidIndex(rightId) ? RightGestures[rightId].Name : kUnknownGesture;
+		LOGD(LogWaveVRCustomGesture, "Tick() broadcast Right custome gesture %s", PLATFORM_CHAR((*gesture)));
+		UWaveVRHandGestureComponent::OnCustomGestureNative_Right.Broadcast(gesture);
 	}
-	if (!matchRight && !m_RightHandGesture.Equals(kUnknownGesture))
-	{
-		m_RightHandGesture = kUnknownGesture;
-		LOGD(LogWaveVRCustomGesture, "Tick() broadcast Right custome gesture %s", PLATFORM_CHAR((*m_RightHandGesture)));
-		UWaveVRHandGestureComponent::OnCustomGestureNative_Right.Broadcast(m_RightHandGesture);
-	}
-
-	bool matchDual = false;
-	for (int i = 0; i < DualHandGestures.Num(); i++)
-	{
-		if (MatchGestureDual(DualHandGestures[i].Setting))
-		{
-			if (!m_DualHandGesture.Equals(DualHandGestures[i].Name))
-			{
-				m_DualHandGesture = DualHandGestures[i].Name;
-				LOGD(LogWaveVRCustomGesture, "Tick() broadcast Dual Hand custome gesture %s", PLATFORM_CHAR((*m_DualHandGesture)));
-				UWaveVRHandGestureComponent::OnCustomGestureNative_Dual.Broadcast(m_DualHandGesture);
-			}
 
-			matchDual = true;
-			break; // Leaves if matched gesture.
-		}
-	}
-
-	if (!matchDual && !m_DualHandGesture.Equals(kUnknownGesture))
+	/// Checks dual hand gestures.
+	const int32 dualId = m_DualTable.Match(poseLeft, m_JointsLeft.Positions, poseRight, m_JointsRight.Positions);
+	if (dualId != m_DualGestureId)
 	{
-		m_DualHandGesture = kUnknownGesture;
-		LOGD(LogWaveVRCustomGesture, "Tick() broadcast Dual Hand custome gesture %s", PLATFORM_CHAR((*m_DualHandGesture)));
-		UWaveVRHandGestureComponent::OnCustomGestureNative_Dual.Broadcast(m_DualHandGesture);
+		m_DualGestureId = dualId;
+		const FString& gesture = DualHandGestures.IsValidIndex(dualId) ? DualHandGestures[dualId].Name : kUnknownGesture;
+		LOGD(LogWaveVRCustomGesture, "Tick() broadcast Dual Hand custome gesture %s", PLATFORM_CHAR((*gesture)));
+		UWaveVRHandGestureComponent::OnCustomGestureNative_Dual.Broadcast(gesture);
 	}
 }
 
@@ -122,74 +93,74 @@ void AWaveVRCustomGesture::UpdateFingerState()
 	if (validPoseLeft)
 	{
 		m_ThumbStateLeft = GetThumbState(
-			s_JointPositionsLeft[(uint8)EWaveVRHandJoint::Thumb_Joint1],
-			s_JointPositionsLeft[(uint8)EWaveVRHandJoint::Thumb_Joint2],
-			s_JointPositionsLeft[(uint8)EWaveVRHandJoint::Thumb_Tip],
+			m_JointsLeft.Positions[(uint8)EWaveVRHandJoint::Thumb_Joint1],
+			m_JointsLeft.Positions[(uint8)EWaveVRHandJoint::Thumb_Joint2],
+			m_JointsLeft.Positions[(uint8)EWaveVRHandJoint::Thumb_Tip],
 			true
 		);
 
 		m_IndexStateLeft = GetFingerState(
-			s_JointPositionsLeft[(uint8)EWaveVRHandJoint::Index_Joint1],
-			s_JointPositionsLeft[(uint8)EWaveVRHandJoint::Index_Joint2],
-			s_JointPositionsLeft[(uint8)EWaveVRHandJoint::Index_Tip],
+			m_JointsLeft.Positions[(uint8)EWaveVRHandJoint::Index_Joint1],
+			m_JointsLeft.Positions[(uint8)EWaveVRHandJoint::Index_Joint2],
+			m_JointsLeft.Positions[(uint8)EWaveVRHandJoint::Index_Tip],
 			true
 		);
 
 		m_MiddleStateLeft = GetFingerState(
-			s_JointPositionsLeft[(uint8)EWaveVRHandJoint::Middle_Joint1],
-			s_JointPositionsLeft[(uint8)EWaveVRHandJoint::Middle_Joint2],
-			s_JointPositionsLeft[(uint8)EWaveVRHandJoint::Middle_Tip],
+			m_JointsLeft.Positions[(uint8)EWaveVRHandJoint::Middle_Joint1],
+			m_JointsLeft.Positions[(uint8)EWaveVRHandJoint::Middle_Joint2],
+			m_JointsLeft.Positions[(uint8)EWaveVRHandJoint::Middle_Tip],
 			true
 		);
 
 		m_RingStateLeft = GetFingerState(
-			s_JointPositionsLeft[(uint8)EWaveVRHandJoint::Ring_Joint1],
-			s_JointPositionsLeft[(uint8)EWaveVRHandJoint::Ring_Joint2],
-			s_JointPositionsLeft[(uint8)EWaveVRHandJoint::Ring_Tip],
+			m_JointsLeft.Positions[(uint8)EWaveVRHandJoint::Ring_Joint1],
+			m_JointsLeft.Positions[(uint8)EWaveVRHandJoint::Ring_Joint2],
+			m_JointsLeft.Positions[(uint8)EWaveVRHandJoint::Ring_Tip],
 			true
 		);
 
 		m_PinkyStateLeft = GetFingerState(
-			s_JointPositionsLeft[(uint8)EWaveVRHandJoint::Pinky_Joint1],
-			s_JointPositionsLeft[(uint8)EWaveVRHandJoint::Pinky_Joint2],
-			s_JointPositionsLeft[(uint8)EWaveVRHandJoint::Pinky_Tip],
+			m_JointsLeft.Positions[(uint8)EWaveVRHandJoint::Pinky_Joint1],
+			m_JointsLeft.Positions[(uint8)EWaveVRHandJoint::Pinky_Joint2],
+			m_JointsLeft.Positions[(uint8)EWaveVRHandJoint::Pinky_Tip],
 			true
 		);
 	}
 	if (validPoseRight)
 	{
 		m_ThumbStateRight = GetThumbState(
-			s_JointPositionsRight[(uint8)EWaveVRHandJoint::Thumb_Joint1],
-			s_JointPositionsRight[(uint8)EWaveVRHandJoint::Thumb_Joint2],
-			s_JointPositionsRight[(uint8)EWaveVRHandJoint::Thumb_Tip],
+			m_JointsRight.Positions[(uint8)EWaveVRHandJoint::Thumb_Joint1],
+			m_JointsRight.Positions[(uint8)EWaveVRHandJoint::Thumb_Joint2],
+			m_JointsRight.Positions[(uint8)EWaveVRHandJoint::Thumb_Tip],
 			true
 		);
 
 		m_IndexStateRight = GetFingerState(
-			s_JointPositionsRight[(uint8)EWaveVRHandJoint::Index_Joint1],
-			s_JointPositionsRight[(uint8)EWaveVRHandJoint::Index_Joint2],
-			s_JointPositionsRight[(uint8)EWaveVRHandJoint::Index_Tip],
+			m_JointsRight.Positions[(uint8)EWaveVRHandJoint::Index_Joint1],
+			m_JointsRight.Positions[(uint8)EWaveVRHandJoint::Index_Joint2],
+			m_JointsRight.Positions[(uint8)EWaveVRHandJoint::Index_Tip],
 			true
 		);
 
 		m_MiddleStateRight = GetFingerState(
-			s_JointPositionsRight[(uint8)EWaveVRHandJoint::Middle_Joint1],
-			s_JointPositionsRight[(uint8)EWaveVRHandJoint::Middle_Joint2],
-			s_JointPositionsRight[(uint8)EWaveVRHandJoint::Middle_Tip],
+			m_JointsRight.Positions[(uint8)EWaveVRHandJoint::Middle_Joint1],
+			m_JointsRight.Positions[(uint8)EWaveVRHandJoint::Middle_Joint2],
+			m_JointsRight.Positions[(uint8)EWaveVRHandJoint::Middle_Tip],
 			true
 		);
 
 		m_RingStateRight = GetFingerState(
-			s_JointPositionsRight[(uint8)EWaveVRHandJoint::Ring_Joint1],
-			s_JointPositionsRight[(uint8)EWaveVRHandJoint::Ring_Joint2],
-			s_JointPositionsRight[(uint8)EWaveVRHandJoint::Ring_Tip],
+			m_JointsRight.Positions[(uint8)EWaveVRHandJoint::Ring_Joint1],
+			m_JointsRight.Positions[(uint8)EWaveVRHandJoint::Ring_Joint2],
+			m_JointsRight.Positions[(uint8)EWaveVRHandJoint::Ring_Tip],
 			true
 		);
 
 		m_PinkyStateRight = GetFingerState(
-			s_JointPositionsRight[(uint8)EWaveVRHandJoint::Pinky_Joint1],
-			s_JointPositionsRight[(uint8)EWaveVRHandJoint::Pinky_Joint2],
-			s_JointPositionsRight[(uint8)EWaveVRHandJoint::Pinky_Tip],
+			m_JointsRight.Positions[(uint8)EWaveVRHandJoint::Pinky_Joint1],
+			m_JointsRight.Positions[(uint8)EWaveVRHandJoint::Pinky_Joint2],
+			m_JointsRight.Positions[(uint8)EWaveVRHandJoint::Pinky_Tip],
 			true
 		);
 	}
@@ -212,74 +183,3 @@ bool AWaveVRCustomGesture::MatchThumbState(FThumbState state)
 {
 	return false;
 }
-
-bool AWaveVRCustomGesture::MatchDistanceSingle(EWaveVRHandJoint node1, EWaveVRHandJoint node2, EWaveVRJointDistance distance, bool isLeft)
-{
-	if (isLeft && !validPoseLeft) { return false; }
-	if (!isLeft && !validPoseRight) { return false; }
-
-	float node_dist = isLeft ?
-		FVector::Distance(s_JointPositionsLeft[(uint8)node1], s_JointPositionsLeft[(uint8)node2]) :
-		FVector::Distance(s_JointPositionsRight[(uint8)node1], s_JointPositionsRight[(uint8)node2]);
-
-	if (distance == EWaveVRJointDistance::Near) { return (node_dist < 2.5f); }
-	return (node_dist > 5);
-}
-bool AWaveVRCustomGesture::MatchDistanceDual(EWaveVRHandJoint leftNode, EWaveVRHandJoint rightNode, EWaveVRJointDistance distance)
-{
-	if (!validPoseLeft || !validPoseRight) { return false; }
-
-	float node_dist = FVector::Distance(s_JointPositionsLeft[(uint8)leftNode], s_JointPositionsRight[(uint8)rightNode]);
-
-	if (distance == EWaveVRJointDistance::Near) { return (node_dist < 10); }
-	return (node_dist > 20);
-}
-
-bool AWaveVRCustomGesture::MatchGestureSingle(FSingleHandSetting setting, bool isLeft)
-{
-	if (isLeft)
-	{
-		if (!validPoseLeft) { return false; }
-
-		if (!WaveVRHandHelper::MatchThumbState(setting.Thumb, m_ThumbStateLeft)) { return false; }
-		if (!WaveVRHandHelper::MatchFingerState(setting.Index, m_IndexStateLeft)) { return false; }
-		if (!WaveVRHandHelper::MatchFingerState(setting.Middle, m_MiddleStateLeft)) { return false; }
-		if (!WaveVRHandHelper::MatchFingerState(setting.Ring, m_RingStateLeft)) { return false; }
-		if (!WaveVRHandHelper::MatchFingerState(setting.Pinky, m_PinkyStateLeft)) { return false; }
-	}
-	else
-	{
-		if (!validPoseRight) { return false; }
-
-		if (!WaveVRHandHelper::MatchThumbState(setting.Thumb, m_ThumbStateRight)) { return false; }
-		if (!WaveVRHandHelper::MatchFingerState(setting.Index, m_IndexStateRight)) { return false; }
-		if (!WaveVRHandHelper::MatchFingerState(setting.Middle, m_MiddleStateRight)) { return false; }
-		if (!WaveVRHandHelper::MatchFingerState(setting.Ring, m_RingStateRight)) { return false; }
-		if (!WaveVRHandHelper::MatchFingerState(setting.Pinky, m_PinkyStateRight)) { return false; }
-	}
-
-	/// Checks all distance conditions.
-	for (int i = 0; i < setting.SingleHandNodeDistances.Num(); i++)
-	{
-		if (!MatchDistanceSingle(setting.SingleHandNodeDistances[i].Node1, setting.SingleHandNodeDistances[i].Node2, setting.SingleHandNodeDistances[i].Distance, isLeft))
-			return false;
-	}
-
-	return true;
-}
-bool AWaveVRCustomGesture::MatchGestureDual(FDualHandSetting setting)
-{
-	if (!validPoseLeft || !validPoseRight) { return false; }
-
-	if (!MatchGestureSingle(setting.LeftHand, true)) { return false; }
-	if (!MatchGestureSingle(setting.RightHand, false)) { return false; }
-
-	/// Checks all distance conditions.
-	for (int i = 0; i < setting.DualHandNodeDistances.Num(); i++)
-	{
-		if (!MatchDistanceDual(setting.DualHandNodeDistances[i].LeftNode, setting.DualHandNodeDistances[i].RightNode, setting.DualHandNodeDistances[i].Distance))
-			return false;
-	}
-
-	return true;
-}
@@ -0,0 +1,201 @@
+// "WaveVR SDK
+// © 2019 HTC Corporation. All Rights Reserved.
+//
+// Unless otherwise required by copyright law and practice,
+// upon the execution of HTC SDK license agreement,
+// HTC grants you access to and use of the WaveVR SDK(s).
+// You shall fully comply with all of HTC’s SDK license agreement terms and
+// conditions signed by you and all SDK and API requirements,
+// specifications, and documentation provided by HTC to You."
+
+#include "Hand/CustomGesture/WaveVRCustomGestureTable.h"
+
+// Joint distances in centimeters.
+static const float kSingleNear = 2.5f, kSingleFar = 5;
+static const float kDualNear = 10, kDualFar = 20;
+
+static const EWaveVRThumbState kThumbStates[] = { EWaveVRThumbState::Close, EWaveVRThumbState::Open };
+static const EWaveVRFingerState kFingerStates[] = { EWaveVRFingerState::Close, EWaveVRFingerState::Relax, EWaveVRFingerState::Open };
+
+static int32 GetThumbIndex(EWaveVRThumbState state)
+{
+	if (state == EWaveVRThumbState::Close) { return 0; }
+	if (state == EWaveVRThumbState::Open) { return 1; }
+	return INDEX_NONE;
+}
+
+static int32 GetFingerIndex(EWaveVRFingerState state)
+{
+	if (state == EWaveVRFingerState::Close) { return 0; }
+	if (state == EWaveVRFingerState::Relax) { return 1; }
+	if (state == EWaveVRFingerState::Open) { return 2; }
+	return INDEX_NONE;
+}
+
+int32 FWaveVRCustomGestureTable::GetHandPose(EWaveVRThumbState thumb, EWaveVRFingerState index, EWaveVRFingerState middle, EWaveVRFingerState ring, EWaveVRFingerState pinky)
+{
+	const int32 states[] = { GetThumbIndex(thumb), GetFingerIndex(index), GetFingerIndex(middle), GetFingerIndex(ring), GetFingerIndex(pinky) };
+
+	int32 pose = 0;
+	for (int32 i = UE_ARRAY_COUNT(states) - 1; i >= 0; i--)
+	{
+		if (states[i] == INDEX_NONE) { return INDEX_NONE; }
+		pose = pose * (i == 0 ? 2 : 3) + states[i];
+	}
+	return pose;
+}
+
+uint64 FWaveVRCustomGestureTable::GetAcceptWord(const FSingleHandSetting& setting)
+{
+	return setting.Thumb.State()
+		| (setting.Index.State() << 8)
+		| (setting.Middle.State() << 16)
+		| (setting.Ring.State() << 24)
+		| (setting.Pinky.State() << 32);
+}
+
+uint64 FWaveVRCustomGestureTable::GetPoseWord(int32 pose)
+{
+	// Same bits FThumbState::State() and FFingerState::State() use.
+	uint64 word = uint64(1) << (uint8)kThumbStates[pose % 2];
+	pose /= 2;
+	for (int32 finger = 1; finger < 5; finger++)
+	{
+		word |= (uint64(1) << (uint8)kFingerStates[pose % 3]) << (8 * finger);
+		pose /= 3;
+	}
+	return word;
+}
+
+FWaveVRCustomGestureTable::FRange FWaveVRCustomGestureTable::AddDistances(const TArray< FSingleHandNodeDistance >& distances)
+{
+	FRange range;
+	range.Start = DistanceTests.Num();
+	range.Num = distances.Num();
+
+	for (const FSingleHandNodeDistance& distance : distances)
+	{
+		FDistanceTest& test = DistanceTests.AddDefaulted_GetRef();
+		test.Node1 = (uint8)distance.Node1;
+		test.Node2 = (uint8)distance.Node2;
+		test.MinSquared = distance.Distance == EWaveVRJointDistance::Near ? -1 : FMath::Square(kSingleFar);
+		test.MaxSquared = distance.Distance == EWaveVRJointDistance::Near ? FMath::Square(kSingleNear) : MAX_flt;
+	}
+	return range;
+}
+
+FWaveVRCustomGestureTable::FRange FWaveVRCustomGestureTable::AddDistances(const TArray< FDualHandNodeDistance >& distances)
+{
+	FRange range;
+	range.Start = DistanceTests.Num();
+	range.Num = distances.Num();
+
+	for (const FDualHandNodeDistance& distance : distances)
+	{
+		FDistanceTest& test = DistanceTests.AddDefaulted_GetRef();
+		test.Node1 = (uint8)distance.LeftNode;
+		test.Node2 = (uint8)distance.RightNode;
+		test.MinSquared = distance.Distance == EWaveVRJointDistance::Near ? -1 : FMath::Square(kDualFar);
+		test.MaxSquared = distance.Distance == EWaveVRJointDistance::Near ? FMath::Square(kDualNear) : MAX_flt;
+	}
+	return range;
+}
+
+void FWaveVRCustomGestureTable::AddCandidates(const TArray< uint64 >& accepts)
+{
+	CandidateStart.Reset(kHandPoseCount + 1);
+	Candidates.Reset();
+
+	for (int32 pose = 0; pose < kHandPoseCount; pose++)
+	{
+		CandidateStart.Add(Candidates.Num());
+
+		const uint64 word = GetPoseWord(pose);
+		for (int32 id = 0; id < accepts.Num(); id++)
+		{
+			if ((word & accepts[id]) == word)
+				Candidates.Add(id);
+		}
+	}
+	CandidateStart.Add(Candidates.Num());
+}
+
+void FWaveVRCustomGestureTable::Compile(const TArray< FSingleHandGesture >& gestures)
+{
+	Gestures.Reset(gestures.Num());
+	DistanceTests.Reset();
+
+	TArray< uint64 > accepts;
+	accepts.Reserve(gestures.Num());
+	for (const FSingleHandGesture& gesture : gestures)
+	{
+		FGesture& compiled = Gestures.AddDefaulted_GetRef();
+		compiled.Distances = AddDistances(gesture.Setting.SingleHandNodeDistances);
+		accepts.Add(GetAcceptWord(gesture.Setting));
+	}
+
+	AddCandidates(accepts);
+}
+
+void FWaveVRCustomGestureTable::Compile(const TArray< FDualHandGesture >& gestures)
+{
+	Gestures.Reset(gestures.Num());
+	DistanceTests.Reset();
+
+	TArray< uint64 > accepts;
+	accepts.Reserve(gestures.Num());
+	for (const FDualHandGesture& gesture : gestures)
+	{
+		FGesture& compiled = Gestures.AddDefaulted_GetRef();
+		compiled.Distances = AddDistances(gesture.Setting.LeftHand.SingleHandNodeDistances);
+		compiled.RightAccept = GetAcceptWord(gesture.Setting.RightHand);
+		compiled.RightDistances = AddDistances(gesture.Setting.RightHand.SingleHandNodeDistances);
+		compiled.DualDistances = AddDistances(gesture.Setting.DualHandNodeDistances);
+		accepts.Add(GetAcceptWord(gesture.Setting.LeftHand));
+	}
+
+	AddCandidates(accepts);
+}
+
+bool FWaveVRCustomGestureTable::MatchDistances(const FRange& range, const FVector* joints1, const FVector* joints2) const
+{
+	for (int32 i = range.Start; i < range.Start + range.Num; i++)
+	{
+		const FDistanceTest& test = DistanceTests[i];
+		const float distSquared = FVector::DistSquared(joints1[test.Node1], joints2[test.Node2]);
+		if (distSquared <= test.MinSquared || distSquared >= test.MaxSquared)
+			return false;
+	}
+	return true;
+}
+
+int32 FWaveVRCustomGestureTable::Match(int32 pose, const FVector* joints) const
+{
+	if (pose == INDEX_NONE || CandidateStart.Num() != kHandPoseCount + 1) { return INDEX_NONE; }
+
+	for (int32 i = CandidateStart[pose]; i < CandidateStart[pose + 1]; i++)
+	{
+		const int32 id = Candidates[i];
+		if (MatchDistances(Gestures[id].Distances, joints, joints))
+			return id;
+	}
+	return INDEX_NONE;
+}
+
+int32 FWaveVRCustomGestureTable::Match(int32 leftPose, const FVector* leftJoints, int32 rightPose, const FVector* rightJoints) const
+{
+	if (leftPose == INDEX_NONE || rightPose == INDEX_NONE || CandidateStart.Num() != kHandPoseCount + 1) { return INDEX_NONE; }
+
+	const uint64 rightWord = GetPoseWord(rightPose);
+	for (int32 i = CandidateStart[leftPose]; i < CandidateStart[leftPose + 1]; i++)
+	{
+		const int32 id = Candidates[i];
+		const FGesture& gesture = Gestures[id];
+		if ((rightWord & gesture.RightAccept) == rightWord &&
+			MatchDistances(gesture.Distances, leftJoints, leftJoints) &&
+			MatchDistances(gesture.RightDistances, rightJoints, rightJoints) &&
+			MatchDistances(gesture.DualDistances, leftJoints, rightJoints))
+			return id;
+	}
+	return INDEX_NONE;
+}
@@ -128,6 +128,14 @@ bool UWaveVRHandBPLibrary::GetAllHandJointPoses(EWaveVRTrackerType tracker, EWav
 
 	return pHandPose->GetAllHandJointPoses(tracker, hand, OutPositions, OutRotations);
 }
+FWaveVRHandJointsView UWaveVRHandBPLibrary::GetHandJointsView(EWaveVRTrackerType tracker, EWaveVRHandType hand)
+{
+	WaveVRHandPose* pHandPose = WaveVRHandPose::GetInstance();
+	if (pHandPose == nullptr)
+		return FWaveVRHandJointsView();
+
+	return pHandPose->GetHandJointsView(tracker, hand);
+}
 float UWaveVRHandBPLibrary::GetHandConfidence(EWaveVRTrackerType tracker, EWaveVRHandType hand)
 {
 	WaveVRHandPose* pHandPose = WaveVRHandPose::GetInstance();
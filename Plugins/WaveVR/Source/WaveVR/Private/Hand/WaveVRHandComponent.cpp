@@ -12,6 +12,7 @@
 #include "Hand/WaveVRHandBPLibrary.h"
 #include "WaveVRHMD.h"
 
+#include "Engine/SkeletalMesh.h"
 #include "Kismet/GameplayStatics.h"
 
 DEFINE_LOG_CATEGORY(LogWaveVRHandComp);
@@ -47,13 +48,62 @@ void UWaveVRHandComponent::BeginPlay()
 /// Must be called after the SkeletalMesh of UPoseableMeshComponent is updated.
 void UWaveVRHandComponent::UpdateBoneIndex()
 {
+	jointOfBone.Init(INDEX_NONE, BoneSpaceTransforms.Num());
 	for (int i = 0; i < kJointCount; i++) {
+		jointIndex[i] = GetBoneIndex(jointName[i]);
+		if (jointOfBone.IsValidIndex(jointIndex[i]))
+			jointOfBone[jointIndex[i]] = i;
+
 		LOGD(LogWaveVRHandComp, "isLeft(%d), UpdateBoneIndex() BoneName: %s, Index: %d"
-			, (uint8)isLeft, PLATFORM_CHAR((*jointName[i].ToString())), GetBoneIndex(jointName[i])
+			, (uint8)isLeft, PLATFORM_CHAR((*jointName[i].ToString())), jointIndex[i]
 		);
 	}
 }
 
+/// SetBoneLocationByName and SetBoneRotationByName rebuild the component space pose of the whole mesh on each call.
+/// This builds it once, converts every joint to bone space in the same pass and marks the mesh for one refresh.
+void UWaveVRHandComponent::SetJointPoses(const FVector (&locations)[kJointCount], const FQuat (&rotations)[kJointCount])
+{
+	if (!SkeletalMesh || MasterPoseComponent.IsValid())
+		return;
+
+	// BoneSpaceTransforms is allocated from the reference skeleton, so bone indices are shared with it.
+	const FReferenceSkeleton& refSkeleton = SkeletalMesh->RefSkeleton;
+	const int32 boneCount = BoneSpaceTransforms.Num();
+	if (boneCount != refSkeleton.GetNum()) {
+		// Not set up from this mesh yet, fall back to setting the joints one by one.
+		if (!boneCountMismatchLogged) {
+			boneCountMismatchLogged = true;
+			LOGW(LogWaveVRHandComp, "isLeft(%d), SetJointPoses() %d bone transforms for %d reference bones, setting joints by name",
+				(uint8)isLeft, boneCount, refSkeleton.GetNum());
+		}
+		for (int i = 0; i < kJointCount; i++) {
+			SetBoneLocationByName(jointName[i], locations[i], EBoneSpaces::ComponentSpace);
+			SetBoneRotationByName(jointName[i], rotations[i].Rotator(), EBoneSpaces::ComponentSpace);
+		}
+		return;
+	}
+	if (jointOfBone.Num() != boneCount)
+		UpdateBoneIndex();
+
+	// Parents come before their children in the reference skeleton.
+	componentSpaceTransforms.SetNumUninitialized(boneCount, false);
+	for (int32 bone = 0; bone < boneCount; bone++) {
+		const int32 parent = refSkeleton.GetParentIndex(bone);
+		FTransform transform = (parent >= 0) ? BoneSpaceTransforms[bone] * componentSpaceTransforms[parent] : BoneSpaceTransforms[bone];
+
+		const int32 joint = jointOfBone[bone];
+		if (joint != INDEX_NONE) {
+			transform.SetLocation(locations[joint]);
+			transform.SetRotation(rotations[joint]);
+			BoneSpaceTransforms[bone] = (parent >= 0) ? transform.GetRelativeTransform(componentSpaceTransforms[parent]) : transform;
+		}
+		componentSpaceTransforms[bone] = transform;
+	}
+
+	MarkRefreshTransformDirty();
+}
+
 void UWaveVRHandComponent::SetPlayerIndex(int32 index)
 {
 	LOGD(LogWaveVRHandComp, "isLeft(%d), SetPlayerIndex() %d", (uint8)isLeft, index);
@@ -109,11 +159,12 @@ void UWaveVRHandComponent::TickComponent(float DeltaTime, enum ELevelTick TickTy
 
 	if (isShowHand) {
 		SetHiddenInGame(false);
-		FVector wristPos = FVector::ZeroVector;
-		FRotator wristRot = FRotator::ZeroRotator;
-		bool ret;
-		ret = UWaveVRHandBPLibrary::GetHandJointPose(handTrackerType, handType, (EWaveVRHandJoint)1, wristPos, wristRot);
-		if (ret) {
+		// Borrows the joints of this frame instead of fetching them one by one.
+		const FWaveVRHandJointsView joints = UWaveVRHandBPLibrary::GetHandJointsView(handTrackerType, handType);
+		if (joints.bValid) {
+			FVector wristPos = joints.GetPosition(EWaveVRHandJoint::Wrist);
+			FRotator wristRot = joints.GetRotation(EWaveVRHandJoint::Wrist).Rotator();
+
 			FVector VRCameraRootLocation = TrackingToWorld.GetLocation();
 			SetWorldLocation(VRCameraRootLocation + TrackingToWorld.GetRotation() * wristPos);
 			if (printable) {
@@ -124,35 +175,19 @@ void UWaveVRHandComponent::TickComponent(float DeltaTime, enum ELevelTick TickTy
 				LOGD(LogWaveVRHandComp, "isLeft(%d), TickComponent() wrist Location %f, %f, %f", (uint8)isLeft, wristPos.X, wristPos.Y, wristPos.Z);
 				LOGD(LogWaveVRHandComp, "isLeft(%d), TickComponent()       Rotation %f, %f, %f", (uint8)isLeft, wristRot.Roll, wristRot.Pitch, wristRot.Yaw);
 			}
-		}
 
-		wristPos.X /= scale.X;
-		wristPos.Y /= scale.Y;
-		wristPos.Z /= scale.Z;
-		for (int i = 0; i < kJointCount; i++) {
-			FVector jointPos = FVector(0, 0, 0);
-			FRotator jointRot = FRotator(0, 0, 0);
-			if (i == 1) {
-				jointPos = wristPos;
-				jointRot = wristRot;
-				ret = true;
-			} else { 
-				ret = UWaveVRHandBPLibrary::GetHandJointPose(handTrackerType, handType, (EWaveVRHandJoint)i, jointPos, jointRot);
-				jointPos.X /= scale.X;
-				jointPos.Y /= scale.Y;
-				jointPos.Z /= scale.Z;
+			wristPos /= scale;
+			FVector locations[kJointCount];
+			FQuat rotations[kJointCount];
+			for (int i = 0; i < kJointCount; i++) {
+				locations[i] = (i == 1) ? FVector::ZeroVector : joints.GetPosition((EWaveVRHandJoint)i) / scale - wristPos;
+				rotations[i] = joints.GetRotation((EWaveVRHandJoint)i);
 			}
-
-			if (ret) {
-				SetBoneLocationByName(jointName[i], jointPos - wristPos, EBoneSpaces::ComponentSpace);
-				SetBoneRotationByName(jointName[i], jointRot, EBoneSpaces::ComponentSpace);
-			}
-			else {
-				if (i == 1) {
-					if (printable) {
-						LOGD(LogWaveVRHandComp, "isLeft(%d), TickComponent() GetHandJointPose ret = false", (uint8)isLeft);
-					}
-				}
+			SetJointPoses(locations, rotations);
+		}
+		else {
+			if (printable) {
+				LOGD(LogWaveVRHandComp, "isLeft(%d), TickComponent() GetHandJointsView bValid = false", (uint8)isLeft);
 			}
 		}
 	}
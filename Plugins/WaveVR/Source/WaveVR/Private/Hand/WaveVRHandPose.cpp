@@ -22,10 +22,25 @@
 #include "Platforms/WaveVRAPIWrapper.h"
 #include "Platforms/WaveVRLogWrapper.h"
 #include "WaveVRUtils.h"
+#include "WaveVRDeviceSnapshot.h"
 using namespace wvr::utils;
 
 DEFINE_LOG_CATEGORY_STATIC(LogWaveVRHandPose, Log, All);
 
+static void UpdateJointSupportedFlags(const WVR_HandTrackerInfo_t& info, TArray<bool>& OutSupported)
+{
+	const uint64_t poseValid = (uint64_t)WVR_HandJointValidFlag::WVR_HandJointValidFlag_PositionValid
+		| (uint64_t)WVR_HandJointValidFlag::WVR_HandJointValidFlag_RotationValid;
+
+	for (bool& supported : OutSupported) { supported = false; }
+	for (uint32_t i = 0; i < info.jointCount; i++)
+	{
+		const int32 joint = (uint8)info.jointMappingArray[i];
+		if (OutSupported.IsValidIndex(joint))
+			OutSupported[joint] = ((info.jointValidFlagArray[i] & poseValid) == poseValid);
+	}
+}
+
 WaveVRHandPose * WaveVRHandPose::Instance = nullptr;
 WVR_HandGestureData handGestureData;
 WVR_HandTrackerInfo_t m_NaturalTrackerInfo;
@@ -76,6 +91,8 @@ void WaveVRHandPose::InitHandData()
 	s_NaturalJointRotationLeft.Init(FQuat::Identity, EWaveVRHandJointCount); // count of WVR_HandJoint
 	s_NaturalJointPositionRight.Init(FVector::ZeroVector, EWaveVRHandJointCount); // count of WVR_HandJoint
 	s_NaturalJointRotationRight.Init(FQuat::Identity, EWaveVRHandJointCount); // count of WVR_HandJoint
+	s_NaturalJointSupported.Init(false, EWaveVRHandJointCount); // count of WVR_HandJoint
+	m_NaturalJointFrame = 0;
 
 	m_ElectronicTrackerInfo.jointMappingArray = nullptr;
 	m_ElectronicTrackerInfo.jointValidFlagArray = nullptr;
@@ -87,6 +104,8 @@ void WaveVRHandPose::InitHandData()
 	s_ElectronicJointRotationLeft.Init(FQuat::Identity, 26); // count of WVR_HandJoint
 	s_ElectronicJointPositionRight.Init(FVector::ZeroVector, 26); // count of WVR_HandJoint
 	s_ElectronicJointRotationRight.Init(FQuat::Identity, 26); // count of WVR_HandJoint
+	s_ElectronicJointSupported.Init(false, 26); // count of WVR_HandJoint
+	m_ElectronicJointFrame = 0;
 
 	m_HandThread = FWaveVRHandThread::JoyInit();
 	BONE_OFFSET_L = FVector(0, 0, 0);
@@ -152,7 +171,7 @@ void WaveVRHandPose::UpdateRightHandGestureData()
 		UWaveVRHandGestureComponent::OnStaticGestureNative_Right.Broadcast(currStaticGestureRight);
 	}
 }
-void WaveVRHandPose::TickHandData()
+void WaveVRHandPose::TickHandData(const FWaveVRDeviceSnapshot& snapshot)
 {
 	logCount++;
 	logCount %= 500;
@@ -275,6 +294,8 @@ void WaveVRHandPose::TickHandData()
 
 					if (hasNaturalTrackerInfo)
 					{
+						UpdateJointSupportedFlags(m_NaturalTrackerInfo, s_NaturalJointSupported);
+
 						LOGD(LogWaveVRHandPose, "TickHandData() Natural tracker, joint %d, pinchTHR %f",
 							m_NaturalTrackerInfo.jointCount,
 							m_NaturalTrackerInfo.pinchTHR);
@@ -337,11 +358,7 @@ void WaveVRHandPose::TickHandData()
 			if (hasNaturalTrackerInfo &&
 				((m_NaturalTrackerInfo.handModelTypeBitMask & (uint64_t)WVR_HandModelType::WVR_HandModelType_WithoutController) != 0))
 			{
-				IXRTrackingSystem* XRSystem = GEngine->XRSystem.Get();
-				EHMDTrackingOrigin::Type dofType = XRSystem->GetTrackingOrigin();
-				WVR_PoseOriginModel originModel =
-					(dofType == EHMDTrackingOrigin::Type::Floor ?
-						WVR_PoseOriginModel::WVR_PoseOriginModel_OriginOnGround : WVR_PoseOriginModel::WVR_PoseOriginModel_OriginOnHead);
+				const WVR_PoseOriginModel originModel = snapshot.TrackedOrigin;
 
 				hasNaturalTrackerData = (
 					WVR()->GetHandTrackingData(
@@ -360,31 +377,14 @@ void WaveVRHandPose::TickHandData()
 						NaturalHandScaleL = FVector(wvrScaleL.v[2], wvrScaleL.v[0], wvrScaleL.v[1]);
 						NaturalHandScaleR = FVector(wvrScaleR.v[2], wvrScaleR.v[0], wvrScaleR.v[1]);
 
-						NaturalWristLinearVelocityL = CoordinateUtil::GetVector3(m_NaturalHandTrackerData.left.wristLinearVelocity, GetWorldToMetersScale());
-						NaturalWristLinearVelocityR = CoordinateUtil::GetVector3(m_NaturalHandTrackerData.right.wristLinearVelocity, GetWorldToMetersScale());
-						NaturalWristAngularVelocityL = CoordinateUtil::GetVector3(m_NaturalHandTrackerData.left.wristAngularVelocity, GetWorldToMetersScale());
-						NaturalWristAngularVelocityR = CoordinateUtil::GetVector3(m_NaturalHandTrackerData.right.wristAngularVelocity, GetWorldToMetersScale());
-					}
-					for (uint32_t i = 0; i < m_NaturalTrackerInfo.jointCount; i++)
-					{
-						if ((m_NaturalTrackerInfo.jointValidFlagArray[i] & (uint64_t)WVR_HandJointValidFlag::WVR_HandJointValidFlag_PositionValid) != 0)
-						{
-							s_NaturalJointPositionLeft[(uint8)m_NaturalTrackerInfo.jointMappingArray[i]] =
-								CoordinateUtil::GetVector3(m_NaturalHandTrackerData.left.joints[i].position, GetWorldToMetersScale());
-							s_NaturalJointPositionRight[(uint8)m_NaturalTrackerInfo.jointMappingArray[i]] =
-								CoordinateUtil::GetVector3(m_NaturalHandTrackerData.right.joints[i].position, GetWorldToMetersScale());
-						}
-					}
-					for (uint32_t i = 0; i < m_NaturalTrackerInfo.jointCount; i++)
-					{
-						if ((m_NaturalTrackerInfo.jointValidFlagArray[i] & (uint64_t)WVR_HandJointValidFlag::WVR_HandJointValidFlag_RotationValid) != 0)
-						{
-							s_NaturalJointRotationLeft[(uint8)m_NaturalTrackerInfo.jointMappingArray[i]] =
-								CoordinateUtil::GetQuaternion(m_NaturalHandTrackerData.left.joints[i].rotation);
-							s_NaturalJointRotationRight[(uint8)m_NaturalTrackerInfo.jointMappingArray[i]] =
-								CoordinateUtil::GetQuaternion(m_NaturalHandTrackerData.right.joints[i].rotation);
-						}
+						NaturalWristLinearVelocityL = CoordinateUtil::GetVector3(m_NaturalHandTrackerData.left.wristLinearVelocity, snapshot.WorldToMeters);
+						NaturalWristLinearVelocityR = CoordinateUtil::GetVector3(m_NaturalHandTrackerData.right.wristLinearVelocity, snapshot.WorldToMeters);
+						NaturalWristAngularVelocityL = CoordinateUtil::GetVector3(m_NaturalHandTrackerData.left.wristAngularVelocity, snapshot.WorldToMeters);
+						NaturalWristAngularVelocityR = CoordinateUtil::GetVector3(m_NaturalHandTrackerData.right.wristAngularVelocity, snapshot.WorldToMeters);
 					}
+					WaveVRUtils::ConvertWVRHandJointsToUnrealPoses(m_NaturalTrackerInfo, m_NaturalHandTrackerData, snapshot.WorldToMeters,
+						s_NaturalJointPositionLeft, s_NaturalJointRotationLeft, s_NaturalJointPositionRight, s_NaturalJointRotationRight);
+					m_NaturalJointFrame = GFrameCounter;
 
 					if (printable)
 					{
@@ -490,6 +490,8 @@ void WaveVRHandPose::TickHandData()
 
 					if (hasElectronicTrackerInfo)
 					{
+						UpdateJointSupportedFlags(m_ElectronicTrackerInfo, s_ElectronicJointSupported);
+
 						LOGD(LogWaveVRHandPose, "TickHandData() Electronic tracker, joint %d, pinchTHR %f",
 							m_ElectronicTrackerInfo.jointCount,
 							m_ElectronicTrackerInfo.pinchTHR);
@@ -548,11 +550,7 @@ void WaveVRHandPose::TickHandData()
 			// Calls GetHandTrackingData on each frame.
 			if (hasElectronicTrackerInfo)
 			{
-				IXRTrackingSystem* XRSystem = GEngine->XRSystem.Get();
-				EHMDTrackingOrigin::Type dofType = XRSystem->GetTrackingOrigin();
-				WVR_PoseOriginModel originModel =
-					(dofType == EHMDTrackingOrigin::Type::Floor ?
-						WVR_PoseOriginModel::WVR_PoseOriginModel_OriginOnGround : WVR_PoseOriginModel::WVR_PoseOriginModel_OriginOnHead);
+				const WVR_PoseOriginModel originModel = snapshot.TrackedOrigin;
 
 				WVR_HandModelType handModel = WVR_HandModelType::WVR_HandModelType_WithoutController;
 				if ((m_ElectronicTrackerInfo.handModelTypeBitMask & (uint64_t)handModel) == 0)
@@ -575,32 +573,15 @@ void WaveVRHandPose::TickHandData()
 						ElectronicHandScaleL = FVector(wvrScaleL.v[2], wvrScaleL.v[0], wvrScaleL.v[1]);
 						ElectronicHandScaleR = FVector(wvrScaleR.v[2], wvrScaleR.v[0], wvrScaleR.v[1]);
 
-						ElectronicWristLinearVelocityL = CoordinateUtil::GetVector3(m_ElectronicHandTrackerData.left.wristLinearVelocity, GetWorldToMetersScale());
-						ElectronicWristLinearVelocityR = CoordinateUtil::GetVector3(m_ElectronicHandTrackerData.right.wristLinearVelocity, GetWorldToMetersScale());
-						ElectronicWristAngularVelocityL = CoordinateUtil::GetVector3(m_ElectronicHandTrackerData.left.wristAngularVelocity, GetWorldToMetersScale());
-						ElectronicWristAngularVelocityR = CoordinateUtil::GetVector3(m_ElectronicHandTrackerData.right.wristAngularVelocity, GetWorldToMetersScale());
+						ElectronicWristLinearVelocityL = CoordinateUtil::GetVector3(m_ElectronicHandTrackerData.left.wristLinearVelocity, snapshot.WorldToMeters);
+						ElectronicWristLinearVelocityR = CoordinateUtil::GetVector3(m_ElectronicHandTrackerData.right.wristLinearVelocity, snapshot.WorldToMeters);
+						ElectronicWristAngularVelocityL = CoordinateUtil::GetVector3(m_ElectronicHandTrackerData.left.wristAngularVelocity, snapshot.WorldToMeters);
+						ElectronicWristAngularVelocityR = CoordinateUtil::GetVector3(m_ElectronicHandTrackerData.right.wristAngularVelocity, snapshot.WorldToMeters);
 					}
 
-					for (uint32_t i = 0; i < m_ElectronicTrackerInfo.jointCount; i++)
-					{
-						if ((m_ElectronicTrackerInfo.jointValidFlagArray[i] & (uint64_t)WVR_HandJointValidFlag::WVR_HandJointValidFlag_PositionValid) != 0)
-						{
-							s_ElectronicJointPositionLeft[(uint8)m_ElectronicTrackerInfo.jointMappingArray[i]] =
-								CoordinateUtil::GetVector3(m_ElectronicHandTrackerData.left.joints[i].position, GetWorldToMetersScale());
-							s_ElectronicJointPositionRight[(uint8)m_ElectronicTrackerInfo.jointMappingArray[i]] =
-								CoordinateUtil::GetVector3(m_ElectronicHandTrackerData.right.joints[i].position, GetWorldToMetersScale());
-						}
-					}
-					for (uint32_t i = 0; i < m_ElectronicTrackerInfo.jointCount; i++)
-					{
-						if ((m_ElectronicTrackerInfo.jointValidFlagArray[i] & (uint64_t)WVR_HandJointValidFlag::WVR_HandJointValidFlag_RotationValid) != 0)
-						{
-							s_ElectronicJointRotationLeft[(uint8)m_ElectronicTrackerInfo.jointMappingArray[i]] =
-								CoordinateUtil::GetQuaternion(m_ElectronicHandTrackerData.left.joints[i].rotation);
-							s_ElectronicJointRotationRight[(uint8)m_ElectronicTrackerInfo.jointMappingArray[i]] =
-								CoordinateUtil::GetQuaternion(m_ElectronicHandTrackerData.right.joints[i].rotation);
-						}
-					}
+					WaveVRUtils::ConvertWVRHandJointsToUnrealPoses(m_ElectronicTrackerInfo, m_ElectronicHandTrackerData, snapshot.WorldToMeters,
+						s_ElectronicJointPositionLeft, s_ElectronicJointRotationLeft, s_ElectronicJointPositionRight, s_ElectronicJointRotationRight);
+					m_ElectronicJointFrame = GFrameCounter;
 				}
 			}
 			else
@@ -855,6 +836,33 @@ bool WaveVRHandPose::GetAllHandJointPoses(EWaveVRTrackerType tracker, EWaveVRHan
 
 	return true;
 }
+FWaveVRHandJointsView WaveVRHandPose::GetHandJointsView(EWaveVRTrackerType tracker, EWaveVRHandType hand)
+{
+	FWaveVRHandJointsView view;
+	view.bValid = IsHandPoseValid(tracker, hand);
+
+	const bool isLeft = (hand == EWaveVRHandType::Left);
+	view.BoneOffset = isLeft ? BONE_OFFSET_L : BONE_OFFSET_R;
+
+	if (tracker == EWaveVRTrackerType::Natural)
+	{
+		view.FrameNumber = m_NaturalJointFrame;
+		view.JointCount = s_NaturalJointPositionLeft.Num();
+		view.Positions = isLeft ? s_NaturalJointPositionLeft.GetData() : s_NaturalJointPositionRight.GetData();
+		view.Rotations = isLeft ? s_NaturalJointRotationLeft.GetData() : s_NaturalJointRotationRight.GetData();
+		view.JointSupported = s_NaturalJointSupported.GetData();
+	}
+	if (tracker == EWaveVRTrackerType::Electronic)
+	{
+		view.FrameNumber = m_ElectronicJointFrame;
+		view.JointCount = s_ElectronicJointPositionLeft.Num();
+		view.Positions = isLeft ? s_ElectronicJointPositionLeft.GetData() : s_ElectronicJointPositionRight.GetData();
+		view.Rotations = isLeft ? s_ElectronicJointRotationLeft.GetData() : s_ElectronicJointRotationRight.GetData();
+		view.JointSupported = s_ElectronicJointSupported.GetData();
+	}
+
+	return view;
+}
 EWaveVRHandMotion WaveVRHandPose::GetHandMotion(EWaveVRTrackerType tracker, EWaveVRHandType hand)
 {
 	if (tracker == EWaveVRTrackerType::Natural)
@@ -9,7 +9,7 @@
 // specifications, and documentation provided by HTC to You."
 
 #include "LipExpression/FWaveVRLipExpThread.h"
-#include "HAL/RunnableThread.h"
+#include "FWaveVRServiceThread.h"
 
 #include "Platforms/WaveVRAPIWrapper.h"
 #include "Platforms/WaveVRLogWrapper.h"
@@ -23,121 +23,87 @@ FWaveVRLipExpThread* FWaveVRLipExpThread::Runnable = NULL;
 //***********************************************************
 
 FWaveVRLipExpThread::FWaveVRLipExpThread()
-	: shutDownThread(false)
-	, getSupportedFeature(false)
-	, lipExpStatus(EWaveVRLipExpStatus::NOT_START)
+	: lipExpStatus(EWaveVRLipExpStatus::NOT_START)
 {
-	Thread = FRunnableThread::Create(this, TEXT("FWaveVRLipExpThread"));
+	FWaveVRServiceThread::Get()->Enqueue([this]() { CheckSupportedFeature(); });
 }
 
 FWaveVRLipExpThread::~FWaveVRLipExpThread()
 {
-	delete Thread;
-	Thread = NULL;
 }
 
-//Init
-bool FWaveVRLipExpThread::Init()
+void FWaveVRLipExpThread::CheckSupportedFeature()
 {
-	LOGD(LogFWaveVRLipExpThread, "Init()");
-	return true;
+	uint64_t supportedFeatures = FWaveVRAPIWrapper::GetInstance()->GetSupportedFeatures();
+	if ((supportedFeatures & (uint64_t)WVR_SupportedFeature::WVR_SupportedFeature_LipExp) == 0)
+	{
+		lipExpStatus = EWaveVRLipExpStatus::NO_SUPPORT;
+	}
+	else
+	{
+		lipExpStatus = EWaveVRLipExpStatus::NOT_START;
+	}
+
+	LOGD(LogFWaveVRLipExpThread, "CheckSupportedFeature() supportedFeatures %d, lipExpStatus %d", (int)supportedFeatures, (int)lipExpStatus);
 }
 
-//Run
-uint32 FWaveVRLipExpThread::Run()
+void FWaveVRLipExpThread::RunAction(Actions action)
 {
-	//Initial wait before starting
-	FPlatformProcess::Sleep(0.03);
-
-	while (!shutDownThread)
+	m_mutex.Lock();
+	switch (action)
 	{
-		if (!getSupportedFeature)
+	case Actions::Activate:
+		if (lipExpStatus == EWaveVRLipExpStatus::NOT_START || lipExpStatus == EWaveVRLipExpStatus::START_FAILURE)
 		{
-			uint64_t supportedFeatures = FWaveVRAPIWrapper::GetInstance()->GetSupportedFeatures();
-			if ((supportedFeatures & (uint64_t)WVR_SupportedFeature::WVR_SupportedFeature_LipExp) == 0)
-			{
-				lipExpStatus = EWaveVRLipExpStatus::NO_SUPPORT;
-			}
-			else
-			{
-				lipExpStatus = EWaveVRLipExpStatus::NOT_START;
-			}
-			getSupportedFeature = true;
-
-			LOGD(LogFWaveVRLipExpThread, "Run() supportedFeatures %d, lipExpStatus %d", (int)supportedFeatures, (int)lipExpStatus);
-		}
+			lipExpStatus = EWaveVRLipExpStatus::STARTING;
 
-		bool has_action = qActions.Dequeue(action);
-		if (has_action)
-		{
-			m_mutex.Lock();
-			switch (action)
+			LOGD(LogFWaveVRLipExpThread, "RunAction() Start LipExp.");
+			WVR_Result result = FWaveVRAPIWrapper::GetInstance()->StartLipExp();
+			switch (result)
 			{
-			case Actions::Activate:
-				if (lipExpStatus == EWaveVRLipExpStatus::NOT_START || lipExpStatus == EWaveVRLipExpStatus::START_FAILURE)
-				{
-					lipExpStatus = EWaveVRLipExpStatus::STARTING;
-
-					LOGD(LogFWaveVRLipExpThread, "Run() Start LipExp.");
-					WVR_Result result = FWaveVRAPIWrapper::GetInstance()->StartLipExp();
-					switch (result)
-					{
-					case WVR_Result::WVR_Success:
-						lipExpStatus = EWaveVRLipExpStatus::AVAILABLE;
-						break;
-					case WVR_Result::WVR_Error_FeatureNotSupport:
-						lipExpStatus = EWaveVRLipExpStatus::NO_SUPPORT;
-						break;
-					default:
-						lipExpStatus = EWaveVRLipExpStatus::START_FAILURE;
-						break;
-					}
-					LOGD(LogFWaveVRLipExpThread, "Run() Start LipExp result: %d", (uint8)result);
-				}
+			case WVR_Result::WVR_Success:
+				lipExpStatus = EWaveVRLipExpStatus::AVAILABLE;
 				break;
-			case Actions::Deactivate:
-				if (lipExpStatus == EWaveVRLipExpStatus::AVAILABLE)
-				{
-					lipExpStatus = EWaveVRLipExpStatus::STOPING;
-					LOGD(LogFWaveVRLipExpThread, "Run() Stop LipExp.");
-					FWaveVRAPIWrapper::GetInstance()->StopLipExp();
-					lipExpStatus = EWaveVRLipExpStatus::NOT_START;
-				}
+			case WVR_Result::WVR_Error_FeatureNotSupport:
+				lipExpStatus = EWaveVRLipExpStatus::NO_SUPPORT;
 				break;
 			default:
+				lipExpStatus = EWaveVRLipExpStatus::START_FAILURE;
 				break;
 			}
-			m_mutex.Unlock();
+			LOGD(LogFWaveVRLipExpThread, "RunAction() Start LipExp result: %d", (uint8)result);
 		}
-
-		FPlatformProcess::Sleep(0.1);
+		break;
+	case Actions::Deactivate:
+		if (lipExpStatus == EWaveVRLipExpStatus::AVAILABLE)
+		{
+			lipExpStatus = EWaveVRLipExpStatus::STOPING;
+			LOGD(LogFWaveVRLipExpThread, "RunAction() Stop LipExp.");
+			FWaveVRAPIWrapper::GetInstance()->StopLipExp();
+			lipExpStatus = EWaveVRLipExpStatus::NOT_START;
+		}
+		break;
+	default:
+		break;
 	}
-
-	return 0;
-}
-
-//stop
-void FWaveVRLipExpThread::Stop()
-{
+	m_mutex.Unlock();
 }
 
 FWaveVRLipExpThread* FWaveVRLipExpThread::JoyInit()
 {
-	//Create new instance of thread if it does not exist
+	//Create new instance if it does not exist
 	//		and the platform supports multi threading!
-	if (!Runnable && FPlatformProcess::SupportsMultithreading())
+	if (!Runnable && FWaveVRServiceThread::Get())
 	{
 		Runnable = new FWaveVRLipExpThread();
-		LOGD(LogFWaveVRLipExpThread, "JoyInit() Create new thread.");
+		LOGD(LogFWaveVRLipExpThread, "JoyInit() Create new instance.");
 	}
 	return Runnable;
 }
 
 void FWaveVRLipExpThread::EnsureCompletion()
 {
-	shutDownThread = true;
-	Stop();
-	Thread->WaitForCompletion();
+	FWaveVRServiceThread::Get()->Flush();
 }
 
 void FWaveVRLipExpThread::Shutdown()
@@ -149,3 +115,8 @@ void FWaveVRLipExpThread::Shutdown()
 		Runnable = NULL;
 	}
 }
+
+void FWaveVRLipExpThread::RequestAction(Actions action)
+{
+	FWaveVRServiceThread::Get()->Enqueue([this, action]() { RunAction(action); });
+}
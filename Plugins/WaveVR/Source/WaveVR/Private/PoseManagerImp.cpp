@@ -198,6 +198,7 @@ bool PoseManagerImp::LateUpdate_RenderThread(FrameDataPtr frameData)
 	WVR()->GetSyncPose(frameData->Origin, posePairs, WVR_DEVICE_COUNT_LEVEL_1);
 
 	framePoses.ConvertWVRPosesToUnrealPoses(frameData->meterToWorldUnit);
+	RecordPoses(frameData);
 
 	// Should not update Devices of PoseManager in RenderingThread.
 	//UpdateDevice(frameData);
@@ -244,11 +245,51 @@ void PoseManagerImp::UpdatePoses(FrameDataPtr frameData)
 	framePoses.ConvertWVRPosesToUnrealPoses(frameData->meterToWorldUnit);
 	UpdateDevice(frameData); //HMD , L-controller, R-controller
 
+	// A late update fetches this frame's poses again on the render thread and records them there.  Record
+	// each frame once, so the history never holds two different poses for the same poseTime.
+	if (!frameData->bSupportLateUpdate || !frameData->bNeedLateUpdateInRT)
+		RecordPoses(frameData);
+
 #if DEBUG
 	PrintDeviceInfo(frameData);
 #endif
 }
 
+void PoseManagerImp::RecordPoses(const FFrameData* frameData) {
+	const auto& framePoses = frameData->poses;
+	for (int i = 0; i < WVR_DEVICE_COUNT_LEVEL_1; i++) {
+		const int j = framePoses.deviceIndexMap[i];
+		if (j < 0 || j >= WVR_DEVICE_COUNT_LEVEL_1 || !framePoses.wvrPoses[j].pose.isValidPose)
+			continue;
+
+		PoseHistory[i].Push(FWaveVRPoseSample::FromWVRPose(framePoses.wvrPoses[j].pose,
+			framePoses.DeviceOrientation[i], framePoses.DevicePosition[i], frameData->meterToWorldUnit, frameData->poseTime));
+	}
+}
+
+const FWaveVRPoseHistory* PoseManagerImp::GetPoseHistory(WVR_DeviceType Type) const {
+	for (int i = 0; i < WVR_DEVICE_COUNT_LEVEL_1; i++) {
+		if (DeviceTypes[i] == Type)
+			return &PoseHistory[i];
+	}
+	return nullptr;
+}
+
+bool PoseManagerImp::GetDevicePoseAtTime(WVR_DeviceType Type, double Time, FQuat& OutOrientation, FVector& OutPosition) const {
+	const FWaveVRPoseHistory* history = GetPoseHistory(Type);
+	return history && history->SamplePose(Time, OutOrientation, OutPosition);
+}
+
+void PoseManagerImp::CaptureSnapshot(const FFrameData* frameData) {
+	check(IsInGameThread());
+	Snapshot.Capture(frameData, Origin);
+}
+
+void PoseManagerImp::CaptureSnapshotWithoutPoses(float worldToMeters) {
+	check(IsInGameThread());
+	Snapshot.CaptureWithoutPoses(Origin, worldToMeters);
+}
+
 void PoseManagerImp::PrintDeviceInfo(FrameDataPtr frameData) {
 	Device* devices[3] = {hmd, controllerLeft, controllerRight};
 	for(auto dev : devices) {
@@ -11,6 +11,8 @@
 #pragma once
 #include "WaveVRBlueprintFunctionLibrary.h"
 #include "WaveVRHMD_FrameData.h"
+#include "WaveVRPoseHistory.h"
+#include "WaveVRDeviceSnapshot.h"
 #include "HeadMountedDisplayTypes.h"
 
 class PoseManagerImp
@@ -64,6 +66,15 @@ public:
 	EHMDTrackingOrigin::Type GetTrackingOriginPoses();
 	WVR_PoseOriginModel GetTrackingOriginModelInternal();
 
+	// Poses recorded by UpdatePoses and LateUpdate_RenderThread, stamped with FFrameData::poseTime.  Time is in FPlatformTime::Seconds().  Any thread.
+	bool GetDevicePoseAtTime(WVR_DeviceType Type, double Time, FQuat& OutOrientation, FVector& OutPosition) const;
+	const FWaveVRPoseHistory* GetPoseHistory(WVR_DeviceType Type) const;
+
+	// Captured once per game frame, after UpdatePoses or without poses if none were fetched.  Game thread only.
+	void CaptureSnapshot(const FFrameData* frameData);
+	void CaptureSnapshotWithoutPoses(float worldToMeters);
+	const FWaveVRDeviceSnapshot& GetSnapshot() const { return Snapshot; }
+
 public:
 	void UpdateDevice(FrameDataPtr frameData);
 
@@ -71,6 +82,7 @@ private:
 	PoseManagerImp(); //prevent new instance directly
 
 	void PrintDeviceInfo(FrameDataPtr frameData);
+	void RecordPoses(const FFrameData* frameData);
 
 private:
 	Device* hmd = nullptr;
@@ -81,4 +93,6 @@ private:
 	EWVR_DOF ControllerSupportedDof = EWVR_DOF::DOF_3;
 	bool bIsHMDTrackingPosition = true;
 	bool bIsHMDTrackingRotation = true;
+	FWaveVRPoseHistory PoseHistory[WVR_DEVICE_COUNT_LEVEL_1];  // Index follows DeviceTypes.
+	FWaveVRDeviceSnapshot Snapshot;
 };
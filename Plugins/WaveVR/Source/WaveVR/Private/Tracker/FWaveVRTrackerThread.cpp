@@ -9,7 +9,7 @@
 // specifications, and documentation provided by HTC to You."
 
 #include "Tracker/FWaveVRTrackerThread.h"
-#include "HAL/RunnableThread.h"
+#include "FWaveVRServiceThread.h"
 
 #include "Platforms/WaveVRAPIWrapper.h"
 #include "Platforms/WaveVRLogWrapper.h"
@@ -23,121 +23,87 @@ FWaveVRTrackerThread* FWaveVRTrackerThread::Runnable = NULL;
 //***********************************************************
 
 FWaveVRTrackerThread::FWaveVRTrackerThread()
-	: shutDownThread(false)
-	, getSupportedFeature(false)
-	, trackerStatus(EWaveVRTrackerStatus::NOT_START)
+	: trackerStatus(EWaveVRTrackerStatus::NOT_START)
 {
-	Thread = FRunnableThread::Create(this, TEXT("FWaveVRTrackerThread"));
+	FWaveVRServiceThread::Get()->Enqueue([this]() { CheckSupportedFeature(); });
 }
 
 FWaveVRTrackerThread::~FWaveVRTrackerThread()
 {
-	delete Thread;
-	Thread = NULL;
 }
 
-//Init
-bool FWaveVRTrackerThread::Init()
+void FWaveVRTrackerThread::CheckSupportedFeature()
 {
-	LOGD(LogFWaveVRTrackerThread, "Init()");
-	return true;
+	uint64_t supportedFeatures = FWaveVRAPIWrapper::GetInstance()->GetSupportedFeatures();
+	if ((supportedFeatures & (uint64_t)WVR_SupportedFeature::WVR_SupportedFeature_Tracker) == 0)
+	{
+		trackerStatus = EWaveVRTrackerStatus::UNSUPPORT;
+	}
+	else
+	{
+		trackerStatus = EWaveVRTrackerStatus::NOT_START;
+	}
+
+	LOGD(LogFWaveVRTrackerThread, "CheckSupportedFeature() supportedFeatures %d, trackerStatus %d", (int)supportedFeatures, (int)trackerStatus);
 }
 
-//Run
-uint32 FWaveVRTrackerThread::Run()
+void FWaveVRTrackerThread::RunAction(Actions action)
 {
-	//Initial wait before starting
-	FPlatformProcess::Sleep(0.03);
-
-	while (!shutDownThread)
+	m_mutex.Lock();
+	switch (action)
 	{
-		if (!getSupportedFeature)
+	case Actions::Activate:
+		if (trackerStatus == EWaveVRTrackerStatus::NOT_START || trackerStatus == EWaveVRTrackerStatus::START_FAILURE)
 		{
-			uint64_t supportedFeatures = FWaveVRAPIWrapper::GetInstance()->GetSupportedFeatures();
-			if ((supportedFeatures & (uint64_t)WVR_SupportedFeature::WVR_SupportedFeature_Tracker) == 0)
-			{
-				trackerStatus = EWaveVRTrackerStatus::UNSUPPORT;
-			}
-			else
-			{
-				trackerStatus = EWaveVRTrackerStatus::NOT_START;
-			}
-			getSupportedFeature = true;
-
-			LOGD(LogFWaveVRTrackerThread, "Run() supportedFeatures %d, trackerStatus %d", (int)supportedFeatures, (int)trackerStatus);
-		}
+			trackerStatus = EWaveVRTrackerStatus::STARTING;
 
-		bool has_action = qActions.Dequeue(action);
-		if (has_action)
-		{
-			m_mutex.Lock();
-			switch (action)
+			LOGD(LogFWaveVRTrackerThread, "RunAction() Start Tracker.");
+			WVR_Result result = FWaveVRAPIWrapper::GetInstance()->StartTracker();
+			switch (result)
 			{
-			case Actions::Activate:
-				if (trackerStatus == EWaveVRTrackerStatus::NOT_START || trackerStatus == EWaveVRTrackerStatus::START_FAILURE)
-				{
-					trackerStatus = EWaveVRTrackerStatus::STARTING;
-
-					LOGD(LogFWaveVRTrackerThread, "Run() Start Tracker.");
-					WVR_Result result = FWaveVRAPIWrapper::GetInstance()->StartTracker();
-					switch (result)
-					{
-					case WVR_Result::WVR_Success:
-						trackerStatus = EWaveVRTrackerStatus::AVAILABLE;
-						break;
-					case WVR_Result::WVR_Error_FeatureNotSupport:
-						trackerStatus = EWaveVRTrackerStatus::UNSUPPORT;
-						break;
-					default:
-						trackerStatus = EWaveVRTrackerStatus::START_FAILURE;
-						break;
-					}
-					LOGD(LogFWaveVRTrackerThread, "Run() Start Tracker result: %d", (uint8)result);
-				}
+			case WVR_Result::WVR_Success:
+				trackerStatus = EWaveVRTrackerStatus::AVAILABLE;
 				break;
-			case Actions::Deactivate:
-				if (trackerStatus == EWaveVRTrackerStatus::AVAILABLE)
-				{
-					trackerStatus = EWaveVRTrackerStatus::STOPING;
-					LOGD(LogFWaveVRTrackerThread, "Run() Stop Tracker.");
-					FWaveVRAPIWrapper::GetInstance()->StopTracker();
-					trackerStatus = EWaveVRTrackerStatus::NOT_START;
-				}
+			case WVR_Result::WVR_Error_FeatureNotSupport:
+				trackerStatus = EWaveVRTrackerStatus::UNSUPPORT;
 				break;
 			default:
+				trackerStatus = EWaveVRTrackerStatus::START_FAILURE;
 				break;
 			}
-			m_mutex.Unlock();
+			LOGD(LogFWaveVRTrackerThread, "RunAction() Start Tracker result: %d", (uint8)result);
 		}
-
-		FPlatformProcess::Sleep(0.1);
+		break;
+	case Actions::Deactivate:
+		if (trackerStatus == EWaveVRTrackerStatus::AVAILABLE)
+		{
+			trackerStatus = EWaveVRTrackerStatus::STOPING;
+			LOGD(LogFWaveVRTrackerThread, "RunAction() Stop Tracker.");
+			FWaveVRAPIWrapper::GetInstance()->StopTracker();
+			trackerStatus = EWaveVRTrackerStatus::NOT_START;
+		}
+		break;
+	default:
+		break;
 	}
-
-	return 0;
-}
-
-//stop
-void FWaveVRTrackerThread::Stop()
-{
+	m_mutex.Unlock();
 }
 
 FWaveVRTrackerThread* FWaveVRTrackerThread::JoyInit()
 {
-	//Create new instance of thread if it does not exist
+	//Create new instance if it does not exist
 	//		and the platform supports multi threading!
-	if (!Runnable && FPlatformProcess::SupportsMultithreading())
+	if (!Runnable && FWaveVRServiceThread::Get())
 	{
 		Runnable = new FWaveVRTrackerThread();
-		LOGD(LogFWaveVRTrackerThread, "JoyInit() Create new thread.");
+		LOGD(LogFWaveVRTrackerThread, "JoyInit() Create new instance.");
 	}
 	return Runnable;
 }
 
 void FWaveVRTrackerThread::EnsureCompletion()
 {
-	shutDownThread = true;
-	Stop();
-	Thread->WaitForCompletion();
+	FWaveVRServiceThread::Get()->Flush();
 }
 
 void FWaveVRTrackerThread::Shutdown()
@@ -149,3 +115,8 @@ void FWaveVRTrackerThread::Shutdown()
 		Runnable = NULL;
 	}
 }
+
+void FWaveVRTrackerThread::RequestAction(Actions action)
+{
+	FWaveVRServiceThread::Get()->Enqueue([this, action]() { RunAction(action); });
+}
@@ -17,12 +17,13 @@
 #include "Platforms/WaveVRAPIWrapper.h"
 #include "Platforms/WaveVRLogWrapper.h"
 #include "WaveVRUtils.h"
+#include "WaveVRDeviceSnapshot.h"
 using namespace wvr::utils;
 
 DEFINE_LOG_CATEGORY_STATIC(LogWaveVRTrackerImpl, Log, All);
 
 WaveVRTrackerImpl * WaveVRTrackerImpl::Instance = nullptr;
-TMap<EWaveVRTrackerId, WVR_TrackerCapabilities> s_Capabilities;
+static WVR_TrackerCapabilities s_Capabilities[kTrackerCount];
 
 static FWaveVRAPIWrapper * Interop;
 
@@ -57,6 +58,26 @@ static WVR_InputId GetInputId(EWaveVRTrackerButton button)
 	return id;
 }
 
+static inline int GetTrackerSlot(EWaveVRTrackerId trackerId)
+{
+	check((uint8)trackerId < kTrackerCount);
+	return (int)trackerId;
+}
+
+static int GetButtonSlot(EWaveVRTrackerButton button)
+{
+	for (int i = 0; i < kTrackerButtonCount; i++)
+	{
+		if (k_TrackerButtons[i] == button) { return i; }
+	}
+	return INDEX_NONE;
+}
+
+static inline uint32 GetButtonMask(EWaveVRTrackerButton button)
+{
+	return 1u << (uint8)button;
+}
+
 static EWVR_AnalogType GetAnalogType(WVR_AnalogType analog)
 {
 	if (analog == WVR_AnalogType::WVR_AnalogType_None) { return EWVR_AnalogType::None; }
@@ -66,10 +87,43 @@ static EWVR_AnalogType GetAnalogType(WVR_AnalogType analog)
 	return EWVR_AnalogType::None;
 }
 
+void FWaveVRTrackerStates::Reset()
+{
+	for (int i = 0; i < kTrackerCount; i++)
+	{
+		Connected[i] = false;
+		Roles[i] = EWaveVRTrackerRole::Undefined;
+
+		ValidPoses[i] = false;
+		Positions[i] = FVector::ZeroVector;
+		Orientations[i] = FQuat::Identity;
+
+		ButtonBits[i] = 0;
+		TouchBits[i] = 0;
+		AnalogBits[i] = 0;
+
+		ButtonPress[i] = 0;
+		ButtonTouch[i] = 0;
+		for (int j = 0; j < kTrackerButtonCount; j++)
+		{
+			AnalogTypes[i][j] = EWVR_AnalogType::None;
+			ButtonAxis[i][j] = FVector2D::ZeroVector;
+		}
+
+		BatteryLife[i] = 0;
+	}
+}
+
 WaveVRTrackerImpl::WaveVRTrackerImpl()
+	: m_TrackerThread(nullptr)
+	, m_ReadIndex(0)
 {
 	Instance = this;
 	Interop = FWaveVRAPIWrapper::GetInstance();
+
+	m_Work.Reset();
+	m_Frames[0] = m_Work;
+	m_Frames[1] = m_Work;
 }
 
 WaveVRTrackerImpl::~WaveVRTrackerImpl()
@@ -79,59 +133,24 @@ WaveVRTrackerImpl::~WaveVRTrackerImpl()
 
 void WaveVRTrackerImpl::InitTrackerData()
 {
+	m_Work.Reset();
 	for (int i = 0; i < kTrackerCount; i++)
 	{
-		// Connection
-		s_Connections.Add(k_TrackerIds[i], false);
-
-		// Tracker Role
-		s_Roles.Add(k_TrackerIds[i], EWaveVRTrackerRole::Undefined);
-
-		// Capabilities
-		s_Capabilities.Add(k_TrackerIds[i], WVR_TrackerCapabilities());
-		s_Capabilities[k_TrackerIds[i]].supportsOrientationTracking = false;
-		s_Capabilities[k_TrackerIds[i]].supportsPositionTracking = false;
-		s_Capabilities[k_TrackerIds[i]].supportsInputDevice = false;
-		s_Capabilities[k_TrackerIds[i]].supportsHapticVibration = false;
-		s_Capabilities[k_TrackerIds[i]].supportsBatteryLevel = false;
-
-		// Pose State
-		s_Positions.Add(k_TrackerIds[i], FVector::ZeroVector);
-		s_Orientations.Add(k_TrackerIds[i], FQuat::Identity);
-		s_ValidPoses.Add(k_TrackerIds[i], false);
-
-		// Input Capability
-		s_ButtonBits.Add(k_TrackerIds[i], 0);
-		s_TouchBits.Add(k_TrackerIds[i], 0);
-		s_AnalogBits.Add(k_TrackerIds[i], 0);
-
-		// Input Analog
-		s_InputAnalogs.Add(k_TrackerIds[i]);
-		for (uint8 j = 0; j < (uint8)kAllButtonCount; j++)
-		{
-			s_InputAnalogs[k_TrackerIds[i]].Add(j, EWVR_AnalogType::None);
-		}
-
-		// Button State
-		s_ButtonPress.Add(k_TrackerIds[i]);
-		s_ButtonPress[k_TrackerIds[i]].Init(false, (uint8)kAllButtonCount);
-		s_ButtonTouch.Add(k_TrackerIds[i]);
-		s_ButtonTouch[k_TrackerIds[i]].Init(false, (uint8)kAllButtonCount);
-		s_ButtonAxis.Add(k_TrackerIds[i]);
-		s_ButtonAxis[k_TrackerIds[i]].Init(FVector2D::ZeroVector, (uint8)kAllButtonCount);
-
-		// Battery
-		s_BatteryLife.Add(k_TrackerIds[i], 0);
-
-		// Extended Data
-		s_ExtDataSize.Add(k_TrackerIds[i], 0);
-		s_ExtData.Add(k_TrackerIds[i], new int32_t());
+		ResetCapabilities(i);
+		m_ExtData[i].Reset();
 	}
+	Publish();
 
 	m_TrackerThread = FWaveVRTrackerThread::JoyInit();
 
 	LOGD(LogWaveVRTrackerImpl, "InitTrackerData()");
 }
+void WaveVRTrackerImpl::Publish()
+{
+	const int32 writeIndex = 1 - m_ReadIndex.Load(EMemoryOrder::Relaxed);
+	m_Frames[writeIndex] = m_Work;
+	m_ReadIndex.Store(writeIndex);
+}
 bool WaveVRTrackerImpl::LogInterval()
 {
 	if (logFrame != GFrameCounter)
@@ -142,7 +161,7 @@ bool WaveVRTrackerImpl::LogInterval()
 	}
 	return (logCount == 0);
 }
-void WaveVRTrackerImpl::TickTrackerData()
+void WaveVRTrackerImpl::TickTrackerData(const FWaveVRDeviceSnapshot& snapshot)
 {
 	LogInterval();
 	if (m_TrackerThread == NULL) { return; }
@@ -152,33 +171,34 @@ void WaveVRTrackerImpl::TickTrackerData()
 
 	for (int i = 0; i < kTrackerCount; i++)
 	{
-		EWaveVRTrackerId trackerId = k_TrackerIds[i];
+		CheckConnections(i);
+	}
+	CheckPoseStates(snapshot);
 
-		CheckConnections(trackerId);
-		CheckPoseState(trackerId);
-		CheckExtendedData(trackerId);
-		for (int j = 0; j < kTrackerButtonCount; j++)
-		{
-			CheckButtonAxis(trackerId, k_TrackerButtons[j]);
-		}
+	for (int i = 0; i < kTrackerCount; i++)
+	{
+		CheckExtendedData(i);
+		CheckButtonAxes(i);
 
 		if (LogInterval())
 		{
 			LOGD(LogWaveVRTrackerImpl, "TickTrackerData() tracker: %d, role: %d\nsupportsOrientationTracking: %d, supportsPositionTracking: %d\nsupportsInputDevice: %d, supportsHapticVibration: %d, supportsBatteryLevel: %d\nvalid pose: %d, button: %d, touch: %d, analog: %d, battery: %f"
-				, (uint8)trackerId
-				, (uint8)s_Roles[trackerId]
-				, (uint8)s_Capabilities[trackerId].supportsOrientationTracking
-				, (uint8)s_Capabilities[trackerId].supportsPositionTracking
-				, (uint8)s_Capabilities[trackerId].supportsInputDevice
-				, (uint8)s_Capabilities[trackerId].supportsHapticVibration
-				, (uint8)s_Capabilities[trackerId].supportsBatteryLevel
-				, (uint8)s_ValidPoses[trackerId]
-				, s_ButtonBits[trackerId]
-				, s_TouchBits[trackerId]
-				, s_AnalogBits[trackerId]
-				, s_BatteryLife[trackerId]);
+				, i
+				, (uint8)m_Work.Roles[i]
+				, (uint8)s_Capabilities[i].supportsOrientationTracking
+				, (uint8)s_Capabilities[i].supportsPositionTracking
+				, (uint8)s_Capabilities[i].supportsInputDevice
+				, (uint8)s_Capabilities[i].supportsHapticVibration
+				, (uint8)s_Capabilities[i].supportsBatteryLevel
+				, (uint8)m_Work.ValidPoses[i]
+				, m_Work.ButtonBits[i]
+				, m_Work.TouchBits[i]
+				, m_Work.AnalogBits[i]
+				, m_Work.BatteryLife[i]);
 		}
 	}
+
+	Publish();
 }
 
 #pragma region
@@ -208,147 +228,154 @@ bool WaveVRTrackerImpl::CanStopTracker()
 #pragma endregion Life cycle
 
 #pragma region
-void WaveVRTrackerImpl::CheckConnections(EWaveVRTrackerId trackerId)
+void WaveVRTrackerImpl::CheckConnections(int slot)
 {
 	bool connected = false;
 	EWaveVRTrackerStatus status = m_TrackerThread->GetTrackerStatus();
 	if (status == EWaveVRTrackerStatus::AVAILABLE)
 	{
-		WVR_TrackerId tracker = static_cast<WVR_TrackerId>(trackerId);
+		WVR_TrackerId tracker = static_cast<WVR_TrackerId>(slot);
 		connected = Interop->IsTrackerConnected(tracker);
 	}
 
-	if (s_Connections[trackerId] != connected)
+	if (m_Work.Connected[slot] != connected)
 	{
-		s_Connections[trackerId] = connected;
-		LOGD(LogWaveVRTrackerImpl, "CheckConnections() tracker %d, connected %d", (uint8)trackerId, (uint8)s_Connections[trackerId]);
-		CheckStatusWhenConnectionChanges(trackerId);
+		m_Work.Connected[slot] = connected;
+		LOGD(LogWaveVRTrackerImpl, "CheckConnections() tracker %d, connected %d", slot, (uint8)m_Work.Connected[slot]);
+		CheckStatusWhenConnectionChanges(slot);
 	}
 }
 void WaveVRTrackerImpl::OnTrackerConnection(uint8 trackerId, bool connected)
 {
 	LOGD(LogWaveVRTrackerImpl, "OnTrackerConnection() tracker %d, connected %d", trackerId, (uint8)connected);
-	EWaveVRTrackerId id = GetTrackerId(trackerId);
+	const int slot = GetTrackerSlot(GetTrackerId(trackerId));
 
-	if (s_Connections[id] != connected)
+	if (m_Work.Connected[slot] != connected)
 	{
-		s_Connections[id] = connected;
-		CheckStatusWhenConnectionChanges(id);
+		m_Work.Connected[slot] = connected;
+		CheckStatusWhenConnectionChanges(slot);
+		Publish();
 	}
 }
-void WaveVRTrackerImpl::CheckStatusWhenConnectionChanges(EWaveVRTrackerId trackerId)
+void WaveVRTrackerImpl::CheckStatusWhenConnectionChanges(int slot)
 {
-	CheckRole(trackerId);
-	CheckCapabilities(trackerId);
-	CheckInputCapability(trackerId);
-	CheckAnalogType(trackerId);
-	CheckButtonStates(trackerId);
-	CheckBatteryLife(trackerId);
+	CheckRole(slot);
+	CheckCapabilities(slot);
+	CheckInputCapability(slot);
+	CheckAnalogType(slot);
+	CheckButtonStates(slot);
+	CheckBatteryLife(slot);
 }
 #pragma endregion Connection
 
 #pragma region
-void WaveVRTrackerImpl::CheckRole(EWaveVRTrackerId trackerId)
+void WaveVRTrackerImpl::CheckRole(int slot)
 {
-	WVR_TrackerId tracker = static_cast<WVR_TrackerId>(trackerId);
-	s_Roles[trackerId] = (s_Connections[trackerId] ?
+	WVR_TrackerId tracker = static_cast<WVR_TrackerId>(slot);
+	m_Work.Roles[slot] = (m_Work.Connected[slot] ?
 		(EWaveVRTrackerRole)Interop->GetTrackerRole(tracker) : EWaveVRTrackerRole::Undefined);
-	LOGD(LogWaveVRTrackerImpl, "CheckRole() tracker %d, role %d", (uint8)trackerId, (uint8)s_Roles[trackerId]);
+	LOGD(LogWaveVRTrackerImpl, "CheckRole() tracker %d, role %d", slot, (uint8)m_Work.Roles[slot]);
 }
 #pragma endregion Tracker Role
 
 #pragma region
-void WaveVRTrackerImpl::CheckCapabilities(EWaveVRTrackerId trackerId)
+void WaveVRTrackerImpl::CheckCapabilities(int slot)
 {
-	WVR_TrackerId tracker = static_cast<WVR_TrackerId>(trackerId);
+	WVR_TrackerId tracker = static_cast<WVR_TrackerId>(slot);
 
-	if (s_Connections[trackerId])
+	if (m_Work.Connected[slot])
 	{
-		WVR_Result result = Interop->GetTrackerCapabilities(tracker, &s_Capabilities[trackerId]);
-		if (result != WVR_Result::WVR_Success) { ResetCapabilities(trackerId); }
+		WVR_Result result = Interop->GetTrackerCapabilities(tracker, &s_Capabilities[slot]);
+		if (result != WVR_Result::WVR_Success) { ResetCapabilities(slot); }
 
 		LOGD(LogWaveVRTrackerImpl, "CheckCapabilities() tracker %d, result %d\nsupportsOrientationTracking: %d\nsupportsPositionTracking: %d\nsupportsInputDevice: %d\nsupportsHapticVibration: %d\nsupportsBatteryLevel: %d"
-			, (uint8)trackerId, (uint8)result
-			, (uint8)s_Capabilities[trackerId].supportsOrientationTracking
-			, (uint8)s_Capabilities[trackerId].supportsPositionTracking
-			, (uint8)s_Capabilities[trackerId].supportsInputDevice
-			, (uint8)s_Capabilities[trackerId].supportsHapticVibration
-			, (uint8)s_Capabilities[trackerId].supportsBatteryLevel);
+			, slot, (uint8)result
+			, (uint8)s_Capabilities[slot].supportsOrientationTracking
+			, (uint8)s_Capabilities[slot].supportsPositionTracking
+			, (uint8)s_Capabilities[slot].supportsInputDevice
+			, (uint8)s_Capabilities[slot].supportsHapticVibration
+			, (uint8)s_Capabilities[slot].supportsBatteryLevel);
 	}
 	else
 	{
-		ResetCapabilities(trackerId);
+		ResetCapabilities(slot);
 	}
 }
-void WaveVRTrackerImpl::ResetCapabilities(EWaveVRTrackerId trackerId)
+void WaveVRTrackerImpl::ResetCapabilities(int slot)
 {
-	s_Capabilities[trackerId].supportsOrientationTracking = false;
-	s_Capabilities[trackerId].supportsPositionTracking = false;
-	s_Capabilities[trackerId].supportsInputDevice = false;
-	s_Capabilities[trackerId].supportsHapticVibration = false;
-	s_Capabilities[trackerId].supportsBatteryLevel = false;
+	s_Capabilities[slot].supportsOrientationTracking = false;
+	s_Capabilities[slot].supportsPositionTracking = false;
+	s_Capabilities[slot].supportsInputDevice = false;
+	s_Capabilities[slot].supportsHapticVibration = false;
+	s_Capabilities[slot].supportsBatteryLevel = false;
 }
 #pragma endregion Capabilities
 
 #pragma region
-void WaveVRTrackerImpl::CheckPoseState(EWaveVRTrackerId trackerId)
+void WaveVRTrackerImpl::CheckPoseStates(const FWaveVRDeviceSnapshot& snapshot)
 {
-	s_ValidPoses[trackerId] = false;
-
-	WVR_TrackerId tracker = static_cast<WVR_TrackerId>(trackerId);
+	WVR_PoseState_t poses[kTrackerCount];
+	const WVR_Matrix4f_t* matrices[kTrackerCount];
+	FQuat orientations[kTrackerCount];
+	FVector positions[kTrackerCount];
+	int slots[kTrackerCount];
+	int count = 0;
 
-	if (s_Connections[trackerId])
+	for (int i = 0; i < kTrackerCount; i++)
 	{
-		if (s_Capabilities[trackerId].supportsOrientationTracking)
+		m_Work.ValidPoses[i] = false;
+
+		if (!m_Work.Connected[i] || !s_Capabilities[i].supportsOrientationTracking)
+			continue;
+
+		WVR_PoseOriginModel origin = s_Capabilities[i].supportsPositionTracking ?
+			snapshot.TrackedOrigin : WVR_PoseOriginModel::WVR_PoseOriginModel_OriginOnHead_3DoF;
+
+		WVR_PoseState_t& pose = poses[count];
+		WVR_Result result = Interop->GetTrackerPoseState(static_cast<WVR_TrackerId>(i), origin, snapshot.PredictMilliseconds, &pose);
+		if (result == WVR_Result::WVR_Success)
 		{
-			WVR_PoseOriginModel origin = WVR_PoseOriginModel::WVR_PoseOriginModel_OriginOnHead_3DoF;
-			if (s_Capabilities[trackerId].supportsPositionTracking)
-			{
-				IXRTrackingSystem* XRSystem = GEngine->XRSystem.Get();
-				EHMDTrackingOrigin::Type dofType = XRSystem->GetTrackingOrigin();
-				WVR_PoseOriginModel originModel =
-					(dofType == EHMDTrackingOrigin::Type::Floor ?
-						WVR_PoseOriginModel::WVR_PoseOriginModel_OriginOnGround : WVR_PoseOriginModel::WVR_PoseOriginModel_OriginOnHead);
-
-				origin = originModel;
-			}
-
-			WVR_PoseState_t pose;
-			WVR_Result result = Interop->GetTrackerPoseState(tracker, origin, 0, &pose);
-			if (result == WVR_Result::WVR_Success)
-			{
-				s_ValidPoses[trackerId] = pose.isValidPose;
-				CoordinateUtil::MatrixToPose(pose.poseMatrix, s_Orientations[trackerId], s_Positions[trackerId], GetWorldToMetersScale());
-			}
+			m_Work.ValidPoses[i] = pose.isValidPose;
+			matrices[count] = &pose.poseMatrix;
+			slots[count] = i;
+			count++;
 		}
 	}
+
+	// Convert the poses of all trackers in one batch.
+	WaveVRUtils::ConvertWVRMatricesToUnrealPoses(matrices, count, snapshot.WorldToMeters, orientations, positions);
+	for (int i = 0; i < count; i++)
+	{
+		m_Work.Orientations[slots[i]] = orientations[i];
+		m_Work.Positions[slots[i]] = positions[i];
+	}
 }
 #pragma endregion Pose State
 
 #pragma region
-void WaveVRTrackerImpl::CheckInputCapability(EWaveVRTrackerId trackerId)
+void WaveVRTrackerImpl::CheckInputCapability(int slot)
 {
-	WVR_TrackerId id = static_cast<WVR_TrackerId>(trackerId);
+	WVR_TrackerId id = static_cast<WVR_TrackerId>(slot);
 
-	s_ButtonBits[trackerId] = s_Connections[trackerId] ?
-		(s_Capabilities[trackerId].supportsInputDevice ?
+	m_Work.ButtonBits[slot] = m_Work.Connected[slot] ?
+		(s_Capabilities[slot].supportsInputDevice ?
 			Interop->GetTrackerInputDeviceCapability(id, WVR_InputType::WVR_InputType_Button) : 0)
 		: 0;
-	LOGD(LogWaveVRTrackerImpl, "CheckInputCapability() tracker %d, button %d", (uint8)trackerId, s_ButtonBits[trackerId]);
+	LOGD(LogWaveVRTrackerImpl, "CheckInputCapability() tracker %d, button %d", slot, m_Work.ButtonBits[slot]);
 
-	s_TouchBits[trackerId] = s_Connections[trackerId] ?
-		(s_Capabilities[trackerId].supportsInputDevice ?
+	m_Work.TouchBits[slot] = m_Work.Connected[slot] ?
+		(s_Capabilities[slot].supportsInputDevice ?
 			Interop->GetTrackerInputDeviceCapability(id, WVR_InputType::WVR_InputType_Touch) : 0)
 		: 0;
-	LOGD(LogWaveVRTrackerImpl, "CheckInputCapability() tracker %d, touch %d", (uint8)trackerId, s_TouchBits[trackerId]);
+	LOGD(LogWaveVRTrackerImpl, "CheckInputCapability() tracker %d, touch %d", slot, m_Work.TouchBits[slot]);
 
-	s_AnalogBits[trackerId] = s_Connections[trackerId] ?
-		(s_Capabilities[trackerId].supportsInputDevice ?
+	m_Work.AnalogBits[slot] = m_Work.Connected[slot] ?
+		(s_Capabilities[slot].supportsInputDevice ?
 			Interop->GetTrackerInputDeviceCapability(id, WVR_InputType::WVR_InputType_Analog) : 0)
 		: 0;
-	LOGD(LogWaveVRTrackerImpl, "CheckInputCapability() tracker %d, analog %d", (uint8)trackerId, s_AnalogBits[trackerId]);
+	LOGD(LogWaveVRTrackerImpl, "CheckInputCapability() tracker %d, analog %d", slot, m_Work.AnalogBits[slot]);
 }
-bool WaveVRTrackerImpl::IsInputAvailable(EWaveVRTrackerId trackerId, EWVR_InputType inputType, EWaveVRTrackerButton button)
+bool WaveVRTrackerImpl::IsInputAvailable(int slot, EWVR_InputType inputType, EWaveVRTrackerButton button)
 {
 	bool ret = false;
 	
@@ -356,13 +383,13 @@ bool WaveVRTrackerImpl::IsInputAvailable(EWaveVRTrackerId trackerId, EWVR_InputT
 	switch (inputType)
 	{
 	case EWVR_InputType::Button:
-		ret = ((s_ButtonBits[trackerId] & input) == input);
+		ret = ((m_Work.ButtonBits[slot] & input) == input);
 		break;
 	case EWVR_InputType::Touch:
-		ret = ((s_TouchBits[trackerId] & input) == input);
+		ret = ((m_Work.TouchBits[slot] & input) == input);
 		break;
 	case EWVR_InputType::Analog:
-		ret = ((s_AnalogBits[trackerId] & input) == input);
+		ret = ((m_Work.AnalogBits[slot] & input) == input);
 		break;
 	default:
 		break;
@@ -373,15 +400,15 @@ bool WaveVRTrackerImpl::IsInputAvailable(EWaveVRTrackerId trackerId, EWVR_InputT
 #pragma endregion Input Capability
 
 #pragma region
-void WaveVRTrackerImpl::CheckAnalogType(EWaveVRTrackerId trackerId)
+void WaveVRTrackerImpl::CheckAnalogType(int slot)
 {
-	WVR_TrackerId tracker = static_cast<WVR_TrackerId>(trackerId);
+	WVR_TrackerId tracker = static_cast<WVR_TrackerId>(slot);
 
 	for (int i = 0; i < kTrackerButtonCount; i++)
 	{
 		WVR_InputId id = GetInputId(k_TrackerButtons[i]);
-		s_InputAnalogs[trackerId][(uint8)k_TrackerButtons[i]] = s_Connections[trackerId] ?
-			(IsInputAvailable(trackerId, EWVR_InputType::Analog, k_TrackerButtons[i]) ?
+		m_Work.AnalogTypes[slot][i] = m_Work.Connected[slot] ?
+			(IsInputAvailable(slot, EWVR_InputType::Analog, k_TrackerButtons[i]) ?
 				GetAnalogType(Interop->GetTrackerInputDeviceAnalogType(tracker, id)) : EWVR_AnalogType::None)
 			: EWVR_AnalogType::None;
 	}
@@ -389,115 +416,121 @@ void WaveVRTrackerImpl::CheckAnalogType(EWaveVRTrackerId trackerId)
 #pragma endregion Input Analog
 
 #pragma region
-void WaveVRTrackerImpl::CheckButtonAxis(EWaveVRTrackerId trackerId, EWaveVRTrackerButton button)
+void WaveVRTrackerImpl::CheckButtonAxes(int slot)
 {
-	WVR_TrackerId tracker = static_cast<WVR_TrackerId>(trackerId);
-	WVR_InputId id = GetInputId(button);
+	WVR_TrackerId tracker = static_cast<WVR_TrackerId>(slot);
+	FVector2D* axes = m_Work.ButtonAxis[slot];
+
+	if (!m_Work.Connected[slot] || m_Work.AnalogBits[slot] == 0)
+	{
+		for (int i = 0; i < kTrackerButtonCount; i++) { axes[i] = FVector2D::ZeroVector; }
+		return;
+	}
 
-	if (s_Connections[trackerId])
+	for (int i = 0; i < kTrackerButtonCount; i++)
 	{
-		if (IsInputAvailable(trackerId, EWVR_InputType::Analog, button))
+		if (IsInputAvailable(slot, EWVR_InputType::Analog, k_TrackerButtons[i]))
 		{
-			WVR_Axis_t axis = Interop->GetTrackerInputAnalogAxis(tracker, id);
-			s_ButtonAxis[trackerId][(uint8)button].X = axis.x;
-			s_ButtonAxis[trackerId][(uint8)button].Y = axis.y;
+			WVR_Axis_t axis = Interop->GetTrackerInputAnalogAxis(tracker, GetInputId(k_TrackerButtons[i]));
+			axes[i].X = axis.x;
+			axes[i].Y = axis.y;
 		}
 		else
 		{
-			s_ButtonAxis[trackerId][(uint8)button] = FVector2D::ZeroVector;
+			axes[i] = FVector2D::ZeroVector;
 		}
 	}
-	else
-	{
-		s_ButtonAxis[trackerId][(uint8)button] = FVector2D::ZeroVector;
-	}
 }
-void WaveVRTrackerImpl::CheckButtonStates(EWaveVRTrackerId trackerId)
+void WaveVRTrackerImpl::CheckButtonStates(int slot)
 {
-	WVR_TrackerId tracker = static_cast<WVR_TrackerId>(trackerId);
+	WVR_TrackerId tracker = static_cast<WVR_TrackerId>(slot);
+	uint32 press = 0, touch = 0;
 
-	for (int i = 0; i < kTrackerButtonCount; i++)
+	if (m_Work.Connected[slot])
 	{
-		WVR_InputId id = GetInputId(k_TrackerButtons[i]);
+		for (int i = 0; i < kTrackerButtonCount; i++)
+		{
+			WVR_InputId id = GetInputId(k_TrackerButtons[i]);
 
-		s_ButtonPress[trackerId][(uint8)k_TrackerButtons[i]] = s_Connections[trackerId] ?
-			(IsInputAvailable(trackerId, EWVR_InputType::Button, k_TrackerButtons[i]) ?
-				Interop->GetTrackerInputButtonState(tracker, id) : false)
-			: false;
+			if (IsInputAvailable(slot, EWVR_InputType::Button, k_TrackerButtons[i]) && Interop->GetTrackerInputButtonState(tracker, id))
+				press |= GetButtonMask(k_TrackerButtons[i]);
 
-		s_ButtonTouch[trackerId][(uint8)k_TrackerButtons[i]] = s_Connections[trackerId] ?
-			(IsInputAvailable(trackerId, EWVR_InputType::Touch, k_TrackerButtons[i]) ?
-				Interop->GetTrackerInputTouchState(tracker, id) : false)
-			: false;
+			if (IsInputAvailable(slot, EWVR_InputType::Touch, k_TrackerButtons[i]) && Interop->GetTrackerInputTouchState(tracker, id))
+				touch |= GetButtonMask(k_TrackerButtons[i]);
 
-		// Axis is checked every tick.
+			// Axis is checked every tick.
+		}
 	}
+
+	m_Work.ButtonPress[slot] = press;
+	m_Work.ButtonTouch[slot] = touch;
 }
 void WaveVRTrackerImpl::OnButtonPress(uint8 trackerId, uint8 buttonId, bool press)
 {
-	EWaveVRTrackerId id = GetTrackerId(trackerId);
-	s_ButtonPress[id][buttonId] = press;
-	LOGD(LogWaveVRTrackerImpl, "OnButtonPress() tracker %d, button %d, press %d", trackerId, buttonId, (uint8)s_ButtonPress[id][buttonId]);
+	if (buttonId >= kAllButtonCount) { return; }
+
+	const int slot = GetTrackerSlot(GetTrackerId(trackerId));
+	const uint32 mask = 1u << buttonId;
+	m_Work.ButtonPress[slot] = press ? (m_Work.ButtonPress[slot] | mask) : (m_Work.ButtonPress[slot] & ~mask);
+	Publish();
+	LOGD(LogWaveVRTrackerImpl, "OnButtonPress() tracker %d, button %d, press %d", trackerId, buttonId, (uint8)press);
 }
 void WaveVRTrackerImpl::OnButtonTouch(uint8 trackerId, uint8 buttonId, bool touch)
 {
-	EWaveVRTrackerId id = GetTrackerId(trackerId);
-	s_ButtonTouch[id][buttonId] = touch;
-	LOGD(LogWaveVRTrackerImpl, "OnButtonTouch() tracker %d, button %d, touch %d", trackerId, buttonId, (uint8)s_ButtonTouch[id][buttonId]);
+	if (buttonId >= kAllButtonCount) { return; }
+
+	const int slot = GetTrackerSlot(GetTrackerId(trackerId));
+	const uint32 mask = 1u << buttonId;
+	m_Work.ButtonTouch[slot] = touch ? (m_Work.ButtonTouch[slot] | mask) : (m_Work.ButtonTouch[slot] & ~mask);
+	Publish();
+	LOGD(LogWaveVRTrackerImpl, "OnButtonTouch() tracker %d, button %d, touch %d", trackerId, buttonId, (uint8)touch);
 }
 #pragma endregion Button State
 
 #pragma region
-void WaveVRTrackerImpl::CheckBatteryLife(EWaveVRTrackerId trackerId)
+void WaveVRTrackerImpl::CheckBatteryLife(int slot)
 {
-	WVR_TrackerId tracker = static_cast<WVR_TrackerId>(trackerId);
+	WVR_TrackerId tracker = static_cast<WVR_TrackerId>(slot);
 
-	s_BatteryLife[trackerId] = s_Connections[trackerId] ?
-		(s_Capabilities[trackerId].supportsBatteryLevel ?
+	m_Work.BatteryLife[slot] = m_Work.Connected[slot] ?
+		(s_Capabilities[slot].supportsBatteryLevel ?
 			Interop->GetTrackerBatteryLevel(tracker) : 0)
 		: 0;
 
-	LOGD(LogWaveVRTrackerImpl, "CheckBatteryLife() tracker %d, battery %f", (uint8)trackerId, s_BatteryLife[trackerId]);
+	LOGD(LogWaveVRTrackerImpl, "CheckBatteryLife() tracker %d, battery %f", slot, m_Work.BatteryLife[slot]);
 }
 void WaveVRTrackerImpl::OnTrackerBatteryLevelUpdate(uint8 trackerId)
 {
-	EWaveVRTrackerId id = GetTrackerId(trackerId);
-	CheckBatteryLife(id);
+	const int slot = GetTrackerSlot(GetTrackerId(trackerId));
+	CheckBatteryLife(slot);
+	Publish();
 
-	LOGD(LogWaveVRTrackerImpl, "OnTrackerBatteryLevelUpdate() tracker %d, battery %f", trackerId, s_BatteryLife[id]);
+	LOGD(LogWaveVRTrackerImpl, "OnTrackerBatteryLevelUpdate() tracker %d, battery %f", trackerId, m_Work.BatteryLife[slot]);
 }
 #pragma endregion Battery
 
 #pragma region
-void WaveVRTrackerImpl::CheckExtendedData(EWaveVRTrackerId trackerId)
+void WaveVRTrackerImpl::CheckExtendedData(int slot)
 {
-	if (s_Connections[trackerId])
+	if (m_Work.Connected[slot])
 	{
 		int32_t size = 0;
-		int32_t *p = Interop->GetTrackerExtendedData(static_cast<WVR_TrackerId>(trackerId), &size);
+		int32_t *p = Interop->GetTrackerExtendedData(static_cast<WVR_TrackerId>(slot), &size);
 
 		if (size > 0)
 		{
-			if (s_ExtDataSize[trackerId] != size) // different size, re-alloc memory.
-			{
-				s_ExtDataSize[trackerId] = size;
-
-				delete[] s_ExtData[trackerId];
-				s_ExtData[trackerId] = new int32_t[s_ExtDataSize[trackerId]];
-			}
-			for (int i = 0; i < s_ExtDataSize[trackerId]; i++)
-			{
-				s_ExtData[trackerId][i] = *(p + i);
-			}
+			// Only reallocates when the data grows.
+			m_ExtData[slot].SetNumUninitialized(size, false);
+			FMemory::Memcpy(m_ExtData[slot].GetData(), p, size * sizeof(int32_t));
 		}
 		// if size <= 0, do nothing to keep old value.
 	}
 	// if disconnected, do nothing to keep old value.
 
-	/*LOGD(LogWaveVRTrackerImpl, "CheckExtendedData() trackerId %d size %d", (uint8)trackerId, s_ExtDataSize[trackerId]);
-	for (int i = 0; i < s_ExtDataSize[trackerId]; i++)
+	/*LOGD(LogWaveVRTrackerImpl, "CheckExtendedData() tracker %d size %d", slot, m_ExtData[slot].Num());
+	for (int i = 0; i < m_ExtData[slot].Num(); i++)
 	{
-		LOGD(LogWaveVRTrackerImpl, "CheckExtendedData() trackerId %d exData[%d] = %d", (uint8)trackerId, i, s_ExtData[trackerId][i]);
+		LOGD(LogWaveVRTrackerImpl, "CheckExtendedData() tracker %d exData[%d] = %d", slot, i, m_ExtData[slot][i]);
 	}*/
 }
 #pragma endregion Extended Data
@@ -538,48 +571,72 @@ bool WaveVRTrackerImpl::IsTrackerAvailable()
 	return false;
 }
 
+bool WaveVRTrackerImpl::IsTrackerConnected(EWaveVRTrackerId trackerId)
+{
+	return GetStates().Connected[GetTrackerSlot(trackerId)];
+}
+
+EWaveVRTrackerRole WaveVRTrackerImpl::GetTrackerRole(EWaveVRTrackerId trackerId)
+{
+	return GetStates().Roles[GetTrackerSlot(trackerId)];
+}
+
+bool WaveVRTrackerImpl::IsTrackerPoseValid(EWaveVRTrackerId trackerId)
+{
+	return GetStates().ValidPoses[GetTrackerSlot(trackerId)];
+}
 bool WaveVRTrackerImpl::GetTrackerPosition(EWaveVRTrackerId trackerId, FVector& outPosition)
 {
-	if (!IsTrackerPoseValid(trackerId)) { return false; }
+	const FWaveVRTrackerStates& states = GetStates();
+	const int slot = GetTrackerSlot(trackerId);
+	if (!states.ValidPoses[slot]) { return false; }
 
-	outPosition = s_Positions[trackerId];
+	outPosition = states.Positions[slot];
 	return true;
 }
 bool WaveVRTrackerImpl::GetTrackerRotation(EWaveVRTrackerId trackerId, FQuat& outOrientation)
 {
-	if (!IsTrackerPoseValid(trackerId)) { return false; }
+	const FWaveVRTrackerStates& states = GetStates();
+	const int slot = GetTrackerSlot(trackerId);
+	if (!states.ValidPoses[slot]) { return false; }
 
-	outOrientation = s_Orientations[trackerId];
+	outOrientation = states.Orientations[slot];
 	return true;
 }
 
 EWVR_AnalogType WaveVRTrackerImpl::GetTrackerAnalogType(EWaveVRTrackerId trackerId, EWaveVRTrackerButton buttonId)
 {
-	return s_InputAnalogs[trackerId][(uint8)buttonId];
+	const int button = GetButtonSlot(buttonId);
+	if (button == INDEX_NONE) { return EWVR_AnalogType::None; }
+
+	return GetStates().AnalogTypes[GetTrackerSlot(trackerId)][button];
 }
 
 bool WaveVRTrackerImpl::IsTrackerButtonPressed(EWaveVRTrackerId trackerId, EWaveVRTrackerButton buttonId)
 {
-	return s_ButtonPress[trackerId][(uint8)buttonId];
+	return (GetStates().ButtonPress[GetTrackerSlot(trackerId)] & GetButtonMask(buttonId)) != 0;
 }
 bool WaveVRTrackerImpl::IsTrackerButtonTouched(EWaveVRTrackerId trackerId, EWaveVRTrackerButton buttonId)
 {
-	return s_ButtonTouch[trackerId][(uint8)buttonId];
+	return (GetStates().ButtonTouch[GetTrackerSlot(trackerId)] & GetButtonMask(buttonId)) != 0;
 }
 FVector2D WaveVRTrackerImpl::GetTrackerButtonAxis(EWaveVRTrackerId trackerId, EWaveVRTrackerButton buttonId)
 {
-	return s_ButtonAxis[trackerId][(uint8)buttonId];
+	const int button = GetButtonSlot(buttonId);
+	if (button == INDEX_NONE) { return FVector2D::ZeroVector; }
+
+	return GetStates().ButtonAxis[GetTrackerSlot(trackerId)][button];
 }
 
 float WaveVRTrackerImpl::GetTrackerBatteryLife(EWaveVRTrackerId trackerId)
 {
-	return s_BatteryLife[trackerId];
+	return GetStates().BatteryLife[GetTrackerSlot(trackerId)];
 }
 
 bool WaveVRTrackerImpl::TriggerTrackerVibration(EWaveVRTrackerId trackerId, uint32_t durationMicroSec, uint32_t frequency, float amplitude)
 {
 	amplitude = FMath::Clamp<float>(amplitude, 0, 1);
-	if (s_Capabilities[trackerId].supportsHapticVibration)
+	if (s_Capabilities[GetTrackerSlot(trackerId)].supportsHapticVibration)
 	{
 		LOGD(LogWaveVRTrackerImpl, "TriggerTrackerVibration() tracker: %d, durationMicroSec: %d, frequency: %d, amplitude: %f", (uint8)trackerId, durationMicroSec, frequency, amplitude);
 		WVR_Result result = Interop->TriggerTrackerVibration(static_cast<WVR_TrackerId>(trackerId), durationMicroSec, frequency, amplitude);
@@ -590,8 +647,9 @@ bool WaveVRTrackerImpl::TriggerTrackerVibration(EWaveVRTrackerId trackerId, uint
 
 int32_t* WaveVRTrackerImpl::GetTrackerExtendedData(EWaveVRTrackerId trackerId, int32_t *validSize)
 {
-	*validSize = s_ExtDataSize[trackerId];
-	return s_ExtData[trackerId];
+	TArray<int32_t>& extData = m_ExtData[GetTrackerSlot(trackerId)];
+	*validSize = extData.Num();
+	return extData.GetData();
 }
 
 static TMap< WVR_TrackerId, FString > s_CallbackInfo = {
@@ -646,16 +704,4 @@ EWaveVRTrackerId WaveVRTrackerImpl::GetTrackerId(uint8 id)
 
 	return EWaveVRTrackerId::Tracker0;
 }
-
-float WaveVRTrackerImpl::GetWorldToMetersScale()
-{
-	if (IsInGameThread() && GWorld != nullptr)
-	{
-		// For example, One world unit need multiply 100 to become 1 meter.
-		float wtm = GWorld->GetWorldSettings()->WorldToMeters;
-		//LOGI(LogWaveVRHandPose, "GWorld->GetWorldSettings()->WorldToMeters = %f", wtm);
-		return wtm;
-	}
-	return 100.0f;
-}
 #pragma endregion Major Standalone Function
@@ -217,6 +217,15 @@ bool UWaveVRBlueprintFunctionLibrary::GetDevicePose2(FVector& OutPosition, FQuat
 	return device->pose.pose.isValidPose;
 }
 
+bool UWaveVRBlueprintFunctionLibrary::GetDevicePoseAtTimeOffset(FVector& OutPosition, FQuat& OutOrientation, float TimeOffset, EWVR_DeviceType type)
+{
+	if (!IsRegularDevice(type))
+		return false;
+
+	PoseManagerImp* PoseMngr = PoseManagerImp::GetInstance();
+	return PoseMngr->GetDevicePoseAtTime(static_cast<WVR_DeviceType>(type), FPlatformTime::Seconds() + TimeOffset, OutOrientation, OutPosition);
+}
+
 void UWaveVRBlueprintFunctionLibrary::SetPosePredictEnabled(EWVR_DeviceType type, bool enabled_position_predict, bool enabled_rotation_predict)
 {
 	if (!IsRegularDevice(type))
@@ -39,6 +39,14 @@ static TAutoConsoleVariable<int32> CVarEyeTrackingEnable(
 	TEXT("If not support by device, it will be disabled.\n"),
 	ECVF_RenderThreadSafe);
 
+static TAutoConsoleVariable<int32> CVarPoseVerifyMatrix(
+	TEXT("wvr.Pose.verifyMatrix"),
+	/*default value*/ 0,
+	TEXT("1. Check every pose matrix from runtime is a pure rotation before converting it, and log the bad ones.\n")
+	TEXT("0. Disable it.\n")
+	TEXT("This is for develop verify.  It costs time in the late update, keep it off otherwise.\n"),
+	ECVF_RenderThreadSafe);
+
 
 /****************************************************
  *
@@ -0,0 +1,44 @@
+// "WaveVR SDK
+// © 2019 HTC Corporation. All Rights Reserved.
+//
+// Unless otherwise required by copyright law and practice,
+// upon the execution of HTC SDK license agreement,
+// HTC grants you access to and use of the WaveVR SDK(s).
+// You shall fully comply with all of HTC’s SDK license agreement terms and
+// conditions signed by you and all SDK and API requirements,
+// specifications, and documentation provided by HTC to You."
+
+#include "WaveVRDeviceSnapshot.h"
+#include "WaveVRHMD_FrameData.h"
+
+// Hands and trackers only have a ground and a head origin, as EHMDTrackingOrigin::Floor and Eye.
+static WVR_PoseOriginModel GetTrackedOrigin(WVR_PoseOriginModel origin)
+{
+	return (origin == WVR_PoseOriginModel_OriginOnGround) ?
+		WVR_PoseOriginModel_OriginOnGround : WVR_PoseOriginModel_OriginOnHead;
+}
+
+FWaveVRDeviceSnapshot::FWaveVRDeviceSnapshot()
+	: PredictMilliseconds(0)
+	, WorldToMeters(100.0f)
+	, TrackedOrigin(WVR_PoseOriginModel_OriginOnGround)
+{
+}
+
+void FWaveVRDeviceSnapshot::Capture(const FFrameData* frameData, WVR_PoseOriginModel origin)
+{
+	WorldToMeters = frameData->meterToWorldUnit;
+
+	// Only a game thread update asks for a prediction.  Otherwise the poses are the runtime's latest.
+	const bool bPredicted = frameData->bSupportLateUpdate && frameData->bDoUpdateInGT;
+	PredictMilliseconds = bPredicted ? static_cast<uint32>(frameData->predictTimeInGT) : 0;
+
+	TrackedOrigin = GetTrackedOrigin(origin);
+}
+
+void FWaveVRDeviceSnapshot::CaptureWithoutPoses(WVR_PoseOriginModel origin, float worldToMeters)
+{
+	WorldToMeters = worldToMeters;
+	PredictMilliseconds = 0;
+	TrackedOrigin = GetTrackedOrigin(origin);
+}
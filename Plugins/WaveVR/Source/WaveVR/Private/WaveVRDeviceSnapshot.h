@@ -0,0 +1,38 @@
+// "WaveVR SDK
+// © 2019 HTC Corporation. All Rights Reserved.
+//
+// Unless otherwise required by copyright law and practice,
+// upon the execution of HTC SDK license agreement,
+// HTC grants you access to and use of the WaveVR SDK(s).
+// You shall fully comply with all of HTC’s SDK license agreement terms and
+// conditions signed by you and all SDK and API requirements,
+// specifications, and documentation provided by HTC to You."
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "wvr.h"
+
+class FFrameData;
+
+/**
+ * What every device consumer reads in a game frame.
+ *
+ * PoseManagerImp captures it once per game frame, right after the HMD and controller poses are updated, and
+ * FWaveVRHMD passes it to the hand, tracker and eye ticks.  Those use its origin, prediction and scale for their
+ * own runtime queries instead of looking them up again.  Tracker poses are requested with its prediction, so they
+ * line up with the HMD.  Hand and eye data are not part of it; their ticks still read the runtime's latest sample.
+ *
+ * Frames that fetch no poses, before rendering starts for example, still capture the origin and scale.
+ */
+struct FWaveVRDeviceSnapshot
+{
+	uint32 PredictMilliseconds;  // How far ahead the HMD poses are predicted.  0 means the runtime's current pose.
+	float WorldToMeters;
+	WVR_PoseOriginModel TrackedOrigin;  // Origin for 6DoF hand and tracker queries.  Ground or head.
+
+	FWaveVRDeviceSnapshot();
+
+	void Capture(const FFrameData* frameData, WVR_PoseOriginModel origin);
+	void CaptureWithoutPoses(WVR_PoseOriginModel origin, float worldToMeters);
+};
@@ -36,6 +36,7 @@
 #include "WaveVREventCommon.h"
 #include "WaveVRSplash.h"
 #include "WaveVRRender.h"
+#include "FWaveVRServiceThread.h"
 #include "Platforms/WaveVRAPIWrapper.h"
 #include "Platforms/Windows/WaveVRPlatformWindows.h"
 #include "Platforms/Android/WaveVRPlatformAndroid.h"
@@ -148,6 +149,8 @@ public:
 	{
 		LOGI(WVRHMD, "ShutdownModule()");
 		IHeadMountedDisplayModule::ShutdownModule();
+		// Finish the pending start and stop calls before the runtime library goes away.
+		FWaveVRServiceThread::Shutdown();
 		auto PlatFormContext = WVR();
 		if (PlatFormContext != nullptr) {
 			PlatFormContext->UnLoadLibraries();
@@ -442,14 +445,17 @@ void FWaveVRHMD::OnEndPlay(FWorldContext& InWorldContext)
 void FWaveVRHMD::NextFrameData() {
 	// swap data
 	OldFrameData = FrameData;
-	FrameData = FFrameData::NewInstance();
+	FrameData = (OldFrameData == &GameFrameData[0]) ? &GameFrameData[1] : &GameFrameData[0];
 
 	// If position is invalidate, we need the old pose.  Use latest pose in RT.
-	FFrameData::Copy(OldFrameDataRT, FrameData);
+	FrameDataRing.CopyOldRT(FrameData);
 
 	FrameData->bSupportLateUpdate = FrameData->bNeedLateUpdateInRT = lateUpdateConfig.bEnabled;
 	FrameData->bDoUpdateInGT = lateUpdateConfig.bDoUpdateInGT;
 	FrameData->predictTimeInGT = lateUpdateConfig.predictTimeInGT;
+	// predictTimeInGT is the app's estimate of the game thread to display latency.  The runtime predicts the
+	// late update and GetSyncPose poses to the same display, so every path stamps its poses with this time.
+	FrameData->poseTime = FPlatformTime::Seconds() + FrameData->predictTimeInGT / 1000.0;
 	FrameData->frameNumber = GFrameNumber;
 	FrameData->meterToWorldUnit = GetWorldToMetersScale();  // For example, 1 meter multiply 100 to convert to world units.
 	FrameData->Origin = PoseMngr->GetTrackingOriginModelInternal();
@@ -472,6 +478,10 @@ bool FWaveVRHMD::OnStartGameFrame(FWorldContext& WorldContext)
 #endif
 		NextFrameData();
 		PoseMngr->UpdatePoses(FrameData);
+		PoseMngr->CaptureSnapshot(FrameData);
+	} else {
+		// No poses this frame, but hands, eyes and trackers below still need this frame's origin and scale.
+		PoseMngr->CaptureSnapshotWithoutPoses(GetWorldToMetersScale());
 	}
 
 	if (!AppliedAdaptiveQualityProjectSettings && IsRenderInitialized()) {
@@ -485,12 +495,15 @@ bool FWaveVRHMD::OnStartGameFrame(FWorldContext& WorldContext)
 	CheckSystemFocus();
 	if (pSimulator)
 		pSimulator->TickData();
+
+	// Hands, eyes and trackers follow the origin and the prediction of this frame's HMD pose.
+	const FWaveVRDeviceSnapshot& Snapshot = PoseMngr->GetSnapshot();
 	if (pHandPose)
-		pHandPose->TickHandData();
+		pHandPose->TickHandData(Snapshot);
 	if (pEyeManager)
-		pEyeManager->TickEyeData();
+		pEyeManager->TickEyeData(Snapshot);
 	if (pTracker)
-		pTracker->TickTrackerData();
+		pTracker->TickTrackerData(Snapshot);
 	if (pLipExp)
 		pLipExp->TickLipExpData();
 	if (pEyeExp)
@@ -532,15 +545,20 @@ bool FWaveVRHMD::OnEndGameFrame(FWorldContext& WorldContext)
 	LOG_FUNC();
 	//LOGD(WVRHMD, "OnEndGameFrame");
 
-	FrameDataPtr FrameDataCopy = FFrameData::NewInstance();
-	FFrameData::Copy(FrameData, FrameDataCopy);
+	// The render thread is never this far behind unless frames are queued without a frame sync.
+	if (!FrameDataRing.HasFreeSlot()) {
+		LOGW(WVRHMD, "No free FrameData slot, flush rendering commands.");
+		FlushRenderingCommands();
+	}
 
 	// Send a copy of FrameData to render thread.
-	ExecuteOnRenderThread_DoNotWait([this, FrameDataCopy](FRHICommandListImmediate& RHICmdList)
+	const uint32 FrameDataSlot = FrameDataRing.Publish(FrameData);
+	ExecuteOnRenderThread_DoNotWait([this, FrameDataSlot](FRHICommandListImmediate& RHICmdList)
 	{
 		WVR_SCOPED_NAMED_EVENT(CopyFrameDataToRT, FColor::Purple);
-		OldFrameDataRT = FrameDataRT;
-		FrameDataRT = FrameDataCopy;
+		FrameDataRing.Consume(FrameDataSlot);
+		OldFrameDataRT = FrameDataRing.GetOldRT();
+		FrameDataRT = FrameDataRing.GetRT();
 	}
 	);
 
@@ -1577,10 +1595,10 @@ bool FWaveVRHMD::Startup()
 {
 	LOG_FUNC();
 
-	FrameData = FFrameData::NewInstance();
-	FrameDataRT = FFrameData::NewInstance();
-	OldFrameData = FFrameData::NewInstance();
-	OldFrameDataRT = FFrameData::NewInstance();
+	FrameData = &GameFrameData[0];
+	FrameDataRT = FrameDataRing.GetRT();
+	OldFrameData = &GameFrameData[1];
+	OldFrameDataRT = FrameDataRing.GetOldRT();
 
 	// load WaveVR project settings from ini
 	ApplyCVarSettingsFromIni(TEXT("/Script/WaveVREditor.WaveVRSettings"), *GEngineIni, ECVF_SetByProjectSetting);
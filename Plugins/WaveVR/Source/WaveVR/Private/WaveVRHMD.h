@@ -363,6 +363,9 @@ public:
 private:
 	void NextFrameData();
 
+	FFrameData GameFrameData[2];  // FrameData and OldFrameData point here, swapped every frame.
+	FFrameDataRing FrameDataRing;  // FrameDataRT and OldFrameDataRT point here.
+
 public:
 	static void SetARSystem(TSharedPtr<IARSystemSupport, ESPMode::ThreadSafe> InArSystem) { ArSystem = InArSystem; }
 	static TSharedPtr<IARSystemSupport, ESPMode::ThreadSafe> GetARSystem() { return ArSystem; }
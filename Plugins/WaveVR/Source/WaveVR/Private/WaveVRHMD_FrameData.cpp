@@ -36,32 +36,59 @@ void FFramePoses::Reset()
 void FFramePoses::ConvertWVRPosesToUnrealPoses(float meterToWorldUnit) {
 	// Because the index of wvrPoses may not follow type order.
 	// Sort index in the type order of HMD, Left, Right.
-	for (uint32_t i = 0; i < /*DeviceTypes.Length*/WVR_DEVICE_COUNT_LEVEL_1; i++)
-	{
-		bool hasType = false;
+	bool reachedEnd = false;
+	for (int i = 0; i < WVR_DEVICE_COUNT_LEVEL_1; i++)
 		deviceIndexMap[i] = -1;
 
-		for (uint32_t j = 0; j < /*poses.Length*/WVR_DEVICE_COUNT_LEVEL_1; j++)
-		{
-			const WVR_DevicePosePair_t& wvrPose = wvrPoses[j];
+	for (int j = 0; j < /*poses.Length*/WVR_DEVICE_COUNT_LEVEL_1; j++)
+	{
+		const WVR_DeviceType type = wvrPoses[j].type;
+		if (type == WVR_DeviceType_Invalid || type == 100) { //[WVR] has type id 100 if Device disconnected.
+			reachedEnd = true;
+			break;
+		}
 
-			if (wvrPose.type == PoseManagerImp::DeviceTypes[i])
+		for (int i = 0; i < /*DeviceTypes.Length*/WVR_DEVICE_COUNT_LEVEL_1; i++)
+		{
+			if (type == PoseManagerImp::DeviceTypes[i] && deviceIndexMap[i] < 0)
 			{
-				hasType = true;
 				deviceIndexMap[i] = j;
-
-				if (wvrPose.pose.isValidPose)
-					WaveVRUtils::ConvertWVRMatrixToUnrealPose(wvrPose.pose.poseMatrix, meterToWorldUnit, DeviceOrientation[i], DevicePosition[i]);
-				break;
-			}
-			else if (wvrPose.type == WVR_DeviceType_Invalid || wvrPose.type == 100) { //[WVR] has type id 100 if Device disconnected.
-				hasType = true;
 				break;
 			}
 		}
+	}
+
+	// Convert all the valid poses in one batch.
+	const WVR_Matrix4f_t* matrices[WVR_DEVICE_COUNT_LEVEL_1];
+	FQuat orientations[WVR_DEVICE_COUNT_LEVEL_1];
+	FVector positions[WVR_DEVICE_COUNT_LEVEL_1];
+	int devices[WVR_DEVICE_COUNT_LEVEL_1];
+	int count = 0;
+
+	for (int i = 0; i < WVR_DEVICE_COUNT_LEVEL_1; i++)
+	{
+		const int j = deviceIndexMap[i];
+		if (j < 0)
+		{
 //#if DEBUG
-		if (!hasType) LOGD(WVRFrameData, "This pose belongs to no supported type");
+			if (!reachedEnd) LOGD(WVRFrameData, "This pose belongs to no supported type");
 //#endif
+			continue;
+		}
+		if (!wvrPoses[j].pose.isValidPose)
+			continue;
+
+		matrices[count] = &wvrPoses[j].pose.poseMatrix;
+		devices[count] = i;
+		count++;
+	}
+
+	WaveVRUtils::ConvertWVRMatricesToUnrealPoses(matrices, count, meterToWorldUnit, orientations, positions);
+
+	for (int k = 0; k < count; k++)
+	{
+		DeviceOrientation[devices[k]] = orientations[k];
+		DevicePosition[devices[k]] = positions[k];
 	}
 }
 
@@ -75,16 +102,13 @@ FFrameData::FFrameData()
 	, bNeedLateUpdateInRT(true)
 	, bDoUpdateInGT(false)
 	, predictTimeInGT(0.0f)
+	, poseTime(0)
 	, Origin(WVR_PoseOriginModel_OriginOnHead)
 	, poses()
 {
 }
 
-FrameDataPtr FFrameData::NewInstance() {
-	return MakeShareable(new FFrameData());
-}
-
-void FFrameData::DebugLogFrameData(const TSharedPtr<FFrameData, ESPMode::ThreadSafe>& frameData, const char* name) {
+void FFrameData::DebugLogFrameData(const FFrameData* frameData, const char* name) {
 	LOGD(WVRFrameData,
 		"FrameData: %s\n"
 		"frameNumber=%d, bNeedLateUpdateInRT=%d, meterToWorldUnit=%f, Origin=%d\n"
@@ -96,6 +120,46 @@ void FFrameData::DebugLogFrameData(const TSharedPtr<FFrameData, ESPMode::ThreadS
 	);
 }
 
-void FFrameData::Copy(const TSharedPtr<FFrameData, ESPMode::ThreadSafe>& from, TSharedPtr<FFrameData, ESPMode::ThreadSafe>& to) {
+void FFrameData::Copy(const FFrameData* from, FFrameData* to) {
 	*to = *from;
 }
+
+
+FFrameDataRing::FFrameDataRing()
+	// Slot 0 starts as the old and slot 1 as the current render thread frame.
+	: PublishCount(2)
+	, ConsumeCount(2)
+{
+}
+
+bool FFrameDataRing::HasFreeSlot() const {
+	// The render thread still holds the current, the old and every published but not consumed slot.
+	return PublishCount - ConsumeCount.Load() + 2 < Capacity;
+}
+
+uint32 FFrameDataRing::Publish(const FFrameData* frame) {
+	check(IsInGameThread());
+	const uint32 slot = PublishCount % Capacity;
+	FFrameData::Copy(frame, &Slots[slot]);
+	PublishCount++;
+	return slot;
+}
+
+void FFrameDataRing::CopyOldRT(FFrameData* to) const {
+	// The render thread never writes the old slot, and the game thread is the only one reusing slots.
+	FFrameData::Copy(&Slots[(ConsumeCount.Load() - 2) % Capacity], to);
+}
+
+void FFrameDataRing::Consume(uint32 slot) {
+	const uint32 count = ConsumeCount.Load();
+	ensure(slot == count % Capacity);
+	ConsumeCount.Store(count + 1);
+}
+
+FrameDataPtr FFrameDataRing::GetRT() {
+	return &Slots[(ConsumeCount.Load() - 1) % Capacity];
+}
+
+FrameDataPtr FFrameDataRing::GetOldRT() {
+	return &Slots[(ConsumeCount.Load() - 2) % Capacity];
+}
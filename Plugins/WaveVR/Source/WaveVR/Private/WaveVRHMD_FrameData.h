@@ -11,6 +11,7 @@
 #pragma once
 
 #include "CoreMinimal.h"
+#include "Templates/Atomic.h"
 #include "Platforms/WaveVRAPIWrapper.h"
 
 class FFramePoses
@@ -29,7 +30,7 @@ public:
 	FQuat DeviceOrientation[WVR_DEVICE_COUNT_LEVEL_1];  // In Unreal world space.  Index is follow PoseManagerImp::DeviceTypes.
 };
 
-class FFrameData : public TSharedFromThis<FFrameData, ESPMode::ThreadSafe>
+class FFrameData
 {
 public:
 	uint32 frameNumber;  // copy from GFrameNumber
@@ -43,6 +44,7 @@ public:
 	bool bNeedLateUpdateInRT;
 	bool bDoUpdateInGT;
 	float predictTimeInGT;
+	double poseTime;  // FPlatformTime::Seconds() of the display this frame's poses are for, whichever path fetched them.
 
 	WVR_PoseOriginModel Origin;
 
@@ -53,10 +55,41 @@ public:
 
 public:
 
-	static void DebugLogFrameData(const TSharedPtr<FFrameData, ESPMode::ThreadSafe>& frameData, const char* name);
-	static TSharedPtr<FFrameData, ESPMode::ThreadSafe> NewInstance();
-	static void Copy(const TSharedPtr<FFrameData, ESPMode::ThreadSafe>& from, TSharedPtr<FFrameData, ESPMode::ThreadSafe>& to);
+	static void DebugLogFrameData(const FFrameData* frameData, const char* name);
+	static void Copy(const FFrameData* from, FFrameData* to);
 };
 
-typedef TSharedPtr<FFrameData, ESPMode::ThreadSafe> FrameDataPtr;
+typedef FFrameData* FrameDataPtr;
+
+/**
+ * Preallocated FFrameData slots handed from the game thread to the render thread.
+ *
+ * The game thread copies its frame into the next free slot at the end of the frame and sends the slot
+ * index with the render command.  The render thread makes that slot current and keeps the previous one
+ * as old.  Late update writes only the current slot, and the game thread reads only the old one, so the
+ * handoff needs no heap allocation, no refcount and no lock.
+ *
+ * Slots are used in order.  One is free as long as the render thread is less than Capacity - 2 frames behind.
+ */
+class FFrameDataRing
+{
+public:
+	static constexpr uint32 Capacity = 8;
+
+	FFrameDataRing();
 
+	// Game thread
+	bool HasFreeSlot() const;
+	uint32 Publish(const FFrameData* frame);
+	void CopyOldRT(FFrameData* to) const;
+
+	// Render thread
+	void Consume(uint32 slot);
+	FrameDataPtr GetRT();
+	FrameDataPtr GetOldRT();
+
+private:
+	FFrameData Slots[Capacity];
+	uint32 PublishCount;  // Only touched by the game thread.
+	TAtomic<uint32> ConsumeCount;  // Written by the render thread, read by the game thread.
+};
@@ -0,0 +1,147 @@
+// "WaveVR SDK
+// © 2019 HTC Corporation. All Rights Reserved.
+//
+// Unless otherwise required by copyright law and practice,
+// upon the execution of HTC SDK license agreement,
+// HTC grants you access to and use of the WaveVR SDK(s).
+// You shall fully comply with all of HTC’s SDK license agreement terms and
+// conditions signed by you and all SDK and API requirements,
+// specifications, and documentation provided by HTC to You."
+
+#include "WaveVRPoseHistory.h"
+#include "WaveVRUtils.h"
+
+using namespace wvr::utils;
+
+FWaveVRPoseSample::FWaveVRPoseSample()
+	: Time(0)
+	, Orientation(FQuat::Identity)
+	, Position(FVector::ZeroVector)
+	, LinearVelocity(FVector::ZeroVector)
+	, AngularVelocity(FVector::ZeroVector)
+{
+}
+
+FWaveVRPoseSample FWaveVRPoseSample::FromWVRPose(const WVR_PoseState_t& pose, const FQuat& orientation, const FVector& position, float meterToWorldUnit, double time)
+{
+	FWaveVRPoseSample sample;
+	sample.Time = time;
+	sample.Orientation = orientation;
+	sample.Position = position;
+	sample.LinearVelocity = FromGLToUnreal(pose.velocity, meterToWorldUnit);
+	// The GL to Unreal axis swap flips handedness, so the axial angular velocity changes sign.
+	sample.AngularVelocity = -FromGLToUnreal(pose.angularVelocity, 1);
+	return sample;
+}
+
+FWaveVRPoseHistory::FWaveVRPoseHistory()
+	: WriteCount(0)
+{
+	Reset();
+}
+
+void FWaveVRPoseHistory::Reset()
+{
+	for (FSlot& slot : Slots)
+		slot.Sequence.Store(0);
+}
+
+void FWaveVRPoseHistory::Push(const FWaveVRPoseSample& sample)
+{
+	const uint32 n = WriteCount.IncrementExchange();
+	FSlot& slot = Slots[n % Capacity];
+
+	slot.Sequence.Store(2 * n + 1);
+	FPlatformMisc::MemoryBarrier();
+	slot.Sample = sample;
+	FPlatformMisc::MemoryBarrier();
+	slot.Sequence.Store(2 * n + 2);
+}
+
+int32 FWaveVRPoseHistory::Snapshot(FWaveVRPoseSample (&OutSamples)[Capacity]) const
+{
+	int32 count = 0;
+	for (const FSlot& slot : Slots)
+	{
+		const uint32 before = slot.Sequence.Load();
+		if (before == 0 || (before & 1) != 0)
+			continue;  // Never written, or being written.
+
+		OutSamples[count] = slot.Sample;
+		FPlatformMisc::MemoryBarrier();
+
+		if (slot.Sequence.Load() == before)
+			count++;
+	}
+	return count;
+}
+
+bool FWaveVRPoseHistory::GetLatest(FWaveVRPoseSample& OutSample) const
+{
+	FWaveVRPoseSample samples[Capacity];
+	const int32 count = Snapshot(samples);
+
+	int32 latest = -1;
+	for (int32 i = 0; i < count; i++)
+	{
+		if (latest < 0 || samples[i].Time > samples[latest].Time)
+			latest = i;
+	}
+
+	if (latest < 0)
+		return false;
+
+	OutSample = samples[latest];
+	return true;
+}
+
+bool FWaveVRPoseHistory::SamplePose(double time, FQuat& OutOrientation, FVector& OutPosition) const
+{
+	FWaveVRPoseSample samples[Capacity];
+	const int32 count = Snapshot(samples);
+
+	// The game thread and the render thread push in their own order, so search instead of assuming sorted slots.
+	int32 before = -1, after = -1, oldest = -1;
+	for (int32 i = 0; i < count; i++)
+	{
+		const double t = samples[i].Time;
+		if (t <= time && (before < 0 || t > samples[before].Time))
+			before = i;
+		if (t >= time && (after < 0 || t < samples[after].Time))
+			after = i;
+		if (oldest < 0 || t < samples[oldest].Time)
+			oldest = i;
+	}
+
+	if (before >= 0 && after >= 0)
+	{
+		const FWaveVRPoseSample& a = samples[before];
+		const FWaveVRPoseSample& b = samples[after];
+		const double span = b.Time - a.Time;
+		const float alpha = span > 0 ? static_cast<float>((time - a.Time) / span) : 0.0f;
+		OutOrientation = FQuat::Slerp(a.Orientation, b.Orientation, alpha);
+		OutPosition = FMath::Lerp(a.Position, b.Position, alpha);
+		return true;
+	}
+
+	if (before >= 0)
+	{
+		// Newer than every pose, extrapolate with constant velocity.
+		const FWaveVRPoseSample& a = samples[before];
+		const float dt = static_cast<float>(FMath::Min(time - a.Time, MaxExtrapolation));
+		const float angle = a.AngularVelocity.Size() * dt;
+		const FQuat delta = angle > KINDA_SMALL_NUMBER ? FQuat(a.AngularVelocity.GetUnsafeNormal(), angle) : FQuat::Identity;
+		OutOrientation = (delta * a.Orientation).GetNormalized();
+		OutPosition = a.Position + a.LinearVelocity * dt;
+		return true;
+	}
+
+	if (oldest >= 0)
+	{
+		OutOrientation = samples[oldest].Orientation;
+		OutPosition = samples[oldest].Position;
+		return true;
+	}
+
+	return false;
+}
@@ -0,0 +1,70 @@
+// "WaveVR SDK
+// © 2019 HTC Corporation. All Rights Reserved.
+//
+// Unless otherwise required by copyright law and practice,
+// upon the execution of HTC SDK license agreement,
+// HTC grants you access to and use of the WaveVR SDK(s).
+// You shall fully comply with all of HTC’s SDK license agreement terms and
+// conditions signed by you and all SDK and API requirements,
+// specifications, and documentation provided by HTC to You."
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Templates/Atomic.h"
+#include "wvr.h"
+
+// One device pose in Unreal tracking space.
+struct FWaveVRPoseSample
+{
+	double Time;  // FPlatformTime::Seconds() of the display the pose is predicted for.
+	FQuat Orientation;
+	FVector Position;
+	FVector LinearVelocity;  // Unreal units per second
+	FVector AngularVelocity;  // Radians per second, Unreal axes
+
+	FWaveVRPoseSample();
+
+	// Converts a runtime pose.  Orientation and Position are already converted by FFramePoses.
+	static FWaveVRPoseSample FromWVRPose(const WVR_PoseState_t& pose, const FQuat& orientation, const FVector& position, float meterToWorldUnit, double time);
+};
+
+/**
+ * Timestamped poses of one device.
+ *
+ * Push() may be called from the game thread and the render thread at the same time.  Writers claim slots
+ * with one atomic increment and every slot carries a sequence number, so readers on any thread can copy
+ * samples without a lock and skip the ones being overwritten.
+ */
+class FWaveVRPoseHistory
+{
+public:
+	static constexpr uint32 Capacity = 64;
+
+	// Sampling past the newest pose extrapolates with its velocity for at most this long.
+	static constexpr double MaxExtrapolation = 0.1;
+
+	FWaveVRPoseHistory();
+
+	void Push(const FWaveVRPoseSample& sample);
+	void Reset();
+
+	// Interpolates between the two poses around time, or extrapolates the newest one with constant velocity.
+	// Times older than the history return the oldest pose.  Returns false if there is no pose yet.
+	bool SamplePose(double time, FQuat& OutOrientation, FVector& OutPosition) const;
+
+	bool GetLatest(FWaveVRPoseSample& OutSample) const;
+
+	// Copies the valid samples in no particular order.  Returns the count.
+	int32 Snapshot(FWaveVRPoseSample (&OutSamples)[Capacity]) const;
+
+private:
+	struct FSlot
+	{
+		TAtomic<uint32> Sequence;  // 2n + 1 while sample n is written, 2n + 2 once it is complete.
+		FWaveVRPoseSample Sample;
+	};
+
+	FSlot Slots[Capacity];
+	TAtomic<uint32> WriteCount;
+};
@@ -10,6 +10,7 @@
 
 #include "WaveVRUtils.h"
 #include "Platforms/WaveVRLogWrapper.h"
+#include "HAL/IConsoleManager.h"
 
 DEFINE_LOG_CATEGORY_STATIC(WVRUtils, Display, All);
 
@@ -102,9 +103,8 @@ void WaveVRUtils::ConvertWVRMatrixToUnrealPose(const WVR_Matrix4f_t& InPoseMatri
 	FVector position = FVector(Pose.M[3][0], Pose.M[3][1], Pose.M[3][2]) * meterToWorldUnit;
 #endif
 
-#if 1 //!UE_BUILD_SHIPPING //Do not verify for performance purpose.
-	VerifyMatrixQuality(InPoseMatrix);
-#endif
+	if (IsMatrixVerifyEnabled())
+		VerifyMatrixQuality(InPoseMatrix);
 	WVR_Quatf Quat = MatrixToQuat(InPoseMatrix);
 
 	// GL space to Unreal space
@@ -121,6 +121,116 @@ void WaveVRUtils::ConvertWVRMatrixToUnrealPose(const WVR_Matrix4f_t& InPoseMatri
 	OutPosition = CoordinateUtil::GetVector3(position, meterToWorldUnit);
 }
 
+bool WaveVRUtils::IsMatrixVerifyEnabled() {
+	static const auto CVarVerifyMatrix = IConsoleManager::Get().FindTConsoleVariableDataInt(TEXT("wvr.Pose.verifyMatrix"));
+	return CVarVerifyMatrix && CVarVerifyMatrix->GetValueOnAnyThread() != 0;
+}
+
+// Select(a, A, Select(b, B, C)).  The masks are tested in the same order as the branches in MatrixToQuat.
+static FORCEINLINE VectorRegister SelectInOrder(const VectorRegister& MaskA, const VectorRegister& A, const VectorRegister& MaskB, const VectorRegister& B, const VectorRegister& MaskC, const VectorRegister& C, const VectorRegister& D) {
+	return VectorSelect(MaskA, A, VectorSelect(MaskB, B, VectorSelect(MaskC, C, D)));
+}
+
+void WaveVRUtils::ConvertWVRMatricesToUnrealPoses(const WVR_Matrix4f_t* const* InPoseMatrices, int32 Count, float meterToWorldUnit, FQuat* OutOrientations, FVector* OutPositions) {
+	if (IsMatrixVerifyEnabled()) {
+		for (int32 i = 0; i < Count; i++)
+			VerifyMatrixQuality(*InPoseMatrices[i]);
+	}
+
+	const VectorRegister Half = VectorSetFloat1(0.5f);
+	const VectorRegister One = VectorOne();
+	const VectorRegister Zero = VectorZero();
+	const VectorRegister Tiny = VectorSetFloat1(SMALL_NUMBER);
+
+	// One lane per matrix.
+	MS_ALIGN(16) float m[3][3][4] GCC_ALIGN(16);
+	MS_ALIGN(16) float q[4][4] GCC_ALIGN(16);
+
+	for (int32 base = 0; base < Count; base += 4) {
+		const int32 lanes = FMath::Min(4, Count - base);
+		for (int32 lane = 0; lane < 4; lane++) {
+			// The unused lanes of the last group repeat its first matrix and are not written out.
+			const WVR_Matrix4f_t& mx = *InPoseMatrices[base + (lane < lanes ? lane : 0)];
+			for (int32 r = 0; r < 3; r++)
+				for (int32 c = 0; c < 3; c++)
+					m[r][c][lane] = mx.m[r][c];
+		}
+
+		const VectorRegister m00 = VectorLoadAligned(m[0][0]), m01 = VectorLoadAligned(m[0][1]), m02 = VectorLoadAligned(m[0][2]);
+		const VectorRegister m10 = VectorLoadAligned(m[1][0]), m11 = VectorLoadAligned(m[1][1]), m12 = VectorLoadAligned(m[1][2]);
+		const VectorRegister m20 = VectorLoadAligned(m[2][0]), m21 = VectorLoadAligned(m[2][1]), m22 = VectorLoadAligned(m[2][2]);
+
+		// The branch MatrixToQuat would take: trace > 0, else the largest diagonal element.
+		const VectorRegister trace = VectorAdd(VectorAdd(m00, m11), m22);
+		const VectorRegister useW = VectorCompareGT(trace, Zero);
+		const VectorRegister useX = VectorBitwiseAnd(VectorCompareGT(m00, m11), VectorCompareGT(m00, m22));
+		const VectorRegister useY = VectorCompareGT(m11, m22);
+
+		// 1 + the diagonal of the chosen component, with the signs of MatrixToQuat.
+		const VectorRegister tW = VectorAdd(One, trace);
+		const VectorRegister tX = VectorAdd(One, VectorSubtract(VectorSubtract(m00, m11), m22));
+		const VectorRegister tY = VectorAdd(One, VectorSubtract(VectorSubtract(m11, m00), m22));
+		const VectorRegister tZ = VectorAdd(One, VectorSubtract(VectorSubtract(m22, m00), m11));
+		const VectorRegister t = SelectInOrder(useW, tW, useX, tX, useY, tY, tZ);
+
+		// The chosen component is 0.5 * sqrt(t) = t * s, the others are their numerator * s.
+		const VectorRegister s = VectorMultiply(Half, VectorReciprocalSqrtAccurate(VectorMax(t, Tiny)));
+
+		const VectorRegister a = VectorSubtract(m21, m12);
+		const VectorRegister b = VectorSubtract(m02, m20);
+		const VectorRegister c = VectorSubtract(m10, m01);
+		const VectorRegister d = VectorAdd(m01, m10);
+		const VectorRegister e = VectorAdd(m02, m20);
+		const VectorRegister f = VectorAdd(m12, m21);
+
+		const VectorRegister qw = VectorMultiply(s, SelectInOrder(useW, t, useX, a, useY, b, c));
+		const VectorRegister qx = VectorMultiply(s, SelectInOrder(useW, a, useX, t, useY, d, e));
+		const VectorRegister qy = VectorMultiply(s, SelectInOrder(useW, b, useX, d, useY, t, f));
+		const VectorRegister qz = VectorMultiply(s, SelectInOrder(useW, c, useX, e, useY, f, t));
+
+		const VectorRegister lengthSquared = VectorMultiplyAdd(qw, qw, VectorMultiplyAdd(qx, qx, VectorMultiplyAdd(qy, qy, VectorMultiply(qz, qz))));
+		const VectorRegister invLength = VectorReciprocalSqrtAccurate(VectorMax(lengthSquared, Tiny));
+		VectorStoreAligned(VectorMultiply(qw, invLength), q[0]);
+		VectorStoreAligned(VectorMultiply(qx, invLength), q[1]);
+		VectorStoreAligned(VectorMultiply(qy, invLength), q[2]);
+		VectorStoreAligned(VectorMultiply(qz, invLength), q[3]);
+
+		for (int32 lane = 0; lane < lanes; lane++) {
+			const WVR_Matrix4f_t& mx = *InPoseMatrices[base + lane];
+
+			// GL space to Unreal space
+			OutOrientations[base + lane] = FQuat(-q[3][lane], q[1][lane], q[2][lane], -q[0][lane]);
+			OutPositions[base + lane] = FVector(-mx.m[2][3] * meterToWorldUnit, mx.m[0][3] * meterToWorldUnit, mx.m[1][3] * meterToWorldUnit);
+		}
+	}
+}
+
+void WaveVRUtils::ConvertWVRHandJointsToUnrealPoses(const WVR_HandTrackerInfo_t& InInfo, const WVR_HandTrackingData_t& InData, float meterToWorldUnit,
+	TArray<FVector>& OutPositionsLeft, TArray<FQuat>& OutRotationsLeft, TArray<FVector>& OutPositionsRight, TArray<FQuat>& OutRotationsRight) {
+	const uint64_t positionValid = (uint64_t)WVR_HandJointValidFlag::WVR_HandJointValidFlag_PositionValid;
+	const uint64_t rotationValid = (uint64_t)WVR_HandJointValidFlag::WVR_HandJointValidFlag_RotationValid;
+
+	for (uint32_t i = 0; i < InInfo.jointCount; i++) {
+		const uint64_t flags = InInfo.jointValidFlagArray[i];
+		const int32 joint = (uint8)InInfo.jointMappingArray[i];
+		if (!OutPositionsLeft.IsValidIndex(joint) || !OutPositionsRight.IsValidIndex(joint) ||
+			!OutRotationsLeft.IsValidIndex(joint) || !OutRotationsRight.IsValidIndex(joint))
+			continue;
+
+		const WVR_Pose_t& left = InData.left.joints[i];
+		const WVR_Pose_t& right = InData.right.joints[i];
+
+		if ((flags & positionValid) != 0) {
+			OutPositionsLeft[joint] = FromGLToUnreal(left.position, meterToWorldUnit);
+			OutPositionsRight[joint] = FromGLToUnreal(right.position, meterToWorldUnit);
+		}
+		if ((flags & rotationValid) != 0) {
+			OutRotationsLeft[joint] = FQuat(-left.rotation.z, left.rotation.x, left.rotation.y, -left.rotation.w);
+			OutRotationsRight[joint] = FQuat(-right.rotation.z, right.rotation.x, right.rotation.y, -right.rotation.w);
+		}
+	}
+}
+
 void WaveVRUtils::CoordinatTransform(const WVR_Matrix4f_t& InPoseMatrix, FQuat& OutOrientation, FVector& OutPosition) {
 	ConvertWVRMatrixToUnrealPose(InPoseMatrix, 1, OutOrientation, OutPosition);
 }
@@ -124,6 +124,16 @@ namespace wvr {
 			static void ConvertWVRPosePairToUnrealPose(const WVR_DevicePosePair_t& InPose, float meterToWorldUnit, FQuat& OutOrientation, FVector& OutPosition);
 			static void ConvertWVRMatrixToUnrealPose(const WVR_Matrix4f_t& InPoseMatrix, float meterToWorldUnit, FQuat& OutOrientation, FVector& OutPosition);
 
+			// Same result as ConvertWVRMatrixToUnrealPose for every matrix, but four matrices are converted at a time without branches.
+			static void ConvertWVRMatricesToUnrealPoses(const WVR_Matrix4f_t* const* InPoseMatrices, int32 Count, float meterToWorldUnit, FQuat* OutOrientations, FVector* OutPositions);
+
+			// Hand joints are already position and rotation.  Converts all the valid joints of both hands in one pass, and writes them to the joint index in jointMappingArray.
+			static void ConvertWVRHandJointsToUnrealPoses(const WVR_HandTrackerInfo_t& InInfo, const WVR_HandTrackingData_t& InData, float meterToWorldUnit,
+				TArray<FVector>& OutPositionsLeft, TArray<FQuat>& OutRotationsLeft, TArray<FVector>& OutPositionsRight, TArray<FQuat>& OutRotationsRight);
+
+			// Verify the pose matrix when the console variable wvr.Pose.verifyMatrix is set.
+			static bool IsMatrixVerifyEnabled();
+
 			static void CoordinatTransform(const WVR_Matrix4f_t& InPoseMatrix, FQuat& OutOrientation, FVector& OutPosition);
 			static void CoordinateTransform(const WVR_Matrix4f_t& InPoseMatrix, float meterToWorldUnit, FQuat& OutOrientation, FVector& OutPosition);
 
@@ -11,22 +11,14 @@
 #pragma once
 
 #include "CoreMinimal.h"
-#include "HAL/Runnable.h"
-#include "Containers/Queue.h"
 
 #include "WaveVREyeEnums.h"
 
-class WAVEVR_API FWaveVREyeRunnable : public FRunnable
+class WAVEVR_API FWaveVREyeRunnable
 {
-	/** Singleton instance, can access the thread any time via static accessor, if it is active! */
+	/** Singleton instance, can access the service any time via static accessor, if it is active! */
 	static  FWaveVREyeRunnable* Runnable;
 
-	/** Thread to run the worker FRunnable on */
-	FRunnableThread* Thread;
-
-	/** Stop this thread? Uses Thread Safe Counter */
-	FThreadSafeCounter StopTaskCounter;
-
 	enum Actions
 	{
 		None,
@@ -38,27 +30,21 @@ public:
 	FWaveVREyeRunnable();
 	virtual ~FWaveVREyeRunnable();
 
-	// Begin FRunnable interface.
-	virtual bool Init();
-	virtual uint32 Run();
-	virtual void Stop();
-	// End FRunnable interface
-
-	/** Makes sure this thread has stopped properly */
+	/** Waits until the actions already requested have run */
 	void EnsureCompletion();
 
 
-	//~~~ Starting and Stopping Thread ~~~
+	//~~~ Starting and Stopping ~~~
 
 
 	/*
-		Start the thread and the worker from static (easy access)!
-		This code ensures only 1 Prime Number thread will be able to run at a time.
-		This function returns a handle to the newly started instance.
+		Create the instance from static (easy access)!
+		Its actions run on the shared FWaveVRServiceThread, which wakes up as soon as one is requested.
+		This function returns a handle to the instance, or NULL if the platform does not support multithreading.
 	*/
 	static FWaveVREyeRunnable* JoyInit();
 
-	/** Shuts down the thread. Static so it can easily be called from outside the thread context */
+	/** Waits for the requested actions and deletes the instance. Static so it can easily be called from outside the thread context */
 	static void Shutdown();
 
 
@@ -74,10 +60,9 @@ private:
 
 
 	// ~~~ WaveVR related components ~~~
-	bool shutDownThread;
-	bool getSupportedFeature;
 	volatile EWaveVREyeTrackingStatus eyeTrackingStatus;
 
-	Actions action = Actions::None;
-	TQueue<Actions> qActions;
+	void RequestAction(Actions action);
+	void CheckSupportedFeature();
+	void RunAction(Actions action);
 };
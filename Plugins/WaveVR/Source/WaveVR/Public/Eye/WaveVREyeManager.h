@@ -16,6 +16,8 @@
 #include "Eye/FWaveVREyeRunnable.h"
 #include "WaveVRBlueprintFunctionLibrary.h"
 
+struct FWaveVRDeviceSnapshot;
+
 class WAVEVR_API WaveVREyeManager
 {
 protected:
@@ -28,7 +30,7 @@ public:
 
 public:
 	void InitEyeData();
-	void TickEyeData();
+	void TickEyeData(const FWaveVRDeviceSnapshot& snapshot);
 
 	void StartEyeTracking(EWVR_CoordinateSystem coordinate);
 	EWVR_CoordinateSystem GetEyeSpace() {
@@ -69,7 +71,7 @@ private:
 
 	bool hasEyeData = false;
 
-	void UpdateEyeData();
+	void UpdateEyeData(float worldToMeters);
 
 	bool NormalizeX = false;
 
@@ -96,8 +98,6 @@ private:
 
 #pragma region
 private:
-	float GetWorldToMetersScale();
-
 	int logCount = 0;
 	bool printable = false;
 #pragma endregion Major Standalone Function
@@ -17,6 +17,7 @@
 #include "../WaveVRHandBPLibrary.h"
 #include "../WaveVRHandGestureComponent.h"
 #include "WaveVRCustomGestureUtils.h"
+#include "WaveVRCustomGestureTable.h"
 
 #include "WaveVRCustomGesture.generated.h"
 
@@ -42,6 +43,22 @@ public:
 public:
 	const FString kUnknownGesture = TEXT("Unknown");
 
+	/** Compiles the gesture arrays into match tables.  Called at BeginPlay, call it again after changing the arrays. */
+	UFUNCTION(BlueprintCallable, Category = "WaveVR|Hand|CustomGesture")
+	void CompileGestures();
+
+	/** Index of the matched gesture in LeftGestures, or -1 for unknown. */
+	UFUNCTION(BlueprintPure, Category = "WaveVR|Hand|CustomGesture")
+	int32 GetLeftGestureId() const { return FMath::Max(m_LeftGestureId, (int32)INDEX_NONE); }
+
+	/** Index of the matched gesture in RightGestures, or -1 for unknown. */
+	UFUNCTION(BlueprintPure, Category = "WaveVR|Hand|CustomGesture")
+	int32 GetRightGestureId() const { return FMath::Max(m_RightGestureId, (int32)INDEX_NONE); }
+
+	/** Index of the matched gesture in DualHandGestures, or -1 for unknown. */
+	UFUNCTION(BlueprintPure, Category = "WaveVR|Hand|CustomGesture")
+	int32 GetDualGestureId() const { return FMath::Max(m_DualGestureId, (int32)INDEX_NONE); }
+
 protected:
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "WaveVR|Hand|CustomGesture")
 	TArray< FSingleHandGesture > LeftGestures;
@@ -54,8 +71,7 @@ protected:
 
 private:
 	bool validPoseLeft = false, validPoseRight = false;
-	TArray< FVector > s_JointPositionsLeft, s_JointPositionsRight;
-	TArray< FQuat > s_JointRotationsLeft, s_JointRotationsRight;
+	FWaveVRHandJointsView m_JointsLeft, m_JointsRight;
 
 	EWaveVRThumbState m_ThumbStateLeft = EWaveVRThumbState::None, m_ThumbStateRight = EWaveVRThumbState::None;
 	EWaveVRFingerState m_IndexStateLeft = EWaveVRFingerState::None, m_IndexStateRight = EWaveVRFingerState::None;
@@ -69,11 +85,9 @@ private:
 	bool MatchThumbState(FThumbState state);
 	bool MatchFingerStaet(FFingerState state);
 
-	bool MatchDistanceSingle(EWaveVRHandJoint node1, EWaveVRHandJoint node2, EWaveVRJointDistance distance, bool isLeft);
-	bool MatchDistanceDual(EWaveVRHandJoint leftNode, EWaveVRHandJoint rightNode, EWaveVRJointDistance distance);
+	FWaveVRCustomGestureTable m_LeftTable, m_RightTable, m_DualTable;
 
-	FString m_LeftHandGesture = TEXT("Default"), m_RightHandGesture = TEXT("Default");
-	bool MatchGestureSingle(FSingleHandSetting gesture, bool isLeft);
-	FString m_DualHandGesture = TEXT("Default");
-	bool MatchGestureDual(FDualHandSetting gesture);
+	// Nothing is broadcast yet, so the first unknown gesture is broadcast too.
+	static const int32 kGestureIdDefault = INDEX_NONE - 1;
+	int32 m_LeftGestureId = kGestureIdDefault, m_RightGestureId = kGestureIdDefault, m_DualGestureId = kGestureIdDefault;
 };
@@ -0,0 +1,80 @@
+// "WaveVR SDK
+// © 2019 HTC Corporation. All Rights Reserved.
+//
+// Unless otherwise required by copyright law and practice,
+// upon the execution of HTC SDK license agreement,
+// HTC grants you access to and use of the WaveVR SDK(s).
+// You shall fully comply with all of HTC’s SDK license agreement terms and
+// conditions signed by you and all SDK and API requirements,
+// specifications, and documentation provided by HTC to You."
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+#include "WaveVRCustomGestureUtils.h"
+
+/**
+ * Custom gestures compiled to tables, so matching a frame does not walk the authored settings.
+ *
+ * The finger states of a hand are packed in one word, 8 bits per finger with the bit of its state set.  A gesture
+ * keeps the word of the states it accepts, so a hand matches when (word & accept) == word.  Every possible hand
+ * pose also has the list of gestures accepting it, and only those are checked against their distance tables.
+ * Gesture IDs are the indexes in the authored array, and the first matching ID wins like before.
+ */
+class FWaveVRCustomGestureTable
+{
+public:
+	// Thumb is Close or Open, the other fingers are Close, Relax or Open.
+	static const int32 kHandPoseCount = 2 * 3 * 3 * 3 * 3;
+
+	/** The pose index of the finger states, INDEX_NONE if any state is None. */
+	static int32 GetHandPose(EWaveVRThumbState thumb, EWaveVRFingerState index, EWaveVRFingerState middle, EWaveVRFingerState ring, EWaveVRFingerState pinky);
+
+	void Compile(const TArray< FSingleHandGesture >& gestures);
+	void Compile(const TArray< FDualHandGesture >& gestures);
+
+	/** Returns the ID of the first matching single hand gesture, or INDEX_NONE.  joints is indexed by EWaveVRHandJoint. */
+	int32 Match(int32 pose, const FVector* joints) const;
+
+	/** Returns the ID of the first matching dual hand gesture, or INDEX_NONE. */
+	int32 Match(int32 leftPose, const FVector* leftJoints, int32 rightPose, const FVector* rightJoints) const;
+
+	int32 Num() const { return Gestures.Num(); }
+
+private:
+	struct FDistanceTest
+	{
+		uint8 Node1, Node2;		// Left and right node of dual hand distances.
+		float MinSquared, MaxSquared;
+	};
+
+	struct FRange
+	{
+		int32 Start = 0, Num = 0;
+	};
+
+	struct FGesture
+	{
+		FRange Distances;		// Of the hand, or of the left hand for dual hand gestures.
+		uint64 RightAccept = 0;	// Dual hand gestures only.
+		FRange RightDistances;
+		FRange DualDistances;
+	};
+
+	static uint64 GetAcceptWord(const FSingleHandSetting& setting);
+	static uint64 GetPoseWord(int32 pose);
+
+	FRange AddDistances(const TArray< FSingleHandNodeDistance >& distances);
+	FRange AddDistances(const TArray< FDualHandNodeDistance >& distances);
+	void AddCandidates(const TArray< uint64 >& accepts);
+
+	bool MatchDistances(const FRange& range, const FVector* joints1, const FVector* joints2) const;
+
+	TArray< FGesture > Gestures;
+	TArray< FDistanceTest > DistanceTests;
+
+	// Gesture IDs accepting each hand pose (the left hand pose for dual hand gestures), in authored order.
+	TArray< int32 > CandidateStart;		// kHandPoseCount + 1 entries.
+	TArray< int32 > Candidates;
+};
@@ -52,7 +52,7 @@ struct FThumbState
 	bool Open = false;
 
 public:
-	uint64_t State()
+	uint64_t State() const
 	{
 		return (Close ? 1 << (uint8)EWaveVRThumbState::Close : 0)
 			| (Open ? 1 << (uint8)EWaveVRThumbState::Open : 0);
@@ -74,7 +74,7 @@ struct FFingerState
 	bool Open = false;
 
 public:
-	uint64_t State()
+	uint64_t State() const
 	{
 		return (Close ? 1 << (uint8)EWaveVRFingerState::Close : 0)
 			| (Relax ? 1 << (uint8)EWaveVRFingerState::Relax : 0)
@@ -14,6 +14,7 @@
 #include "Kismet/BlueprintFunctionLibrary.h"
 
 #include "WaveVRHandEnums.h"
+#include "WaveVRHandJointsView.h"
 
 #include "WaveVRHandBPLibrary.generated.h"
 
@@ -101,6 +102,9 @@ public:
 		meta = (ToolTip = "If the Hand Tracking is available, this API is used to retrieve all left or right hand joint poses of the natural or electronic tracker."))
 	static bool GetAllHandJointPoses(EWaveVRTrackerType tracker, EWaveVRHandType hand, TArray<FVector>& OutPositions, TArray<FQuat>& OutRotations);
 
+	/** C++ only.  Borrows the joint poses of this frame without copying, see FWaveVRHandJointsView. */
+	static FWaveVRHandJointsView GetHandJointsView(EWaveVRTrackerType tracker, EWaveVRHandType hand);
+
 	UFUNCTION(
 		BlueprintCallable,
 		Category = "WaveVR|Hand",
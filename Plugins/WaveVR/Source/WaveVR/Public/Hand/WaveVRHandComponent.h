@@ -94,12 +94,17 @@ private:
 	EWaveVRHandType handType = EWaveVRHandType::Right;
 	FName jointName[kJointCount];
 	int jointIndex[kJointCount];
+	TArray<int32> jointOfBone;	// Index into jointName of each bone, or INDEX_NONE.
+	TArray<FTransform> componentSpaceTransforms;
+
+	void SetJointPoses(const FVector (&locations)[kJointCount], const FQuat (&rotations)[kJointCount]);
 
 	APawn* m_Pawn;
 	FVector pawnPosition = FVector::ZeroVector;
 
 	int logCount = 0;
 	bool printable = false;
+	bool boneCountMismatchLogged = false;
 
 	bool IsShowHand();
 };
@@ -0,0 +1,48 @@
+// "WaveVR SDK
+// © 2019 HTC Corporation. All Rights Reserved.
+//
+// Unless otherwise required by copyright law and practice,
+// upon the execution of HTC SDK license agreement,
+// HTC grants you access to and use of the WaveVR SDK(s).
+// You shall fully comply with all of HTC’s SDK license agreement terms and
+// conditions signed by you and all SDK and API requirements,
+// specifications, and documentation provided by HTC to You."
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+#include "WaveVRHandEnums.h"
+
+/**
+ * Read-only joint poses of one hand, borrowed from WaveVRHandPose without copying.
+ * The arrays are indexed by EWaveVRHandJoint and keep their content until the next hand tick, so read them in
+ * the same frame and compare FrameNumber to tell a new frame from an old one.
+ */
+struct FWaveVRHandJointsView
+{
+	uint64 FrameNumber;			// GFrameCounter of the tick that wrote the joints.
+	bool bValid;				// Same as WaveVRHandPose::IsHandPoseValid().
+	int32 JointCount;			// Length of the arrays.
+	const FVector* Positions;	// Without the bone offset, like GetAllHandJointPoses().
+	const FQuat* Rotations;
+	// Tracker capability, read once when the tracker starts and shared by both hands: the tracker can report
+	// both position and rotation of the joint.  Says nothing about this frame, bValid does.
+	const bool* JointSupported;
+	FVector BoneOffset;
+
+	FWaveVRHandJointsView()
+		: FrameNumber(0)
+		, bValid(false)
+		, JointCount(0)
+		, Positions(nullptr)
+		, Rotations(nullptr)
+		, JointSupported(nullptr)
+		, BoneOffset(FVector::ZeroVector)
+	{
+	}
+
+	/** Same position as WaveVRHandPose::GetHandJointPose(). */
+	FVector GetPosition(EWaveVRHandJoint joint) const { check((uint8)joint < JointCount); return Positions[(uint8)joint] + BoneOffset; }
+	const FQuat& GetRotation(EWaveVRHandJoint joint) const { check((uint8)joint < JointCount); return Rotations[(uint8)joint]; }
+};
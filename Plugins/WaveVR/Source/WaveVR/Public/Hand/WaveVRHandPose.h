@@ -13,6 +13,9 @@
 #include "CoreMinimal.h"
 #include "FWaveVRHandThread.h"
 #include "WaveVRHandUtils.h"
+#include "WaveVRHandJointsView.h"
+
+struct FWaveVRDeviceSnapshot;
 
 class WAVEVR_API WaveVRHandPose
 {
@@ -27,7 +30,7 @@ public:
 #pragma region
 public:
 	void InitHandData();
-	void TickHandData();
+	void TickHandData(const FWaveVRDeviceSnapshot& snapshot);
 	void CheckPoseFusion();
 private:
 	void UpdateLeftHandGestureData();
@@ -64,6 +67,7 @@ public:
 	bool GetHandJointPose(EWaveVRTrackerType tracker, EWaveVRHandType hand, EWaveVRHandJoint joint, FVector& OutPosition, FRotator& OutRotation);
 	bool GetHandJointPose(EWaveVRTrackerType tracker, EWaveVRHandType hand, EWaveVRHandJoint joint, FVector& OutPosition, FQuat& OutRotation);
 	bool GetAllHandJointPoses(EWaveVRTrackerType tracker, EWaveVRHandType hand, TArray<FVector>& OutPositions, TArray<FQuat>& OutRotations);
+	FWaveVRHandJointsView GetHandJointsView(EWaveVRTrackerType tracker, EWaveVRHandType hand);
 	EWaveVRHandMotion GetHandMotion(EWaveVRTrackerType tracker, EWaveVRHandType hand);
 	float GetHandPinchThreshold(EWaveVRTrackerType tracker);
 	float GetHandPinchStrength(EWaveVRTrackerType tracker, EWaveVRHandType hand);
@@ -87,6 +91,8 @@ private:
 	uint32_t m_NaturalTrackerStopTick, m_NaturalTrackerStartTick;
 	TArray<FVector> s_NaturalJointPositionLeft, s_NaturalJointPositionRight;
 	TArray<FQuat> s_NaturalJointRotationLeft, s_NaturalJointRotationRight;
+	TArray<bool> s_NaturalJointSupported;  // From the tracker info, shared by both hands.
+	uint64 m_NaturalJointFrame;
 
 	bool m_EnableElectronicTracker;
 	bool hasElectronicTrackerInfo;
@@ -98,6 +104,8 @@ private:
 	uint32_t m_ElectronicTrackerStopTick, m_ElectronicTrackerStartTick;
 	TArray<FVector> s_ElectronicJointPositionLeft, s_ElectronicJointPositionRight;
 	TArray<FQuat> s_ElectronicJointRotationLeft, s_ElectronicJointRotationRight;
+	TArray<bool> s_ElectronicJointSupported;  // From the tracker info, shared by both hands.
+	uint64 m_ElectronicJointFrame;
 
 	const char *kHoldGunOn = "PLAYER02PUM_HOLD_GUN_ON";
 	const char *kHoldGunOff = "PLAYER02PUM_HOLD_GUN_OFF";
@@ -11,11 +11,42 @@
 #pragma once
 
 #include "CoreMinimal.h"
+#include "Templates/Atomic.h"
 #include "FWaveVRTrackerThread.h"
 #include "WaveVRTrackerUtils.h"
 
 #include "WaveVRBlueprintFunctionLibrary.h"
 
+struct FWaveVRDeviceSnapshot;
+
+/**
+ * State of every tracker, one array entry per tracker slot (the EWaveVRTrackerId value).
+ * Buttons use one bit per button ID in the masks, and the k_TrackerButtons index for axes and analog types.
+ * Trivially copyable so a whole frame is published with one copy.
+ */
+struct FWaveVRTrackerStates
+{
+	bool Connected[kTrackerCount];
+	EWaveVRTrackerRole Roles[kTrackerCount];
+
+	bool ValidPoses[kTrackerCount];
+	FVector Positions[kTrackerCount];
+	FQuat Orientations[kTrackerCount];
+
+	int32_t ButtonBits[kTrackerCount];
+	int32_t TouchBits[kTrackerCount];
+	int32_t AnalogBits[kTrackerCount];
+
+	EWVR_AnalogType AnalogTypes[kTrackerCount][kTrackerButtonCount];
+	uint32 ButtonPress[kTrackerCount];
+	uint32 ButtonTouch[kTrackerCount];
+	FVector2D ButtonAxis[kTrackerCount][kTrackerButtonCount];
+
+	float BatteryLife[kTrackerCount];
+
+	void Reset();
+};
+
 class WAVEVR_API WaveVRTrackerImpl
 {
 protected:
@@ -28,7 +59,7 @@ public:
 
 public:
 	void InitTrackerData();
-	void TickTrackerData();
+	void TickTrackerData(const FWaveVRDeviceSnapshot& snapshot);
 private:
 	FWaveVRTrackerThread * m_TrackerThread;
 
@@ -46,51 +77,45 @@ private:
 	bool CanStartTracker();
 	bool CanStopTracker();
 
+	// Tick and the event callbacks write m_Work.  Publish() copies it to the back buffer of m_Frames and flips
+	// m_ReadIndex, so the getters always see one complete frame.
+	FWaveVRTrackerStates m_Work;
+	FWaveVRTrackerStates m_Frames[2];
+	TAtomic<int32> m_ReadIndex;
+	void Publish();
+	const FWaveVRTrackerStates& GetStates() const { return m_Frames[m_ReadIndex.Load()]; }
+
 	// Connection
-	TMap<EWaveVRTrackerId, bool> s_Connections;
-	void CheckConnections(EWaveVRTrackerId trackerId);
-	void CheckStatusWhenConnectionChanges(EWaveVRTrackerId trackerId);
+	void CheckConnections(int slot);
+	void CheckStatusWhenConnectionChanges(int slot);
 
 	// Tracker Role
-	TMap<EWaveVRTrackerId, EWaveVRTrackerRole> s_Roles;
-	void CheckRole(EWaveVRTrackerId trackerId);
+	void CheckRole(int slot);
 
 	// Capabilities
-	void CheckCapabilities(EWaveVRTrackerId trackerId);
-	void ResetCapabilities(EWaveVRTrackerId trackerId);
+	void CheckCapabilities(int slot);
+	void ResetCapabilities(int slot);
 
 	// Pose State
-	TMap<EWaveVRTrackerId, FVector> s_Positions;
-	TMap<EWaveVRTrackerId, FQuat> s_Orientations;
-	TMap<EWaveVRTrackerId, bool> s_ValidPoses;
-	void CheckPoseState(EWaveVRTrackerId trackerId);
+	void CheckPoseStates(const FWaveVRDeviceSnapshot& snapshot);
 
 	// Input Capability
-	TMap<EWaveVRTrackerId, int32_t> s_ButtonBits;
-	TMap<EWaveVRTrackerId, int32_t> s_TouchBits;
-	TMap<EWaveVRTrackerId, int32_t> s_AnalogBits;
-	void CheckInputCapability(EWaveVRTrackerId trackerId);
-	bool IsInputAvailable(EWaveVRTrackerId trackerId, EWVR_InputType inputType, EWaveVRTrackerButton button);
+	void CheckInputCapability(int slot);
+	bool IsInputAvailable(int slot, EWVR_InputType inputType, EWaveVRTrackerButton button);
 
 	// Input Analog
-	TMap<EWaveVRTrackerId, TMap<uint8, EWVR_AnalogType>> s_InputAnalogs;
-	void CheckAnalogType(EWaveVRTrackerId trackerId);
+	void CheckAnalogType(int slot);
 
 	// Button State
-	TMap<EWaveVRTrackerId, TArray<bool>> s_ButtonPress;
-	TMap<EWaveVRTrackerId, TArray<bool>> s_ButtonTouch;
-	TMap<EWaveVRTrackerId, TArray<FVector2D>> s_ButtonAxis;
-	void CheckButtonAxis(EWaveVRTrackerId trackerId, EWaveVRTrackerButton button);
-	void CheckButtonStates(EWaveVRTrackerId trackerId);
+	void CheckButtonAxes(int slot);
+	void CheckButtonStates(int slot);
 
 	// Battery
-	TMap<EWaveVRTrackerId, float> s_BatteryLife;
-	void CheckBatteryLife(EWaveVRTrackerId trackerId);
+	void CheckBatteryLife(int slot);
 
-	// Extended Data
-	TMap<EWaveVRTrackerId, int32_t> s_ExtDataSize;
-	TMap<EWaveVRTrackerId, int32_t*> s_ExtData;
-	void CheckExtendedData(EWaveVRTrackerId trackerId);
+	// Extended Data, only touched on the game thread so it is not double-buffered.
+	TArray<int32_t> m_ExtData[kTrackerCount];
+	void CheckExtendedData(int slot);
 
 // Public Interface
 public:
@@ -99,11 +124,11 @@ public:
 	EWaveVRTrackerStatus GetTrackerStatus();
 	bool IsTrackerAvailable();
 
-	bool IsTrackerConnected(EWaveVRTrackerId trackerId) { return s_Connections[trackerId]; }
+	bool IsTrackerConnected(EWaveVRTrackerId trackerId);
 
-	EWaveVRTrackerRole GetTrackerRole(EWaveVRTrackerId trackerId) { return s_Roles[trackerId]; }
+	EWaveVRTrackerRole GetTrackerRole(EWaveVRTrackerId trackerId);
 
-	bool IsTrackerPoseValid(EWaveVRTrackerId trackerId) { return s_ValidPoses[trackerId]; }
+	bool IsTrackerPoseValid(EWaveVRTrackerId trackerId);
 	bool GetTrackerPosition(EWaveVRTrackerId trackerId, FVector& outPosition);
 	bool GetTrackerRotation(EWaveVRTrackerId trackerId, FQuat& outOrientation);
 
@@ -126,7 +151,6 @@ public:
 #pragma region
 private:
 	EWaveVRTrackerId GetTrackerId(uint8 id);
-	float GetWorldToMetersScale();
 
 	bool LogInterval();
 	uint64_t logFrame = 0;
@@ -43,6 +43,12 @@ public:
 		meta = (ToolTip = "To get the position and rotation of a device."))
 	static bool GetDevicePose2(FVector& OutPosition, FQuat& OutOrientation, EWVR_DeviceType Type = EWVR_DeviceType::DeviceType_HMD);
 
+	UFUNCTION(
+		BlueprintCallable,
+		Category = "WaveVR|PoseManager",
+		meta = (ToolTip = "To get the pose of a device at TimeOffset seconds from now, interpolated from the recent poses.  A positive offset extrapolates up to 0.1 seconds with the device velocity."))
+	static bool GetDevicePoseAtTimeOffset(FVector& OutPosition, FQuat& OutOrientation, float TimeOffset, EWVR_DeviceType Type = EWVR_DeviceType::DeviceType_HMD);
+
 	UFUNCTION(
 		BlueprintCallable,
 		Category = "WaveVR|PoseManager",
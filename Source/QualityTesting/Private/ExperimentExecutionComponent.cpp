@@ -3,7 +3,9 @@
 
 #include "ExperimentExecutionComponent.h"
 
+#include "ExperimentSubsystem.h"
 #include "PhysicsBodyInterface.h"
+#include "PhysicsEngine/PhysicsSettings.h"
 
 // Sets default values for this component's properties
 UExperimentExecutionComponent::UExperimentExecutionComponent()
@@ -19,10 +21,23 @@ UExperimentExecutionComponent::UExperimentExecutionComponent()
 	CurrentPhase = EMovementPhase::Acceleration;
 	StartDelay = CurrentTime = AccelerationTime =
 		DriftTime = DecelerationTime = ThrustForce = ControlForceAbs = 0.f;
+	bUseFixedTimestep = false;
+	FixedStepDelta = TimeAccumulator = 0.f;
+	PendingImpulse = PendingAngularImpulse = PendingForce = PendingTorque = FVector::ZeroVector;
+	bPendingVelocityReset = bPendingTeleport = false;
+	PendingPerturbationCompletions = 0;
+	PhysicsStepIndex = 0;
+	PhysicsStepTime = 0.f;
+	OnCalculateCustomPhysics.BindUObject(this, &UExperimentExecutionComponent::StepPhysics);
+	bUseBatchedTick = false;
 	InitialPosition = ActorInertiaTensor = FVector::ZeroVector;
 	InitialRotation = FRotator::ZeroRotator;
+	InitialBodyRotation = BodyRotation = FQuat::Identity;
 	TargetActor = nullptr;
 	PhysicsBody = nullptr;
+	bRecordJournal = false;
+	ReplayTickIndex = 0;
+	ReplayDeviation = 0.f;
 }
 
 
@@ -34,6 +49,13 @@ void UExperimentExecutionComponent::BeginPlay()
 	GEngine->AddOnScreenDebugMessage(0, 1.f, FColor::Red, "Component Begin play");
 }
 
+void UExperimentExecutionComponent::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+	UnregisterFromBatch();
+
+	Super::EndPlay(EndPlayReason);
+}
+
 void UExperimentExecutionComponent::ForwardMotion(float TimeDelta)
 {
 	switch (CurrentPhase)
@@ -42,7 +64,7 @@ void UExperimentExecutionComponent::ForwardMotion(float TimeDelta)
 		{
 			if (CurrentTime <= AccelerationTime)
 			{
-				PhysicsBody->AddForce(PhysicsBody->GetForwardVector() * ThrustForce);
+				ApplyForce(BodyRotation.GetForwardVector() * ThrustForce, TimeDelta);
 			}
 			else
 			{
@@ -62,7 +84,7 @@ void UExperimentExecutionComponent::ForwardMotion(float TimeDelta)
 		{
 			if (CurrentTime <= DecelerationTime)
 			{
-				PhysicsBody->AddForce(PhysicsBody->GetForwardVector() * (-ThrustForce));
+				ApplyForce(BodyRotation.GetForwardVector() * (-ThrustForce), TimeDelta);
 			}
 			else
 			{
@@ -72,8 +94,7 @@ void UExperimentExecutionComponent::ForwardMotion(float TimeDelta)
 		break;
 	case EMovementPhase::Finished:
 		{
-			PhysicsBody->SetPhysicsLinearVelocity(FVector::ZeroVector);
-			PhysicsBody->SetPhysicsAngularVelocityInRadians(FVector::ZeroVector);
+			ResetBodyVelocity();
 			CurrentPhase = EMovementPhase::Idle;
 		}
 		break;
@@ -87,32 +108,19 @@ void UExperimentExecutionComponent::ForwardMotion(float TimeDelta)
 
 void UExperimentExecutionComponent::ControllableMotion(float TimeDelta)
 {
-	ApplyControl();
+	ApplyControl(TimeDelta);
 	ForwardMotion(TimeDelta);
 }
 
 void UExperimentExecutionComponent::PerturbedMotion(float TimeDelta)
 {
-	TArray<float> Torques, Perturbations;
-	if (CurrentPerturbationIndex < PerturbationsInfos.Num())
-	{
-		Torques = PerturbationsInfos[CurrentPerturbationIndex].TorqueScaleList;
-		Perturbations = PerturbationsInfos[CurrentPerturbationIndex].PerturbationsScaleList;
-	}
-
 	switch (CurrentPhase)
 	{
 	case EMovementPhase::Acceleration:
 		{
 			if (CurrentTime <= AccelerationTime)
 			{
-				if (Perturbations.Num() > 0 && Torques.Num() > 0)
-				{
-					PhysicsBody->AddForce(PhysicsBody->GetForwardVector() * (ThrustForce + Perturbations[0]));
-					PhysicsBody->AddTorqueInRadians(
-						NewtonsTorqueToRadians(PhysicsBody->GetUpVector(), Torques[0])
-					);
-				}
+				ApplySegment(CompiledSchedule.Find(CurrentPerturbationIndex, CurrentPhase), TimeDelta);
 			}
 			else
 			{
@@ -132,13 +140,7 @@ void UExperimentExecutionComponent::PerturbedMotion(float TimeDelta)
 		{
 			if (CurrentTime <= DecelerationTime)
 			{
-				if (Perturbations.Num() > 1 && Torques.Num() > 1)
-				{
-					PhysicsBody->AddForce(PhysicsBody->GetForwardVector() * (Perturbations[1] - ThrustForce));
-					PhysicsBody->AddTorqueInRadians(
-						NewtonsTorqueToRadians(PhysicsBody->GetUpVector(), Torques[1])
-					);
-				}
+				ApplySegment(CompiledSchedule.Find(CurrentPerturbationIndex, CurrentPhase), TimeDelta);
 			}
 			else
 			{
@@ -150,21 +152,19 @@ void UExperimentExecutionComponent::PerturbedMotion(float TimeDelta)
 		{
 			if (bIsCalibration)
 			{
-				if (CurrentPerturbationIndex < PerturbationsInfos.Num() - 1)
+				if (CurrentPerturbationIndex < CompiledSchedule.Num() - 1)
 				{
 					CurrentPerturbationIndex++;
 					CurrentPhase = EMovementPhase::Acceleration;
 					CurrentTime = 0.f;
-					PhysicsBody->SetPhysicsLinearVelocity(FVector::ZeroVector);
-					PhysicsBody->SetPhysicsAngularVelocityInRadians(FVector::ZeroVector);
-					OnSinglePerturbationComplete.Broadcast();
-					TargetActor->SetActorLocation(InitialPosition);
-					TargetActor->SetActorRotation(InitialRotation);
+					ResetBodyVelocity();
+					PendingPerturbationCompletions++;
+					ResetBodyPose();
 				}
 				else
 				{
 					ExperimentState = EExperimentState::Finished;
-					OnSinglePerturbationComplete.Broadcast();
+					PendingPerturbationCompletions++;
 				}
 			}
 			else
@@ -178,16 +178,300 @@ void UExperimentExecutionComponent::PerturbedMotion(float TimeDelta)
 	CurrentTime += TimeDelta;
 }
 
-void UExperimentExecutionComponent::ApplyControl() const
+void UExperimentExecutionComponent::ApplySegment(const FPerturbationSegment* Segment, float TimeDelta)
+{
+	if (Segment)
+	{
+		ApplyForce(BodyRotation.GetForwardVector() * Segment->ForwardForce, TimeDelta);
+		ApplyTorque(BodyRotation.GetUpVector() * Segment->TorquePerUpAxis, TimeDelta);
+	}
+}
+
+void UExperimentExecutionComponent::ApplyControl(float TimeDelta)
+{
+	ApplyForce(BodyRotation.GetRightVector() * ControlForceAbs, TimeDelta);
+}
+
+void UExperimentExecutionComponent::ApplyForce(const FVector& Force, float TimeDelta)
+{
+	if (bUseFixedTimestep)
+	{
+		// Directions come from BodyRotation, so this gives back the force in body space.
+		PendingSteps.Last().Force += BodyRotation.UnrotateVector(Force);
+		PendingImpulse += Force * TimeDelta;
+	}
+	else
+	{
+		PendingForce += Force;
+	}
+}
+
+void UExperimentExecutionComponent::ApplyTorque(const FVector& Torque, float TimeDelta)
+{
+	if (bUseFixedTimestep)
+	{
+		PendingSteps.Last().Torque += BodyRotation.UnrotateVector(Torque);
+		PendingAngularImpulse += Torque * TimeDelta;
+	}
+	else
+	{
+		PendingTorque += Torque;
+	}
+}
+
+void UExperimentExecutionComponent::ResetBodyVelocity()
+{
+	// Impulses gathered before the reset must not leak into the next run.
+	// Forces are applied at the next simulation step in any case, as with AddForce.
+	PendingImpulse = PendingAngularImpulse = FVector::ZeroVector;
+	// Steps before the reset keep their time, so later steps still line up with the physics substeps.
+	for (FFixedStepCommand& Step : PendingSteps)
+	{
+		Step.Force = Step.Torque = FVector::ZeroVector;
+	}
+	bPendingVelocityReset = true;
+}
+
+void UExperimentExecutionComponent::ResetBodyPose()
+{
+	bPendingTeleport = true;
+	PendingTeleportLocation = InitialPosition;
+	PendingTeleportRotation = InitialRotation;
+	// Later steps of the same frame already see the body at its initial orientation.
+	BodyRotation = InitialBodyRotation;
+}
+
+void UExperimentExecutionComponent::GatherBodyState(float DeltaTime)
+{
+	BodyRotation = PhysicsBody->GetComponentQuat();
+
+	if (bRecordJournal)
+	{
+		BeginJournalTick(DeltaTime);
+	}
+}
+
+void UExperimentExecutionComponent::AdvanceExperiment(float DeltaTime)
+{
+	if (!bUseFixedTimestep)
+	{
+		StepExperiment(DeltaTime);
+		return;
+	}
+
+	// Never fall further behind than this, a long hitch slows the experiment down instead.
+	constexpr int32 MaxStepsPerFrame = 16;
+
+	TimeAccumulator += DeltaTime;
+	int32 Steps = 0;
+	while (TimeAccumulator >= FixedStepDelta && Steps < MaxStepsPerFrame &&
+		ExperimentState != EExperimentState::Finished)
+	{
+		PendingSteps.Add({FixedStepDelta, FVector::ZeroVector, FVector::ZeroVector});
+		StepExperiment(FixedStepDelta);
+		TimeAccumulator -= FixedStepDelta;
+		++Steps;
+	}
+
+	if (Steps == MaxStepsPerFrame && TimeAccumulator >= FixedStepDelta)
+	{
+		UE_LOG(LogTemp, Warning, TEXT("Experiment fell %.3f s behind the fixed timestep, dropping it."), TimeAccumulator);
+		TimeAccumulator = 0.f;
+	}
+}
+
+void UExperimentExecutionComponent::ApplyBodyCommands()
 {
-	PhysicsBody->AddForce(PhysicsBody->GetRightVector() * ControlForceAbs);
+	if (bPendingVelocityReset)
+	{
+		PhysicsBody->SetPhysicsLinearVelocity(FVector::ZeroVector);
+		PhysicsBody->SetPhysicsAngularVelocityInRadians(FVector::ZeroVector);
+		RecordingTick.Flags |= FExperimentJournalTick::VelocityReset;
+	}
+
+	if (bPendingTeleport)
+	{
+		RecordingTick.Flags |= FExperimentJournalTick::Teleport;
+		RecordingTick.TeleportLocation = PendingTeleportLocation;
+		RecordingTick.TeleportRotation = PendingTeleportRotation;
+	}
+
+	if (!PendingForce.IsZero())
+	{
+		PhysicsBody->AddForce(PendingForce);
+	}
+	if (!PendingTorque.IsZero())
+	{
+		PhysicsBody->AddTorqueInRadians(PendingTorque);
+	}
+	if (bUseFixedTimestep)
+	{
+		QueuePhysicsSteps();
+	}
+	else
+	{
+		// Only journal replays hand over whole impulses.
+		if (!PendingImpulse.IsZero())
+		{
+			PhysicsBody->AddImpulse(PendingImpulse);
+		}
+		if (!PendingAngularImpulse.IsZero())
+		{
+			PhysicsBody->AddAngularImpulseInRadians(PendingAngularImpulse);
+		}
+	}
+
+	if (bRecordJournal)
+	{
+		if (bUseFixedTimestep)
+		{
+			RecordingTick.Flags |= FExperimentJournalTick::Impulse;
+			RecordingTick.Force = PendingImpulse;
+			RecordingTick.Torque = PendingAngularImpulse;
+		}
+		else
+		{
+			RecordingTick.Force = PendingForce;
+			RecordingTick.Torque = PendingTorque;
+		}
+
+		if (PendingPerturbationCompletions > 0)
+		{
+			RecordingTick.Flags |= FExperimentJournalTick::PerturbationComplete;
+		}
+
+		EndJournalTick();
+	}
+
+	const int32 Completions = PendingPerturbationCompletions;
+	const bool bTeleport = bPendingTeleport;
+	const FVector TeleportLocation = PendingTeleportLocation;
+	const FRotator TeleportRotation = PendingTeleportRotation;
+	PendingImpulse = PendingAngularImpulse = PendingForce = PendingTorque = FVector::ZeroVector;
+	bPendingVelocityReset = bPendingTeleport = false;
+	PendingPerturbationCompletions = 0;
+
+	// Listeners still see the pose the perturbation ended in, the body is moved back afterwards.
+	// They may set the component up again, so only the copies above are used from here on.
+	for (int32 i = 0; i < Completions; ++i)
+	{
+		OnSinglePerturbationComplete.Broadcast();
+	}
+
+	if (bTeleport)
+	{
+		TargetActor->SetActorLocation(TeleportLocation);
+		TargetActor->SetActorRotation(TeleportRotation);
+	}
 }
 
-FVector UExperimentExecutionComponent::NewtonsTorqueToRadians(FVector Direction, float TorqueScale) const
+void UExperimentExecutionComponent::QueuePhysicsSteps()
 {
-	return (Direction * TorqueScale) / ActorInertiaTensor;
+	// The last simulation is done by now. Steps it did not reach go first, unless the body was reset.
+	if (bPendingVelocityReset || PhysicsStepIndex >= PhysicsSteps.Num())
+	{
+		PhysicsSteps.Reset();
+	}
+	else
+	{
+		PhysicsSteps.RemoveAt(0, PhysicsStepIndex, false);
+		PhysicsSteps[0].Duration -= PhysicsStepTime;
+	}
+	PhysicsStepIndex = 0;
+	PhysicsStepTime = 0.f;
+
+	PhysicsSteps.Append(PendingSteps);
+	PendingSteps.Reset();
+
+	// Custom physics is cleared after every simulation, so the callback is queued each frame.
+	FBodyInstance* BodyInstance = PhysicsBody->GetBodyInstance();
+	if (BodyInstance && PhysicsSteps.Num() > 0)
+	{
+		BodyInstance->AddCustomPhysics(OnCalculateCustomPhysics);
+	}
 }
 
+void UExperimentExecutionComponent::StepPhysics(float DeltaTime, FBodyInstance* BodyInstance)
+{
+	// Runs once per physics substep, possibly off the game thread. Only PhysicsSteps and its cursor are touched.
+	FVector Impulse = FVector::ZeroVector;
+	FVector AngularImpulse = FVector::ZeroVector;
+	float Remaining = DeltaTime;
+	while (Remaining > 0.f && PhysicsStepIndex < PhysicsSteps.Num())
+	{
+		const FFixedStepCommand& Step = PhysicsSteps[PhysicsStepIndex];
+		const float Slice = FMath::Min(Remaining, Step.Duration - PhysicsStepTime);
+		Impulse += Step.Force * Slice;
+		AngularImpulse += Step.Torque * Slice;
+		Remaining -= Slice;
+		PhysicsStepTime += Slice;
+
+		if (PhysicsStepTime >= Step.Duration - KINDA_SMALL_NUMBER)
+		{
+			++PhysicsStepIndex;
+			PhysicsStepTime = 0.f;
+		}
+	}
+
+	if (DeltaTime > 0.f)
+	{
+		// Body space to world space with the rotation of this substep.
+		const FQuat Rotation = BodyInstance->GetUnrealWorldTransform_AssumesLocked().GetRotation();
+		BodyInstance->AddForce(Rotation.RotateVector(Impulse / DeltaTime), false);
+		BodyInstance->AddTorqueInRadians(Rotation.RotateVector(AngularImpulse / DeltaTime), false);
+	}
+}
+
+void UExperimentExecutionComponent::BeginJournalTick(float DeltaTime)
+{
+	RecordingTick = FExperimentJournalTick();
+	RecordingTick.TickIndex = static_cast<uint32>(Journal.Ticks.Num());
+	RecordingTick.DeltaTime = DeltaTime;
+	RecordingTick.Location = TargetActor->GetActorLocation();
+}
+
+void UExperimentExecutionComponent::EndJournalTick()
+{
+	RecordingTick.CurrentTime = CurrentTime;
+	RecordingTick.State = ExperimentState;
+	RecordingTick.Phase = CurrentPhase;
+	Journal.Ticks.Add(RecordingTick);
+}
+
+void UExperimentExecutionComponent::ReplayStep()
+{
+	if (ReplayTickIndex >= ReplayJournal->Ticks.Num())
+	{
+		ExperimentState = EExperimentState::Finished;
+		return;
+	}
+
+	const FExperimentJournalTick& Tick = ReplayJournal->Ticks[ReplayTickIndex++];
+	ReplayDeviation = FMath::Max(ReplayDeviation, FVector::Distance(TargetActor->GetActorLocation(), Tick.Location));
+
+	bPendingVelocityReset = (Tick.Flags & FExperimentJournalTick::VelocityReset) != 0;
+	bPendingTeleport = (Tick.Flags & FExperimentJournalTick::Teleport) != 0;
+	PendingTeleportLocation = Tick.TeleportLocation;
+	PendingTeleportRotation = Tick.TeleportRotation;
+	PendingPerturbationCompletions = (Tick.Flags & FExperimentJournalTick::PerturbationComplete) ? 1 : 0;
+
+	if (Tick.Flags & FExperimentJournalTick::Impulse)
+	{
+		PendingImpulse = Tick.Force;
+		PendingAngularImpulse = Tick.Torque;
+	}
+	else
+	{
+		PendingForce = Tick.Force;
+		PendingTorque = Tick.Torque;
+	}
+
+	CurrentTime = Tick.CurrentTime;
+	ExperimentState = Tick.State;
+	CurrentPhase = Tick.Phase;
+
+	ApplyBodyCommands();
+}
 
 // Called every frame
 void UExperimentExecutionComponent::TickComponent(float DeltaTime, ELevelTick TickType,
@@ -195,28 +479,56 @@ void UExperimentExecutionComponent::TickComponent(float DeltaTime, ELevelTick Ti
 {
 	Super::TickComponent(DeltaTime, TickType, ThisTickFunction);
 
-	OnComponentUpdate.Broadcast(CurrentTime);
+	if (ExperimentState != EExperimentState::Finished)
+	{
+		if (ReplayJournal.IsValid())
+		{
+			ReplayStep();
+		}
+		else
+		{
+			GatherBodyState(DeltaTime);
+			AdvanceExperiment(DeltaTime);
+			ApplyBodyCommands();
+		}
+	}
+
+	// After the work, as UExperimentSubsystem does for batched experiments.
+	if (OnComponentUpdate.IsBound())
+	{
+		OnComponentUpdate.Broadcast(CurrentTime);
+	}
 
+	if (ExperimentState == EExperimentState::Finished)
+	{
+		// Reported once, like a batched experiment. The tick is off before listeners run, so
+		// setting the component up again from one turns it back on.
+		SetComponentTickEnabled(false);
+		OnComponentFinished.Broadcast();
+	}
+}
+
+void UExperimentExecutionComponent::StepExperiment(float TimeDelta)
+{
 	switch (ExperimentState)
 	{
 	case EExperimentState::AdjustOrigin:
-		ForwardMotion(DeltaTime);
+		ForwardMotion(TimeDelta);
 		break;
 	case EExperimentState::ReachableZoneSearch:
-		ControllableMotion(DeltaTime);
+		ControllableMotion(TimeDelta);
 		break;
 	case EExperimentState::PerturbedMotion:
-		PerturbedMotion(DeltaTime);
-		break;
-	case EExperimentState::Finished:
-		OnComponentFinished.Broadcast();
+		PerturbedMotion(TimeDelta);
 		break;
 	}
 }
 
 void UExperimentExecutionComponent::SetupComponent(const FExecutionComponentInitializer& ComponentInitializer)
 {
+	UnregisterFromBatch();
 	CurrentTime = 0.f;
+	CurrentPhase = EMovementPhase::Acceleration;
 	ExperimentState = ComponentInitializer.InitialState;
 	StartDelay = ComponentInitializer.StartDelay;
 	AccelerationTime = ComponentInitializer.PhaseDelta;
@@ -224,9 +536,33 @@ void UExperimentExecutionComponent::SetupComponent(const FExecutionComponentInit
 	DecelerationTime = DriftTime + ComponentInitializer.PhaseDelta;
 	ThrustForce = ComponentInitializer.ThrustForce;
 	ControlForceAbs = ComponentInitializer.ControlForceAbs;
-	PerturbationsInfos = ComponentInitializer.Perturbations;
 	bIsCalibration = ComponentInitializer.bIsExperimentCalibration;
+	bUseFixedTimestep = ComponentInitializer.bUseFixedTimestep && ComponentInitializer.FixedStepRate > 0.f;
+	FixedStepDelta = bUseFixedTimestep ? 1.f / ComponentInitializer.FixedStepRate : 0.f;
+	TimeAccumulator = 0.f;
+	PendingImpulse = PendingAngularImpulse = PendingForce = PendingTorque = FVector::ZeroVector;
+	bPendingVelocityReset = bPendingTeleport = false;
+	PendingPerturbationCompletions = 0;
+	PendingSteps.Reset();
+	PhysicsSteps.Reset();
+	PhysicsStepIndex = 0;
+	PhysicsStepTime = 0.f;
+	if (bUseFixedTimestep)
+	{
+		// PhysicsSteps may only change while physics is not running.
+		SetTickGroup(TG_PrePhysics);
+
+		if (!UPhysicsSettings::Get()->bSubstepping)
+		{
+			UE_LOG(LogTemp, Warning, TEXT("Physics substepping is off, the fixed-step forces of %s are only applied once per frame."),
+			       *GetPathName());
+		}
+	}
+	bUseBatchedTick = ComponentInitializer.bUseBatchedTick;
 	CurrentPerturbationIndex = bIsCalibration ? 0 : ComponentInitializer.SaddlePointIndex;
+	bRecordJournal = ComponentInitializer.bRecordJournal;
+	ReplayJournal.Reset();
+	Journal.Reset();
 
 	TargetActor = ComponentInitializer.TargetActor;
 	InitialPosition = TargetActor->GetActorLocation();
@@ -236,6 +572,19 @@ void UExperimentExecutionComponent::SetupComponent(const FExecutionComponentInit
 	{
 		PhysicsBody = IPhysicsBodyInterface::Execute_GetPhysicsBody(TargetActor.Get());
 		ActorInertiaTensor = IPhysicsBodyInterface::Execute_GetInertiaTensor(TargetActor.Get());
+		InitialBodyRotation = BodyRotation = PhysicsBody->GetComponentQuat();
+		CompiledSchedule.Compile(ComponentInitializer.Perturbations, ThrustForce, ActorInertiaTensor);
+
+		if (bRecordJournal)
+		{
+			Journal.InitialState = ExperimentState;
+			Journal.FixedStepDelta = FixedStepDelta;
+			Journal.StartLocation = InitialPosition;
+			Journal.StartRotation = InitialRotation;
+			Journal.StartLinearVelocity = PhysicsBody->GetPhysicsLinearVelocity();
+			Journal.StartAngularVelocity = PhysicsBody->GetPhysicsAngularVelocityInRadians();
+		}
+
 		FinalizeSetupComponent();
 	}
 	else
@@ -244,6 +593,16 @@ void UExperimentExecutionComponent::SetupComponent(const FExecutionComponentInit
 	}
 }
 
+void UExperimentExecutionComponent::EnableFixedStepSubstepping(float FixedStepRate)
+{
+	UPhysicsSettings* PhysicsSettings = UPhysicsSettings::Get();
+	PhysicsSettings->bSubstepping = true;
+	if (FixedStepRate > 0.f)
+	{
+		PhysicsSettings->MaxSubstepDeltaTime = FMath::Min(PhysicsSettings->MaxSubstepDeltaTime, 1.f / FixedStepRate);
+	}
+}
+
 void UExperimentExecutionComponent::FinalizeSetupComponent()
 {
 	if (StartDelay > 0)
@@ -261,7 +620,27 @@ void UExperimentExecutionComponent::FinalizeSetupComponent()
 void UExperimentExecutionComponent::StartComponentWork()
 {
 	GEngine->AddOnScreenDebugMessage(0, 1.f, FColor::Red, "Component Start");
-	SetComponentTickEnabled(true);
+
+	UExperimentSubsystem* Subsystem = GetWorld()->GetSubsystem<UExperimentSubsystem>();
+	if (bUseBatchedTick && Subsystem)
+	{
+		SetComponentTickEnabled(false);
+		Subsystem->RegisterExperiment(this);
+	}
+	else
+	{
+		SetComponentTickEnabled(true);
+	}
+}
+
+void UExperimentExecutionComponent::UnregisterFromBatch()
+{
+	UWorld* World = GetWorld();
+	UExperimentSubsystem* Subsystem = World ? World->GetSubsystem<UExperimentSubsystem>() : nullptr;
+	if (Subsystem)
+	{
+		Subsystem->UnregisterExperiment(this);
+	}
 }
 
 EExperimentState UExperimentExecutionComponent::GetCurrentState() const
@@ -273,3 +652,79 @@ EMovementPhase UExperimentExecutionComponent::GetCurrentPhase() const
 {
 	return CurrentPhase;
 }
+
+float UExperimentExecutionComponent::GetCurrentTime() const
+{
+	return CurrentTime;
+}
+
+bool UExperimentExecutionComponent::SaveJournal(const FString& FileName, const FString& FileExtension) const
+{
+	return Journal.SaveToFile(UFileHandlerComponent::MakeResultPath(FileName, FileExtension));
+}
+
+bool UExperimentExecutionComponent::StartReplay(const FString& JournalPath, AActor* ReplayTarget)
+{
+	const TSharedRef<FExperimentJournal> LoadedJournal = MakeShared<FExperimentJournal>();
+
+	return LoadedJournal->LoadFromFile(JournalPath) && StartReplayFromJournal(LoadedJournal, ReplayTarget);
+}
+
+bool UExperimentExecutionComponent::StartReplayFromJournal(TSharedRef<const FExperimentJournal> InJournal, AActor* ReplayTarget)
+{
+	if (!ReplayTarget || !ReplayTarget->GetClass()->ImplementsInterface(UPhysicsBodyInterface::StaticClass()))
+	{
+		OnSetupFailed.Broadcast();
+		return false;
+	}
+
+	if (InJournal->FixedStepDelta > 0.f)
+	{
+		UE_LOG(LogTemp, Error, TEXT("Cannot replay a journal recorded with a fixed timestep of %f s."),
+		       InJournal->FixedStepDelta);
+		OnSetupFailed.Broadcast();
+		return false;
+	}
+
+	UnregisterFromBatch();
+
+	TargetActor = ReplayTarget;
+	PhysicsBody = IPhysicsBodyInterface::Execute_GetPhysicsBody(ReplayTarget);
+	ActorInertiaTensor = IPhysicsBodyInterface::Execute_GetInertiaTensor(ReplayTarget);
+
+	ReplayJournal = InJournal;
+	ReplayTickIndex = 0;
+	ReplayDeviation = 0.f;
+	bRecordJournal = false;
+	bUseFixedTimestep = false;
+	CurrentTime = TimeAccumulator = 0.f;
+	CurrentPhase = EMovementPhase::Acceleration;
+	ExperimentState = InJournal->InitialState;
+	PendingImpulse = PendingAngularImpulse = PendingForce = PendingTorque = FVector::ZeroVector;
+	bPendingVelocityReset = bPendingTeleport = false;
+	PendingPerturbationCompletions = 0;
+	InitialPosition = InJournal->StartLocation;
+	InitialRotation = InJournal->StartRotation;
+
+	ReplayTarget->SetActorLocationAndRotation(InitialPosition, InitialRotation, false, nullptr, ETeleportType::ResetPhysics);
+	PhysicsBody->SetPhysicsLinearVelocity(InJournal->StartLinearVelocity);
+	PhysicsBody->SetPhysicsAngularVelocityInRadians(InJournal->StartAngularVelocity);
+
+	SetComponentTickEnabled(true);
+	return true;
+}
+
+bool UExperimentExecutionComponent::IsReplaying() const
+{
+	return ReplayJournal.IsValid() && ExperimentState != EExperimentState::Finished;
+}
+
+float UExperimentExecutionComponent::GetReplayDeviation() const
+{
+	return ReplayDeviation;
+}
+
+const FExperimentJournal& UExperimentExecutionComponent::GetJournal() const
+{
+	return Journal;
+}
@@ -0,0 +1,121 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "ExperimentJournal.h"
+
+#include "HAL/FileManager.h"
+
+FArchive& operator<<(FArchive& Ar, FExperimentJournalTick& Tick)
+{
+	uint8 State = static_cast<uint8>(Tick.State);
+	uint8 Phase = static_cast<uint8>(Tick.Phase);
+	uint8 Flags = Tick.Flags & ~(FExperimentJournalTick::HasForce | FExperimentJournalTick::HasTorque);
+
+	if (Ar.IsSaving())
+	{
+		Flags |= Tick.Force.IsZero() ? 0 : FExperimentJournalTick::HasForce;
+		Flags |= Tick.Torque.IsZero() ? 0 : FExperimentJournalTick::HasTorque;
+	}
+
+	Ar << Tick.TickIndex << Tick.DeltaTime << Tick.CurrentTime << State << Phase << Flags << Tick.Location;
+
+	if (Flags & FExperimentJournalTick::HasForce)
+	{
+		Ar << Tick.Force;
+	}
+	if (Flags & FExperimentJournalTick::HasTorque)
+	{
+		Ar << Tick.Torque;
+	}
+	if (Flags & FExperimentJournalTick::Teleport)
+	{
+		Ar << Tick.TeleportLocation << Tick.TeleportRotation;
+	}
+
+	if (Ar.IsLoading())
+	{
+		Tick.State = static_cast<EExperimentState>(State);
+		Tick.Phase = static_cast<EMovementPhase>(Phase);
+		Tick.Flags = Flags;
+	}
+
+	return Ar;
+}
+
+FArchive& operator<<(FArchive& Ar, FExperimentJournal& Journal)
+{
+	uint32 Magic = FExperimentJournal::MagicValue;
+	uint16 Version = FExperimentJournal::CurrentVersion;
+	Ar << Magic << Version;
+
+	if (Magic != FExperimentJournal::MagicValue || Version != FExperimentJournal::CurrentVersion)
+	{
+		Ar.SetError();
+		return Ar;
+	}
+
+	uint8 InitialState = static_cast<uint8>(Journal.InitialState);
+	Ar << InitialState << Journal.FixedStepDelta;
+	Ar << Journal.StartLocation << Journal.StartRotation << Journal.StartLinearVelocity << Journal.StartAngularVelocity;
+	Ar << Journal.Ticks;
+	Journal.InitialState = static_cast<EExperimentState>(InitialState);
+
+	return Ar;
+}
+
+void FExperimentJournal::Reset()
+{
+	*this = FExperimentJournal();
+}
+
+bool FExperimentJournal::SaveToFile(const FString& FilePath) const
+{
+	TUniquePtr<FArchive> Writer(IFileManager::Get().CreateFileWriter(*FilePath));
+
+	if (Writer)
+	{
+		*Writer << const_cast<FExperimentJournal&>(*this);
+	}
+
+	if (!Writer || !Writer->Close())
+	{
+		UE_LOG(LogTemp, Error, TEXT("Couldn't write to file %s. Write failed."), *FilePath);
+		return false;
+	}
+
+	UE_LOG(LogTemp, Log, TEXT("Successfully saved file %s."), *FilePath);
+	return true;
+}
+
+bool FExperimentJournal::LoadFromFile(const FString& FilePath)
+{
+	TUniquePtr<FArchive> Reader(IFileManager::Get().CreateFileReader(*FilePath));
+
+	if (!Reader)
+	{
+		UE_LOG(LogTemp, Error, TEXT("Cannot open %s for reading. File does not exist."), *FilePath);
+		return false;
+	}
+
+	Reset();
+	*Reader << *this;
+
+	if (!Reader->Close())
+	{
+		UE_LOG(LogTemp, Error, TEXT("%s is not a valid experiment journal."), *FilePath);
+		Reset();
+		return false;
+	}
+
+	return true;
+}
+
+float FExperimentJournal::GetDuration() const
+{
+	float Duration = 0.f;
+	for (const FExperimentJournalTick& Tick : Ticks)
+	{
+		Duration += Tick.DeltaTime;
+	}
+	return Duration;
+}
@@ -0,0 +1,460 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "ExperimentLogFormat.h"
+
+#include "Async/MappedFileHandle.h"
+#include "HAL/PlatformFilemanager.h"
+#include "Misc/Compression.h"
+#include "Misc/FileHelper.h"
+
+namespace
+{
+	int64 AlignColumn(int64 Offset)
+	{
+		return Align(Offset, 8);
+	}
+
+	FName GetCompressionFormatName(EResultCompression Compression)
+	{
+		return Compression == EResultCompression::LZ4 ? NAME_LZ4 : NAME_Zlib;
+	}
+
+	template <typename T>
+	void WriteColumn(TArray<uint8>& Buffer, int64 Offset, int32 Index, T Value)
+	{
+		FMemory::Memcpy(Buffer.GetData() + Offset + Index * sizeof(T), &Value, sizeof(T));
+	}
+
+	template <typename T>
+	void WriteLocationColumns(TArray<uint8>& Buffer, const FExperimentLogHeader& Header,
+	                          TArrayView<const FExperimentSample> Samples)
+	{
+		for (int32 i = 0; i < Samples.Num(); ++i)
+		{
+			for (int32 Axis = 0; Axis < 3; ++Axis)
+			{
+				WriteColumn<T>(Buffer, Header.LocationColumnOffsets[Axis], i, Samples[i].Location[Axis]);
+			}
+		}
+	}
+}
+
+FMappedFileView::FMappedFileView()
+	: Data(nullptr)
+	, DataSize(0)
+{
+}
+
+FMappedFileView::~FMappedFileView()
+{
+	Close();
+}
+
+bool FMappedFileView::Open(const FString& FilePath)
+{
+	Close();
+
+	auto& FileManager = FPlatformFileManager::Get().GetPlatformFile();
+
+	if (!FileManager.FileExists(*FilePath))
+	{
+		UE_LOG(LogTemp, Error, TEXT("Cannot open %s for reading. File does not exist."), *FilePath);
+		return false;
+	}
+
+	MappedFile.Reset(FileManager.OpenMapped(*FilePath));
+	if (MappedFile && MappedFile->GetFileSize() > 0)
+	{
+		MappedRegion.Reset(MappedFile->MapRegion(0, MappedFile->GetFileSize()));
+	}
+
+	if (MappedRegion)
+	{
+		Data = MappedRegion->GetMappedPtr();
+		DataSize = MappedRegion->GetMappedSize();
+	}
+	else if (FFileHelper::LoadFileToArray(FallbackData, *FilePath))
+	{
+		Data = FallbackData.GetData();
+		DataSize = FallbackData.Num();
+	}
+	else
+	{
+		UE_LOG(LogTemp, Error, TEXT("Something went wrong. Couldn't read file %s."), *FilePath);
+		return false;
+	}
+
+	return true;
+}
+
+void FMappedFileView::Close()
+{
+	MappedRegion.Reset();
+	MappedFile.Reset();
+	FallbackData.Empty();
+	Data = nullptr;
+	DataSize = 0;
+}
+
+const uint8* FMappedFileView::GetData() const
+{
+	return Data;
+}
+
+int64 FMappedFileView::GetSize() const
+{
+	return DataSize;
+}
+
+static_assert(sizeof(FExperimentLogHeader) % 8 == 0, "Log header must keep columns 8-byte aligned.");
+
+bool FExperimentLogWriter::SaveToFile(const FString& FilePath, TArrayView<const FExperimentSample> Samples,
+                                      const TArray<FString>& StateNames, bool bDoublePrecision)
+{
+	TArray<uint8> Buffer;
+	Serialize(Samples, StateNames, bDoublePrecision, Buffer);
+
+	const bool bSuccess = FFileHelper::SaveArrayToFile(Buffer, *FilePath);
+
+	if (!bSuccess)
+	{
+		UE_LOG(LogTemp, Error, TEXT("Couldn't write to file %s. Write failed."), *FilePath);
+	}
+
+	return bSuccess;
+}
+
+void FExperimentLogWriter::Serialize(TArrayView<const FExperimentSample> Samples, const TArray<FString>& StateNames,
+                                     bool bDoublePrecision, TArray<uint8>& OutBuffer)
+{
+	TArray<TArray<uint8>> EncodedStates;
+	int64 StateTableSize = 0;
+	for (const FString& StateName : StateNames)
+	{
+		const FTCHARToUTF8 Converter(*StateName);
+		TArray<uint8>& Encoded = EncodedStates.AddDefaulted_GetRef();
+		Encoded.Append(reinterpret_cast<const uint8*>(Converter.Get()), FMath::Min(Converter.Length(), int32(MAX_uint16)));
+		StateTableSize += sizeof(uint16) + Encoded.Num();
+	}
+
+	const int64 Count = Samples.Num();
+	const int64 LocationSize = bDoublePrecision ? sizeof(double) : sizeof(float);
+
+	FExperimentLogHeader Header;
+	FMemory::Memzero(Header);
+	Header.Magic = FExperimentLogHeader::MagicValue;
+	Header.Version = FExperimentLogHeader::CurrentVersion;
+	Header.bDoublePrecision = bDoublePrecision ? 1 : 0;
+	Header.SampleCount = static_cast<uint32>(Count);
+	Header.StateCount = static_cast<uint32>(StateNames.Num());
+	Header.StateTableOffset = sizeof(FExperimentLogHeader);
+	Header.FrameColumnOffset = AlignColumn(Header.StateTableOffset + StateTableSize);
+	Header.StateColumnOffset = AlignColumn(Header.FrameColumnOffset + Count * sizeof(uint32));
+	Header.LocationColumnOffsets[0] = AlignColumn(Header.StateColumnOffset + Count * sizeof(uint8));
+	Header.LocationColumnOffsets[1] = AlignColumn(Header.LocationColumnOffsets[0] + Count * LocationSize);
+	Header.LocationColumnOffsets[2] = AlignColumn(Header.LocationColumnOffsets[1] + Count * LocationSize);
+	const int64 TotalSize = AlignColumn(Header.LocationColumnOffsets[2] + Count * LocationSize);
+
+	TArray<uint8>& Buffer = OutBuffer;
+	Buffer.Reset();
+	Buffer.SetNumZeroed(TotalSize);
+	FMemory::Memcpy(Buffer.GetData(), &Header, sizeof(Header));
+
+	int64 StateOffset = Header.StateTableOffset;
+	for (const TArray<uint8>& Encoded : EncodedStates)
+	{
+		const uint16 Length = static_cast<uint16>(Encoded.Num());
+		FMemory::Memcpy(Buffer.GetData() + StateOffset, &Length, sizeof(Length));
+		FMemory::Memcpy(Buffer.GetData() + StateOffset + sizeof(Length), Encoded.GetData(), Length);
+		StateOffset += sizeof(Length) + Length;
+	}
+
+	for (int32 i = 0; i < Samples.Num(); ++i)
+	{
+		WriteColumn<uint32>(Buffer, Header.FrameColumnOffset, i, Samples[i].FrameIndex);
+		WriteColumn<uint8>(Buffer, Header.StateColumnOffset, i, Samples[i].StateId);
+	}
+
+	if (bDoublePrecision)
+	{
+		WriteLocationColumns<double>(Buffer, Header, Samples);
+	}
+	else
+	{
+		WriteLocationColumns<float>(Buffer, Header, Samples);
+	}
+}
+
+bool FCompressedResult::Compress(EResultCompression Compression, TArrayView<const uint8> Payload, TArray<uint8>& OutData)
+{
+	OutData.Reset();
+
+	if (Compression == EResultCompression::None)
+	{
+		OutData.Append(Payload.GetData(), Payload.Num());
+		return true;
+	}
+
+	const FName FormatName = GetCompressionFormatName(Compression);
+	int32 CompressedSize = FCompression::CompressMemoryBound(FormatName, Payload.Num());
+
+	OutData.SetNumUninitialized(sizeof(FCompressedResultHeader) + CompressedSize);
+	if (!FCompression::CompressMemory(FormatName, OutData.GetData() + sizeof(FCompressedResultHeader), CompressedSize,
+	                                  Payload.GetData(), Payload.Num(), COMPRESS_BiasSpeed))
+	{
+		UE_LOG(LogTemp, Error, TEXT("%s compression of %d bytes failed."), *FormatName.ToString(), Payload.Num());
+		OutData.Reset();
+		return false;
+	}
+
+	FCompressedResultHeader Header;
+	FMemory::Memzero(Header);
+	Header.Magic = FCompressedResultHeader::MagicValue;
+	Header.Version = FCompressedResultHeader::CurrentVersion;
+	Header.Format = static_cast<uint8>(Compression);
+	Header.UncompressedSize = Payload.Num();
+	Header.CompressedSize = CompressedSize;
+	FMemory::Memcpy(OutData.GetData(), &Header, sizeof(Header));
+
+	OutData.SetNum(sizeof(FCompressedResultHeader) + CompressedSize, false);
+
+	return true;
+}
+
+bool FCompressedResult::Decompress(const uint8* Data, int64 Size, TArray<uint8>& OutPayload)
+{
+	OutPayload.Reset();
+
+	if (!IsCompressed(Data, Size))
+	{
+		OutPayload.Append(Data, Size);
+		return true;
+	}
+
+	FCompressedResultHeader Header;
+	FMemory::Memcpy(&Header, Data, sizeof(Header));
+
+	if (Header.Version > FCompressedResultHeader::CurrentVersion ||
+		Header.Format == static_cast<uint8>(EResultCompression::None) ||
+		Header.Format > static_cast<uint8>(EResultCompression::LZ4) ||
+		Header.CompressedSize > uint64(Size - sizeof(Header)) ||
+		Header.UncompressedSize > uint64(MAX_int32))
+	{
+		UE_LOG(LogTemp, Error, TEXT("Unsupported or truncated compressed result (version %d, format %d)."),
+		       Header.Version, Header.Format);
+		return false;
+	}
+
+	const FName FormatName = GetCompressionFormatName(static_cast<EResultCompression>(Header.Format));
+	OutPayload.SetNumUninitialized(static_cast<int32>(Header.UncompressedSize));
+
+	if (!FCompression::UncompressMemory(FormatName, OutPayload.GetData(), OutPayload.Num(),
+	                                    Data + sizeof(Header), static_cast<int32>(Header.CompressedSize)))
+	{
+		UE_LOG(LogTemp, Error, TEXT("%s decompression of %llu bytes failed."), *FormatName.ToString(), Header.CompressedSize);
+		OutPayload.Reset();
+		return false;
+	}
+
+	return true;
+}
+
+bool FCompressedResult::IsCompressed(const uint8* Data, int64 Size)
+{
+	uint32 Magic = 0;
+	if (Size >= int64(sizeof(FCompressedResultHeader)))
+	{
+		FMemory::Memcpy(&Magic, Data, sizeof(Magic));
+	}
+
+	return Magic == FCompressedResultHeader::MagicValue;
+}
+
+FExperimentLogReader::FExperimentLogReader()
+	: Data(nullptr)
+	, DataSize(0)
+	, Header(nullptr)
+{
+}
+
+FExperimentLogReader::~FExperimentLogReader()
+{
+	Close();
+}
+
+bool FExperimentLogReader::Open(const FString& FilePath)
+{
+	Close();
+
+	if (!File.Open(FilePath))
+	{
+		return false;
+	}
+
+	Data = File.GetData();
+	DataSize = File.GetSize();
+
+	if (!Parse())
+	{
+		UE_LOG(LogTemp, Error, TEXT("%s is not a valid experiment log."), *FilePath);
+		Close();
+		return false;
+	}
+
+	return true;
+}
+
+void FExperimentLogReader::Close()
+{
+	File.Close();
+	StateNames.Empty();
+	Data = nullptr;
+	DataSize = 0;
+	Header = nullptr;
+}
+
+bool FExperimentLogReader::FitsInData(uint64 Offset, uint64 Count, uint64 ElementSize) const
+{
+	// Written so a corrupt header cannot wrap the arithmetic around.
+	const uint64 Size = static_cast<uint64>(DataSize);
+	return Offset <= Size && Count <= (Size - Offset) / ElementSize;
+}
+
+bool FExperimentLogReader::Parse()
+{
+	if (DataSize < static_cast<int64>(sizeof(FExperimentLogHeader)))
+	{
+		return false;
+	}
+
+	const FExperimentLogHeader* Candidate = reinterpret_cast<const FExperimentLogHeader*>(Data);
+	if (Candidate->Magic != FExperimentLogHeader::MagicValue || Candidate->Version != FExperimentLogHeader::CurrentVersion)
+	{
+		return false;
+	}
+
+	const uint64 Count = Candidate->SampleCount;
+	const uint64 LocationSize = Candidate->bDoublePrecision ? sizeof(double) : sizeof(float);
+	if (Count > static_cast<uint64>(MAX_int32) ||
+		!FitsInData(Candidate->FrameColumnOffset, Count, sizeof(uint32)) ||
+		!FitsInData(Candidate->StateColumnOffset, Count, sizeof(uint8)) ||
+		Candidate->FrameColumnOffset % alignof(uint32) != 0)
+	{
+		return false;
+	}
+
+	for (int32 Axis = 0; Axis < 3; ++Axis)
+	{
+		const uint64 Offset = Candidate->LocationColumnOffsets[Axis];
+		if (Offset % 8 != 0 || !FitsInData(Offset, Count, LocationSize))
+		{
+			return false;
+		}
+	}
+
+	// Every state takes at least its length prefix.
+	if (!FitsInData(Candidate->StateTableOffset, Candidate->StateCount, sizeof(uint16)))
+	{
+		return false;
+	}
+
+	int64 StateOffset = static_cast<int64>(Candidate->StateTableOffset);
+	StateNames.Reserve(Candidate->StateCount);
+	for (uint32 i = 0; i < Candidate->StateCount; ++i)
+	{
+		uint16 Length = 0;
+		if (!FitsInData(StateOffset, 1, sizeof(Length)))
+		{
+			return false;
+		}
+		FMemory::Memcpy(&Length, Data + StateOffset, sizeof(Length));
+		StateOffset += sizeof(Length);
+
+		if (!FitsInData(StateOffset, Length, 1))
+		{
+			return false;
+		}
+		const FUTF8ToTCHAR Converter(reinterpret_cast<const ANSICHAR*>(Data + StateOffset), Length);
+		StateNames.Emplace(Converter.Length(), Converter.Get());
+		StateOffset += Length;
+	}
+
+	Header = Candidate;
+
+	return true;
+}
+
+int32 FExperimentLogReader::Num() const
+{
+	return Header ? static_cast<int32>(Header->SampleCount) : 0;
+}
+
+bool FExperimentLogReader::IsDoublePrecision() const
+{
+	return Header && Header->bDoublePrecision;
+}
+
+TArrayView<const uint32> FExperimentLogReader::GetFrameIndices() const
+{
+	if (!Header)
+	{
+		return TArrayView<const uint32>();
+	}
+	return TArrayView<const uint32>(reinterpret_cast<const uint32*>(Data + Header->FrameColumnOffset), Num());
+}
+
+TArrayView<const uint8> FExperimentLogReader::GetStateIds() const
+{
+	if (!Header)
+	{
+		return TArrayView<const uint8>();
+	}
+	return TArrayView<const uint8>(Data + Header->StateColumnOffset, Num());
+}
+
+TArrayView<const float> FExperimentLogReader::GetFloatColumn(int32 Axis) const
+{
+	if (!Header || Header->bDoublePrecision || Axis < 0 || Axis > 2)
+	{
+		return TArrayView<const float>();
+	}
+	return TArrayView<const float>(reinterpret_cast<const float*>(Data + Header->LocationColumnOffsets[Axis]), Num());
+}
+
+TArrayView<const double> FExperimentLogReader::GetDoubleColumn(int32 Axis) const
+{
+	if (!Header || !Header->bDoublePrecision || Axis < 0 || Axis > 2)
+	{
+		return TArrayView<const double>();
+	}
+	return TArrayView<const double>(reinterpret_cast<const double*>(Data + Header->LocationColumnOffsets[Axis]), Num());
+}
+
+FVector FExperimentLogReader::GetLocation(int32 Index) const
+{
+	check(Index >= 0 && Index < Num());
+
+	if (Header->bDoublePrecision)
+	{
+		return FVector(GetDoubleColumn(0)[Index], GetDoubleColumn(1)[Index], GetDoubleColumn(2)[Index]);
+	}
+	return FVector(GetFloatColumn(0)[Index], GetFloatColumn(1)[Index], GetFloatColumn(2)[Index]);
+}
+
+const FString& FExperimentLogReader::GetStateName(int32 Index) const
+{
+	static const FString Unknown;
+	const TArrayView<const uint8> StateIds = GetStateIds();
+	if (!StateIds.IsValidIndex(Index))
+	{
+		return Unknown;
+	}
+	const int32 StateId = StateIds[Index];
+	return StateNames.IsValidIndex(StateId) ? StateNames[StateId] : Unknown;
+}
+
+const TArray<FString>& FExperimentLogReader::GetStateNames() const
+{
+	return StateNames;
+}
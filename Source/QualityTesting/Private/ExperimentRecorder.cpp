@@ -0,0 +1,309 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "ExperimentRecorder.h"
+
+#include "FileHandlerComponent.h"
+#include "HAL/PlatformFilemanager.h"
+#include "HAL/RunnableThread.h"
+#include "Misc/Paths.h"
+#include "Misc/ScopeLock.h"
+
+namespace
+{
+	// Text is handed to the file in chunks of roughly this many characters.
+	constexpr int32 ChunkLength = 64 * 1024;
+	// Writer wakes up at least this often even if nobody triggers it.
+	constexpr uint32 WakeIntervalMs = 100;
+	// Game thread nudges the writer every this many pushed samples.
+	constexpr int64 SamplesPerWake = 256;
+}
+
+const TCHAR* FExperimentSample::OverflowStateName = TEXT("Overflow");
+
+uint8 FExperimentSample::InternState(TArray<FString>& StateNames, TMap<FString, uint8>& StateIds, const FString& StateName)
+{
+	if (const uint8* Found = StateIds.Find(StateName))
+	{
+		return *Found;
+	}
+
+	if (StateNames.Num() >= OverflowStateId)
+	{
+		// The last id names the overflow, so overflowed samples never alias a real state.
+		if (StateNames.Num() == OverflowStateId)
+		{
+			ensureMsgf(false, TEXT("More than %d distinct experiment states. Recording the rest as %s."),
+			           int32(OverflowStateId), OverflowStateName);
+			StateNames.Add(OverflowStateName);
+		}
+		return OverflowStateId;
+	}
+
+	const uint8 NewId = static_cast<uint8>(StateNames.Add(StateName));
+	StateIds.Add(StateName, NewId);
+
+	return NewId;
+}
+
+FExperimentRecorder::FExperimentRecorder(uint32 InCapacity)
+	: Ring(InCapacity + 1)
+	, Thread(nullptr)
+	, WakeEvent(FPlatformProcess::GetSynchEventFromPool(false))
+	, FlushedEvent(FPlatformProcess::GetSynchEventFromPool(false))
+	, RotateAtSample(0)
+{
+	ChunkText.Reserve(ChunkLength + 256);
+}
+
+FExperimentRecorder::~FExperimentRecorder()
+{
+	Close();
+
+	FPlatformProcess::ReturnSynchEventToPool(WakeEvent);
+	FPlatformProcess::ReturnSynchEventToPool(FlushedEvent);
+}
+
+bool FExperimentRecorder::Open(const FString& FilePath)
+{
+	if (IsOpen())
+	{
+		UE_LOG(LogTemp, Warning, TEXT("Recorder is already streaming. Close it before opening %s."), *FilePath);
+		return false;
+	}
+
+	if (!OpenFileHandle(FilePath))
+	{
+		return false;
+	}
+
+	bStopRequested = false;
+	PushedCount.Reset();
+	WrittenCount.Reset();
+	FlushRequestedAt.Reset();
+	DroppedCount.Reset();
+
+	Thread = FRunnableThread::Create(this, TEXT("ExperimentRecorder"), 0, TPri_BelowNormal);
+
+	return Thread != nullptr;
+}
+
+void FExperimentRecorder::Close()
+{
+	if (Thread)
+	{
+		Stop();
+		Thread->WaitForCompletion();
+		delete Thread;
+		Thread = nullptr;
+	}
+
+	if (FileHandle)
+	{
+		FileHandle->Flush();
+		FileHandle.Reset();
+	}
+
+	PendingFilePath.Empty();
+
+	if (DroppedCount.GetValue() > 0)
+	{
+		UE_LOG(LogTemp, Warning, TEXT("Recorder dropped %lld samples. Consider a larger ring capacity."),
+		       DroppedCount.GetValue());
+	}
+}
+
+bool FExperimentRecorder::Push(const FExperimentTextLine& TextLine)
+{
+	FExperimentSample Sample;
+	Sample.FrameIndex = static_cast<uint32>(GFrameCounter);
+	Sample.StateId = InternState(TextLine.ExperimentState);
+	Sample.Location = TextLine.Location;
+
+	return Push(Sample);
+}
+
+bool FExperimentRecorder::Push(const FExperimentSample& Sample)
+{
+	if (!Ring.Enqueue(Sample))
+	{
+		DroppedCount.Increment();
+		WakeEvent->Trigger();
+		return false;
+	}
+
+	if (PushedCount.Increment() % SamplesPerWake == 0)
+	{
+		WakeEvent->Trigger();
+	}
+
+	return true;
+}
+
+void FExperimentRecorder::Flush(bool bWait)
+{
+	const int64 Target = PushedCount.GetValue();
+	FlushRequestedAt.Set(Target);
+	WakeEvent->Trigger();
+
+	while (bWait && Thread && WrittenCount.GetValue() < Target)
+	{
+		FlushedEvent->Wait(WakeIntervalMs);
+	}
+}
+
+void FExperimentRecorder::Rotate(const FString& NewFilePath)
+{
+	{
+		FScopeLock Lock(&RotateLock);
+		PendingFilePath = NewFilePath;
+		RotateAtSample = PushedCount.GetValue();
+	}
+
+	WakeEvent->Trigger();
+}
+
+uint8 FExperimentRecorder::InternState(const FString& StateName)
+{
+	if (const uint8* Found = StateIds.Find(StateName))
+	{
+		return *Found;
+	}
+
+	FScopeLock Lock(&StateLock);
+
+	return FExperimentSample::InternState(StateNames, StateIds, StateName);
+}
+
+bool FExperimentRecorder::IsOpen() const
+{
+	return Thread != nullptr;
+}
+
+int64 FExperimentRecorder::GetDroppedCount() const
+{
+	return DroppedCount.GetValue();
+}
+
+uint32 FExperimentRecorder::Run()
+{
+	while (!bStopRequested)
+	{
+		WakeEvent->Wait(WakeIntervalMs);
+		Drain();
+	}
+
+	Drain();
+
+	return 0;
+}
+
+void FExperimentRecorder::Stop()
+{
+	bStopRequested = true;
+	WakeEvent->Trigger();
+}
+
+void FExperimentRecorder::Drain()
+{
+	int64 Consumed = WrittenCount.GetValue();
+	FExperimentSample Sample;
+
+	for (;;)
+	{
+		{
+			FScopeLock Lock(&RotateLock);
+			if (!PendingFilePath.IsEmpty() && Consumed >= RotateAtSample)
+			{
+				WriteChunk();
+				WrittenCount.Set(Consumed);
+				OpenFileHandle(PendingFilePath);
+				PendingFilePath.Empty();
+			}
+		}
+
+		if (!Ring.Dequeue(Sample))
+		{
+			break;
+		}
+
+		ChunkText += FString::Printf(TEXT("%s, %f, %f, %f") LINE_TERMINATOR, *GetStateName(Sample.StateId),
+		                             Sample.Location.X, Sample.Location.Y, Sample.Location.Z);
+		++Consumed;
+
+		if (ChunkText.Len() >= ChunkLength)
+		{
+			WriteChunk();
+			WrittenCount.Set(Consumed);
+		}
+	}
+
+	WriteChunk();
+	WrittenCount.Set(Consumed);
+
+	const int64 FlushTarget = FlushRequestedAt.GetValue();
+	if (FlushTarget > 0 && Consumed >= FlushTarget)
+	{
+		if (FileHandle)
+		{
+			FileHandle->Flush();
+		}
+		FlushRequestedAt.Reset();
+		FlushedEvent->Trigger();
+	}
+}
+
+bool FExperimentRecorder::WriteChunk()
+{
+	if (ChunkText.IsEmpty())
+	{
+		return true;
+	}
+
+	bool bSuccess = false;
+	if (FileHandle)
+	{
+		const FTCHARToUTF8 Converter(*ChunkText, ChunkText.Len());
+		bSuccess = FileHandle->Write(reinterpret_cast<const uint8*>(Converter.Get()), Converter.Length());
+	}
+
+	if (!bSuccess)
+	{
+		UE_LOG(LogTemp, Error, TEXT("Recorder failed to write %d characters."), ChunkText.Len());
+	}
+
+	ChunkText.Reset(ChunkLength + 256);
+
+	return bSuccess;
+}
+
+bool FExperimentRecorder::OpenFileHandle(const FString& FilePath)
+{
+	auto& FileManager = FPlatformFileManager::Get().GetPlatformFile();
+
+	FileHandle.Reset();
+	FileManager.CreateDirectoryTree(*FPaths::GetPath(FilePath));
+	FileHandle.Reset(FileManager.OpenWrite(*FilePath, true));
+
+	if (!FileHandle)
+	{
+		UE_LOG(LogTemp, Error, TEXT("Cannot open %s for streaming."), *FilePath);
+		return false;
+	}
+
+	UE_LOG(LogTemp, Log, TEXT("Streaming experiment samples to %s."), *FilePath);
+
+	return true;
+}
+
+const FString& FExperimentRecorder::GetStateName(uint8 StateId)
+{
+	if (StateId >= WriterStateNames.Num())
+	{
+		FScopeLock Lock(&StateLock);
+		WriterStateNames = StateNames;
+	}
+
+	static const FString Unknown;
+	return WriterStateNames.IsValidIndex(StateId) ? WriterStateNames[StateId] : Unknown;
+}
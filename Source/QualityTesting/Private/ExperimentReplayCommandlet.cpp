@@ -0,0 +1,131 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "ExperimentReplayCommandlet.h"
+
+#include "Engine/Engine.h"
+#include "Engine/World.h"
+#include "ExperimentExecutionComponent.h"
+#include "ExperimentJournal.h"
+#include "FileHandlerComponent.h"
+#include "PhysicsBodyInterface.h"
+
+namespace
+{
+	const TCHAR* DefaultProbeClass = TEXT("/Game/Blueprints/Player/BP_Mover.BP_Mover_C");
+}
+
+UExperimentReplayCommandlet::UExperimentReplayCommandlet()
+{
+	IsClient = false;
+	IsServer = false;
+	LogToConsole = true;
+
+	HelpDescription = TEXT("Replays a recorded experiment journal headless and writes the replayed trajectory.");
+	HelpUsage = TEXT("-run=ExperimentReplay -nullrhi -Journal=<path> [-ProbeClass=<class path>] "
+		"[-Output=Replay/Session] [-Binary] [-Repeat=1] [-MaxDeviation=<cm>]");
+}
+
+int32 UExperimentReplayCommandlet::Main(const FString& Params)
+{
+	FString JournalPath;
+	FString ProbeClassPath = DefaultProbeClass;
+	FString OutputName = TEXT("Replay/Session");
+	int32 Repeat = 1;
+	float MaxDeviation = -1.f;
+
+	if (!FParse::Value(*Params, TEXT("Journal="), JournalPath))
+	{
+		UE_LOG(LogTemp, Error, TEXT("Usage: %s"), *HelpUsage);
+		return 1;
+	}
+
+	FParse::Value(*Params, TEXT("ProbeClass="), ProbeClassPath);
+	FParse::Value(*Params, TEXT("Output="), OutputName);
+	FParse::Value(*Params, TEXT("Repeat="), Repeat);
+	FParse::Value(*Params, TEXT("MaxDeviation="), MaxDeviation);
+	const bool bBinaryOutput = FParse::Param(*Params, TEXT("Binary"));
+
+	const TSharedRef<FExperimentJournal> Journal = MakeShared<FExperimentJournal>();
+	if (!Journal->LoadFromFile(JournalPath))
+	{
+		return 1;
+	}
+
+	UClass* ProbeClass = LoadClass<AActor>(nullptr, *ProbeClassPath);
+	if (!ProbeClass || !ProbeClass->ImplementsInterface(UPhysicsBodyInterface::StaticClass()))
+	{
+		UE_LOG(LogTemp, Error, TEXT("%s is not an actor class implementing PhysicsBodyInterface."), *ProbeClassPath);
+		return 1;
+	}
+
+	UWorld* World = UWorld::CreateWorld(EWorldType::Game, false, TEXT("ExperimentReplay"));
+	FWorldContext& WorldContext = GEngine->CreateNewWorldContext(EWorldType::Game);
+	WorldContext.SetCurrentWorld(World);
+	World->InitializeActorsForPlay(FURL());
+	World->BeginPlay();
+
+	int32 Failed = 0;
+	AActor* Probe = World->SpawnActor<AActor>(ProbeClass, FTransform::Identity);
+
+	if (Probe)
+	{
+		// Own components, so the probe's Blueprint bindings on its built-in ones do not fire.
+		UExperimentExecutionComponent* Execution = NewObject<UExperimentExecutionComponent>(Probe);
+		UFileHandlerComponent* FileHandler = NewObject<UFileHandlerComponent>(Probe);
+		Execution->RegisterComponent();
+		FileHandler->RegisterComponent();
+
+		FExperimentTextLine Line;
+		const UEnum* StateEnum = StaticEnum<EExperimentState>();
+		const float Duration = Journal->GetDuration();
+
+		for (int32 Run = 0; Run < FMath::Max(Repeat, 1); ++Run)
+		{
+			FileHandler->ClearWriteQueue();
+			if (!Execution->StartReplayFromJournal(Journal, Probe))
+			{
+				Failed++;
+				break;
+			}
+
+			const double StartSeconds = FPlatformTime::Seconds();
+			for (const FExperimentJournalTick& Tick : Journal->Ticks)
+			{
+				World->Tick(LEVELTICK_All, Tick.DeltaTime);
+
+				Line.ExperimentState = StateEnum->GetNameStringByValue(static_cast<int64>(Execution->GetCurrentState()));
+				Line.Location = Probe->GetActorLocation();
+				FileHandler->AddToWriteQueue(Line);
+			}
+			const double Seconds = FPlatformTime::Seconds() - StartSeconds;
+
+			UE_LOG(LogTemp, Display, TEXT("Replayed %d ticks (%.2f s of session) in %.3f s, x%.1f real time. Max deviation %f."),
+			       Journal->Ticks.Num(), Duration, Seconds, Duration / FMath::Max(Seconds, 1e-6), Execution->GetReplayDeviation());
+
+			if (MaxDeviation >= 0.f && Execution->GetReplayDeviation() > MaxDeviation)
+			{
+				UE_LOG(LogTemp, Error, TEXT("Replay deviated %f from the recorded trajectory, more than %f allowed."),
+				       Execution->GetReplayDeviation(), MaxDeviation);
+				Failed++;
+			}
+		}
+
+		Execution->SetComponentTickEnabled(false);
+
+		const bool bSaved = bBinaryOutput
+			                    ? FileHandler->SaveToBinaryFile(OutputName, TEXT("qtl"), false)
+			                    : FileHandler->SaveToFile(OutputName, TEXT("csv"));
+		Failed += bSaved ? 0 : 1;
+	}
+	else
+	{
+		UE_LOG(LogTemp, Error, TEXT("Couldn't spawn probe %s."), *ProbeClassPath);
+		Failed++;
+	}
+
+	World->DestroyWorld(false);
+	GEngine->DestroyWorldContext(World);
+
+	return Failed > 0 ? 1 : 0;
+}
@@ -0,0 +1,130 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "ExperimentSubsystem.h"
+
+#include "Async/ParallelFor.h"
+#include "Engine/World.h"
+#include "ExperimentExecutionComponent.h"
+
+namespace
+{
+	TAutoConsoleVariable<int32> CVarBatchParallelThreshold(
+		TEXT("QualityTesting.BatchParallelThreshold"),
+		32,
+		TEXT("Batched experiments are advanced on worker threads from this many on. 0 disables it."));
+}
+
+void FExperimentBatchTickFunction::ExecuteTick(float DeltaTime, ELevelTick TickType, ENamedThreads::Type CurrentThread,
+                                               const FGraphEventRef& MyCompletionGraphEvent)
+{
+	if (Target && TickType != LEVELTICK_ViewportsOnly)
+	{
+		Target->TickExperiments(DeltaTime);
+	}
+}
+
+FString FExperimentBatchTickFunction::DiagnosticMessage()
+{
+	return TEXT("UExperimentSubsystem::TickExperiments");
+}
+
+void UExperimentSubsystem::Deinitialize()
+{
+	if (BatchTickFunction.IsTickFunctionRegistered())
+	{
+		BatchTickFunction.UnRegisterTickFunction();
+	}
+
+	Experiments.Reset();
+	TickingExperiments.Reset();
+
+	Super::Deinitialize();
+}
+
+void UExperimentSubsystem::RegisterExperiment(UExperimentExecutionComponent* Experiment)
+{
+	if (!BatchTickFunction.IsTickFunctionRegistered())
+	{
+		// Same group as component ticks, so forces still reach the body in the frame they are computed.
+		BatchTickFunction.Target = this;
+		BatchTickFunction.TickGroup = TG_PrePhysics;
+		BatchTickFunction.bCanEverTick = true;
+		BatchTickFunction.bStartWithTickEnabled = true;
+		BatchTickFunction.RegisterTickFunction(GetWorld()->PersistentLevel);
+	}
+
+	Experiments.AddUnique(Experiment);
+	bExperimentsChanged = true;
+}
+
+void UExperimentSubsystem::UnregisterExperiment(UExperimentExecutionComponent* Experiment)
+{
+	bExperimentsChanged |= Experiments.Remove(Experiment) > 0;
+}
+
+void UExperimentSubsystem::TickExperiments(float DeltaTime)
+{
+	if (Experiments.Num() == 0)
+	{
+		return;
+	}
+
+	// Only experiments that are still valid take part, so the parallel advance below needs no checks.
+	TickingExperiments.Reset();
+	for (UExperimentExecutionComponent* Experiment : Experiments)
+	{
+		if (IsValid(Experiment))
+		{
+			Experiment->GatherBodyState(DeltaTime);
+			TickingExperiments.Add(Experiment);
+		}
+	}
+	const int32 Num = TickingExperiments.Num();
+
+	const int32 ParallelThreshold = CVarBatchParallelThreshold.GetValueOnGameThread();
+	ParallelFor(Num, [this, DeltaTime](int32 i)
+	{
+		TickingExperiments[i]->AdvanceExperiment(DeltaTime);
+	}, ParallelThreshold <= 0 || Num < ParallelThreshold);
+
+	// Listeners run from here on and may set experiments up again, so each one is checked
+	// for still being registered before it is touched.
+	FinishedExperiments.Reset();
+	bExperimentsChanged = false;
+	for (UExperimentExecutionComponent* Experiment : TickingExperiments)
+	{
+		if (!IsValid(Experiment) || (bExperimentsChanged && !Experiments.Contains(Experiment)))
+		{
+			continue;
+		}
+
+		Experiment->ApplyBodyCommands();
+
+		if (Experiment->OnComponentUpdate.IsBound())
+		{
+			Experiment->OnComponentUpdate.Broadcast(Experiment->GetCurrentTime());
+		}
+		if (Experiment->GetCurrentState() == EExperimentState::Finished)
+		{
+			Experiments.Remove(Experiment);
+			FinishedExperiments.Add(Experiment);
+		}
+	}
+
+	// A finished experiment is reported once and leaves the batch.
+	for (UExperimentExecutionComponent* Experiment : FinishedExperiments)
+	{
+		Experiment->OnComponentFinished.Broadcast();
+	}
+
+	if (OnBatchUpdated.IsBound())
+	{
+		OnBatchUpdated.Broadcast(Experiments.Num());
+	}
+}
+
+int32 UExperimentSubsystem::GetNumActiveExperiments() const
+{
+	return Experiments.Num();
+}
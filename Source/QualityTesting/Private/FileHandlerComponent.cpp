@@ -2,29 +2,325 @@
 
 
 #include "FileHandlerComponent.h"
+#include "Async/Async.h"
+#include "ExperimentLogFormat.h"
 #include "Misc/Paths.h"
 
+namespace
+{
+	/**
+	 * Single pass reader for comma separated numeric schedules.
+	 * Works directly on the file bytes, nothing is allocated per line or per value.
+	 */
+	class FScheduleTokenizer
+	{
+	public:
+		FScheduleTokenizer(const ANSICHAR* InBegin, int64 InSize)
+			: Cursor(InBegin)
+			, End(InBegin + InSize)
+			, LineNumber(0)
+			, bLineBlank(true)
+			, LineError(nullptr)
+		{
+			// Skip UTF-8 BOM.
+			if (InSize >= 3 && uint8(Cursor[0]) == 0xEF && uint8(Cursor[1]) == 0xBB && uint8(Cursor[2]) == 0xBF) {
+				Cursor += 3;
+			}
+		}
+
+		bool HasUnicodeBOM() const
+		{
+			return End - Cursor >= 2 &&
+				((uint8(Cursor[0]) == 0xFF && uint8(Cursor[1]) == 0xFE) || (uint8(Cursor[0]) == 0xFE && uint8(Cursor[1]) == 0xFF));
+		}
+
+		int32 CountLines() const
+		{
+			int32 Lines = 0;
+			for (const ANSICHAR* It = Cursor; It < End; ++It) {
+				Lines += *It == '\n';
+			}
+			return Lines + 1;
+		}
+
+		bool IsAtEnd() const { return Cursor >= End; }
+		int32 GetLineNumber() const { return LineNumber; }
+		bool WasLineBlank() const { return bLineBlank; }
+		bool HasLineError() const { return LineError != nullptr; }
+
+		FString DescribeLineError(int32 Count) const
+		{
+			if (LineError) {
+				return FString::Printf(TEXT("%s after value %d"), UTF8_TO_TCHAR(LineError), Count);
+			}
+			return FString::Printf(TEXT("got %d"), Count);
+		}
+
+		// Parses values of the next line, consuming it. Returns how many values were found.
+		int32 ParseLine(float* OutValues, int32 MaxValues)
+		{
+			++LineNumber;
+			bLineBlank = true;
+			LineError = nullptr;
+
+			int32 Count = 0;
+			for (;;) {
+				SkipSpaces();
+				if (IsLineEnd()) {
+					break;
+				}
+				bLineBlank = false;
+
+				double Value;
+				if (!ParseNumber(Value)) {
+					LineError = "not a number";
+					break;
+				}
+				if (Count < MaxValues) {
+					OutValues[Count] = static_cast<float>(Value);
+				}
+				++Count;
+
+				SkipSpaces();
+				if (IsLineEnd()) {
+					break;
+				}
+				if (*Cursor != ',') {
+					LineError = "unexpected character";
+					break;
+				}
+				++Cursor;
+			}
+
+			SkipToNextLine();
+			return Count;
+		}
+
+	private:
+		bool IsLineEnd() const
+		{
+			return Cursor >= End || *Cursor == '\n' || *Cursor == '\r';
+		}
+
+		void SkipSpaces()
+		{
+			while (Cursor < End && (*Cursor == ' ' || *Cursor == '\t')) {
+				++Cursor;
+			}
+		}
+
+		void SkipToNextLine()
+		{
+			while (Cursor < End && *Cursor != '\n') {
+				++Cursor;
+			}
+			if (Cursor < End) {
+				++Cursor;
+			}
+		}
+
+		static bool IsDigit(ANSICHAR Char)
+		{
+			return Char >= '0' && Char <= '9';
+		}
+
+		static double Pow10(int32 Exponent)
+		{
+			double Result = 1.0;
+			double Base = 10.0;
+			for (uint32 Remaining = Exponent; Remaining != 0; Remaining >>= 1) {
+				if (Remaining & 1) {
+					Result *= Base;
+				}
+				Base *= Base;
+			}
+			return Result;
+		}
+
+		bool ParseNumber(double& OutValue)
+		{
+			const ANSICHAR* Start = Cursor;
+			bool bNegative = false;
+			if (Cursor < End && (*Cursor == '-' || *Cursor == '+')) {
+				bNegative = *Cursor == '-';
+				++Cursor;
+			}
+
+			uint64 Mantissa = 0;
+			int32 Exponent = 0;
+			int32 Digits = 0;
+			for (; Cursor < End && IsDigit(*Cursor); ++Cursor, ++Digits) {
+				if (Mantissa < (MAX_uint64 - 9) / 10) {
+					Mantissa = Mantissa * 10 + (*Cursor - '0');
+				}
+				else {
+					++Exponent;
+				}
+			}
+
+			if (Cursor < End && *Cursor == '.') {
+				++Cursor;
+				for (; Cursor < End && IsDigit(*Cursor); ++Cursor, ++Digits) {
+					if (Mantissa < (MAX_uint64 - 9) / 10) {
+						Mantissa = Mantissa * 10 + (*Cursor - '0');
+						--Exponent;
+					}
+				}
+			}
+
+			if (Digits == 0) {
+				Cursor = Start;
+				return false;
+			}
+
+			if (Cursor < End && (*Cursor == 'e' || *Cursor == 'E')) {
+				const ANSICHAR* ExponentStart = Cursor++;
+				bool bNegativeExponent = false;
+				if (Cursor < End && (*Cursor == '-' || *Cursor == '+')) {
+					bNegativeExponent = *Cursor == '-';
+					++Cursor;
+				}
+				if (Cursor >= End || !IsDigit(*Cursor)) {
+					Cursor = ExponentStart;
+					return false;
+				}
+				int32 ExplicitExponent = 0;
+				for (; Cursor < End && IsDigit(*Cursor); ++Cursor) {
+					ExplicitExponent = FMath::Min(ExplicitExponent * 10 + (*Cursor - '0'), 9999);
+				}
+				Exponent += bNegativeExponent ? -ExplicitExponent : ExplicitExponent;
+			}
+
+			const double Magnitude = static_cast<double>(Mantissa);
+			OutValue = Exponent < 0 ? Magnitude / Pow10(-Exponent) : Magnitude * Pow10(Exponent);
+			if (bNegative) {
+				OutValue = -OutValue;
+			}
+
+			return true;
+		}
+
+		const ANSICHAR* Cursor;
+		const ANSICHAR* End;
+		int32 LineNumber;
+		bool bLineBlank;
+		const ANSICHAR* LineError;
+	};
+}
+
+FPerturbationsInfo FPerturbationRecord::ToPerturbationsInfo() const
+{
+	FPerturbationsInfo Ret;
+	Ret.PerturbationsScaleList.Append(PerturbationsScale, 2);
+	Ret.TorqueScaleList.Append(TorqueScale, 2);
+
+	return Ret;
+}
+
 // Sets default values for this component's properties
 UFileHandlerComponent::UFileHandlerComponent()
 {
 	// Set this component to be initialized when the game starts, and to be ticked every frame.  You can turn these features
 	// off to improve performance if you don't need them.
 	PrimaryComponentTick.bCanEverTick = false;
+
+	ScheduleOffset = FVector::ZeroVector;
 }
 
 void UFileHandlerComponent::AddToWriteQueue(const FExperimentTextLine& TextLine)
 {
-	this->WriteCache.Add(SerializeTextLine(TextLine));
+	if (IsStreaming()) {
+		this->Recorder->Push(TextLine);
+	}
+	else {
+		FExperimentSample Sample;
+		Sample.FrameIndex = static_cast<uint32>(GFrameCounter);
+		Sample.StateId = InternState(TextLine.ExperimentState);
+		Sample.Location = TextLine.Location;
+		this->WriteCache.Add(Sample);
+	}
+}
+
+void UFileHandlerComponent::ClearWriteQueue()
+{
+	this->WriteCache.Reset();
+}
+
+uint8 UFileHandlerComponent::InternState(const FString& ExperimentState)
+{
+	return FExperimentSample::InternState(this->WriteStateNames, this->WriteStateIds, ExperimentState);
+}
+
+bool UFileHandlerComponent::StartStreaming(const FString& FileName, const FString& FileExtension, int32 Capacity)
+{
+	if (IsStreaming()) {
+		UE_LOG(LogTemp, Warning, TEXT("Already streaming. Use RotateStream to switch files."));
+		return false;
+	}
+
+	this->Recorder = MakeShared<FExperimentRecorder>(FMath::Max(Capacity, 1));
+
+	if (!this->Recorder->Open(MakeResultPath(FileName, FileExtension))) {
+		this->Recorder.Reset();
+		return false;
+	}
+
+	return true;
+}
+
+void UFileHandlerComponent::StopStreaming()
+{
+	if (this->Recorder) {
+		this->Recorder->Close();
+		this->Recorder.Reset();
+	}
+}
+
+void UFileHandlerComponent::FlushStream(bool bWait)
+{
+	if (IsStreaming()) {
+		this->Recorder->Flush(bWait);
+	}
+}
+
+bool UFileHandlerComponent::RotateStream(const FString& FileName, const FString& FileExtension)
+{
+	if (!IsStreaming()) {
+		UE_LOG(LogTemp, Error, TEXT("Cannot rotate to %s. Streaming is not started."), *FileName);
+		return false;
+	}
+
+	this->Recorder->Rotate(MakeResultPath(FileName, FileExtension));
+
+	return true;
+}
+
+bool UFileHandlerComponent::IsStreaming() const
+{
+	return this->Recorder.IsValid() && this->Recorder->IsOpen();
+}
+
+void UFileHandlerComponent::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+	StopStreaming();
+
+	// Saves own their data and outlive the component, but queued thread pool work is abandoned on exit.
+	if (EndPlayReason == EEndPlayReason::Quit) {
+		WaitForPendingSaves();
+	}
+
+	Super::EndPlay(EndPlayReason);
 }
 
 
 bool UFileHandlerComponent::ReadFromFile(const FString& FilePath)
 {
-	auto& FileManager = FPlatformFileManager::Get().GetPlatformFile();
-	bool bSuccess = false;
+	FMappedFileView File;
+	bool bSuccess = File.Open(FilePath);
 
-	if (FileManager.FileExists(*FilePath)) {
-		bSuccess = FFileHelper::LoadFileToStringArray(this->ReadCache, *FilePath);
+	if (bSuccess) {
+		this->ScheduleInfos.Empty();
+		bSuccess = ParseSchedule(File.GetData(), File.GetSize(), FilePath, this->ScheduleOffset, this->Schedule);
 
 		if (bSuccess) {
 			UE_LOG(LogTemp, Log, TEXT("File successfully read."));
@@ -33,45 +329,93 @@ bool UFileHandlerComponent::ReadFromFile(const FString& FilePath)
 			UE_LOG(LogTemp, Error, TEXT("Something went wrong. Couldn't read file %s."), *FilePath);
 		}
 	}
-	else {
-		UE_LOG(LogTemp, Error, TEXT("Cannot open %s for reading. File does not exist."), *FilePath);
-	}
 
 	return bSuccess;
 }
 
-FString UFileHandlerComponent::SerializeTextLine(const FExperimentTextLine& TextLine)
+FString UFileHandlerComponent::MakeResultPath(const FString& FileName, const FString& FileExtension)
+{
+	const FString BaseDir = FPaths::Combine(FPaths::ProjectSavedDir(), "Results");
+	return FPaths::Combine(BaseDir, FString::Printf(TEXT("%s.%s"), *FileName, *FileExtension));
+}
+
+FString UFileHandlerComponent::SerializeTextLine(const FString& ExperimentState, const FVector& Location)
 {
-	return FString::Printf(TEXT("%s, %f, %f, %f"), *TextLine.ExperimentState, TextLine.Location.X, TextLine.Location.Y, TextLine.Location.Z);
+	return FString::Printf(TEXT("%s, %f, %f, %f"), *ExperimentState, Location.X, Location.Y, Location.Z);
 
 }
 
-FPerturbationsInfo UFileHandlerComponent::DeserializeTextLine(const FString& TextLine)
+bool UFileHandlerComponent::ParseSchedule(const uint8* Data, int64 Size, const FString& SourceName,
+                                          FVector& OutOffset, TArray<FPerturbationRecord>& OutRecords)
 {
-	FPerturbationsInfo Ret;
-	TArray<FString> Splitted;
-	
-	TextLine.ParseIntoArray(Splitted, TEXT(","));
+	FScheduleTokenizer Tokenizer(reinterpret_cast<const ANSICHAR*>(Data), Size);
 
-	for (int i = 0; i < 2; ++i) {
-		Ret.PerturbationsScaleList.Add(FCString::Atof(*Splitted[i]));
+	if (Tokenizer.HasUnicodeBOM()) {
+		UE_LOG(LogTemp, Error, TEXT("%s: UTF-16/32 schedules are not supported, save the file as ASCII or UTF-8."), *SourceName);
+		return false;
 	}
 
-	for (int i = 0; i < 2; ++i) {
-		Ret.TorqueScaleList.Add(FCString::Atof(*Splitted[2 + i]));
+	OutRecords.Reset(Tokenizer.CountLines());
+	OutOffset = FVector::ZeroVector;
+
+	bool bHasOffset = false;
+	int32 MalformedLines = 0;
+	float Values[4];
+
+	while (!Tokenizer.IsAtEnd()) {
+		const int32 Count = Tokenizer.ParseLine(Values, 4);
+		const int32 LineNumber = Tokenizer.GetLineNumber();
+
+		if (Count == 0 && Tokenizer.WasLineBlank()) {
+			continue;
+		}
+
+		const int32 Expected = bHasOffset ? 4 : 3;
+		if (Count != Expected || Tokenizer.HasLineError()) {
+			UE_LOG(LogTemp, Warning, TEXT("%s(%d): expected %d comma separated numbers, %s. Line skipped."),
+			       *SourceName, LineNumber, Expected, *Tokenizer.DescribeLineError(Count));
+			MalformedLines++;
+			continue;
+		}
+
+		if (!bHasOffset) {
+			OutOffset = FVector(Values[0], Values[1], Values[2]);
+			bHasOffset = true;
+		}
+		else {
+			FPerturbationRecord& Record = OutRecords.AddUninitialized_GetRef();
+			Record.PerturbationsScale[0] = Values[0];
+			Record.PerturbationsScale[1] = Values[1];
+			Record.TorqueScale[0] = Values[2];
+			Record.TorqueScale[1] = Values[3];
+		}
 	}
 
-	return Ret;
+	if (MalformedLines > 0) {
+		UE_LOG(LogTemp, Warning, TEXT("%s: %d malformed lines skipped, %d perturbations loaded."),
+		       *SourceName, MalformedLines, OutRecords.Num());
+	}
+
+	return bHasOffset;
 }
 
 bool UFileHandlerComponent::SaveToFile(const FString& FileName, const FString& FileExtension)
 {
-	const FString BaseDir = FPaths::Combine(FPaths::ProjectSavedDir(), "Results");
-	FString AbsolutePath = FPaths::Combine(BaseDir, FString::Printf(TEXT("%s.%s"), *FileName, *FileExtension));
-	
-	auto& FileManager = FPlatformFileManager::Get().GetPlatformFile();
+	return SaveSamplesToFile(MakeResultPath(FileName, FileExtension), this->WriteCache, this->WriteStateNames);
+}
 
-	bool bSuccess = FFileHelper::SaveStringArrayToFile(this->WriteCache, *AbsolutePath);
+bool UFileHandlerComponent::SaveSamplesToFile(const FString& AbsolutePath, TArrayView<const FExperimentSample> Samples,
+                                              const TArray<FString>& StateNames)
+{
+	static const FString UnknownState;
+	TArray<FString> Lines;
+	Lines.Reserve(Samples.Num());
+	for (const FExperimentSample& Sample : Samples) {
+		const FString& State = StateNames.IsValidIndex(Sample.StateId) ? StateNames[Sample.StateId] : UnknownState;
+		Lines.Add(SerializeTextLine(State, Sample.Location));
+	}
+
+	bool bSuccess = FFileHelper::SaveStringArrayToFile(Lines, *AbsolutePath);
 
 	if (!bSuccess) {
 		UE_LOG(LogTemp, Error, TEXT("Couldn't write to file %s. Write failed."), *AbsolutePath);
@@ -83,22 +427,128 @@ bool UFileHandlerComponent::SaveToFile(const FString& FileName, const FString& F
 	return bSuccess;
 }
 
-TArray<FPerturbationsInfo> UFileHandlerComponent::GetPerturbationsInfo(FVector& OutOffset) const
+bool UFileHandlerComponent::SaveToBinaryFile(const FString& FileName, const FString& FileExtension, bool bDoublePrecision)
 {
-	TArray<FPerturbationsInfo> Ret;
+	FString AbsolutePath = MakeResultPath(FileName, FileExtension);
 
-	for (int32 i = 0; i < ReadCache.Num(); ++i) {
-		if (i == 0) {
-			TArray<FString> Splitted;
-			ReadCache[i].ParseIntoArray(Splitted, TEXT(","));
-			OutOffset.X = FCString::Atof(*Splitted[0]);
-			OutOffset.Y = FCString::Atof(*Splitted[1]);
-			OutOffset.Z = FCString::Atof(*Splitted[2]);
-		}
-		else {
-			Ret.Add(DeserializeTextLine(ReadCache[i]));
+	bool bSuccess = FExperimentLogWriter::SaveToFile(AbsolutePath, this->WriteCache, this->WriteStateNames, bDoublePrecision);
+
+	if (bSuccess) {
+		UE_LOG(LogTemp, Log, TEXT("Successfully saved file %s."), *AbsolutePath);
+	}
+
+	return bSuccess;
+}
+
+void UFileHandlerComponent::SaveToFileAsync(const FString& FileName, const FString& FileExtension,
+                                            EResultCompression Compression)
+{
+	LaunchSave(MakeResultPath(FileName, FileExtension), false, false, Compression);
+}
+
+void UFileHandlerComponent::SaveToBinaryFileAsync(const FString& FileName, const FString& FileExtension,
+                                                  bool bDoublePrecision, EResultCompression Compression)
+{
+	LaunchSave(MakeResultPath(FileName, FileExtension), true, bDoublePrecision, Compression);
+}
+
+void UFileHandlerComponent::LaunchSave(const FString& AbsolutePath, bool bBinary, bool bDoublePrecision,
+                                       EResultCompression Compression)
+{
+	this->PendingSaves.RemoveAll([](const TFuture<bool>& Save) { return Save.IsReady(); });
+
+	TWeakObjectPtr<UFileHandlerComponent> WeakThis(this);
+
+	this->PendingSaves.Add(Async(EAsyncExecution::ThreadPool,
+		[WeakThis, AbsolutePath, bBinary, bDoublePrecision, Compression,
+		 Samples = MoveTemp(this->WriteCache), StateNames = this->WriteStateNames]() -> bool
+		{
+			TArray<uint8> Payload;
+			if (bBinary) {
+				FExperimentLogWriter::Serialize(Samples, StateNames, bDoublePrecision, Payload);
+			}
+			else {
+				SerializeSamplesToText(Samples, StateNames, Payload);
+			}
+
+			TArray<uint8> FileData;
+			bool bSuccess = FCompressedResult::Compress(Compression, Payload, FileData);
+			bSuccess = bSuccess && FFileHelper::SaveArrayToFile(FileData, *AbsolutePath);
+
+			if (!bSuccess) {
+				UE_LOG(LogTemp, Error, TEXT("Couldn't write to file %s. Write failed."), *AbsolutePath);
+			}
+			else {
+				UE_LOG(LogTemp, Log, TEXT("Successfully saved file %s (%d samples, %d of %d bytes)."),
+				       *AbsolutePath, Samples.Num(), FileData.Num(), Payload.Num());
+			}
+
+			AsyncTask(ENamedThreads::GameThread, [WeakThis, AbsolutePath, bSuccess]()
+			{
+				if (UFileHandlerComponent* This = WeakThis.Get()) {
+					This->OnSaveCompleted.Broadcast(AbsolutePath, bSuccess);
+				}
+			});
+
+			return bSuccess;
+		}));
+
+	this->WriteCache.Reset();
+}
+
+void UFileHandlerComponent::WaitForPendingSaves()
+{
+	for (const TFuture<bool>& Save : this->PendingSaves) {
+		Save.Wait();
+	}
+
+	this->PendingSaves.Reset();
+}
+
+int32 UFileHandlerComponent::GetNumPendingSaves() const
+{
+	int32 NumPending = 0;
+	for (const TFuture<bool>& Save : this->PendingSaves) {
+		NumPending += Save.IsReady() ? 0 : 1;
+	}
+
+	return NumPending;
+}
+
+void UFileHandlerComponent::SerializeSamplesToText(TArrayView<const FExperimentSample> Samples,
+                                                   const TArray<FString>& StateNames, TArray<uint8>& OutBuffer)
+{
+	static const FString UnknownState;
+	FString Text;
+	Text.Reserve(Samples.Num() * 48);
+	for (const FExperimentSample& Sample : Samples) {
+		const FString& State = StateNames.IsValidIndex(Sample.StateId) ? StateNames[Sample.StateId] : UnknownState;
+		Text += SerializeTextLine(State, Sample.Location);
+		Text += LINE_TERMINATOR;
+	}
+
+	const FTCHARToUTF8 Converter(*Text, Text.Len());
+	OutBuffer.Reset(Converter.Length());
+	OutBuffer.Append(reinterpret_cast<const uint8*>(Converter.Get()), Converter.Length());
+}
+
+TArray<FPerturbationsInfo> UFileHandlerComponent::GetPerturbationsInfo(FVector& OutOffset) const
+{
+	if (this->ScheduleInfos.Num() != this->Schedule.Num()) {
+		this->ScheduleInfos.Reset(this->Schedule.Num());
+		for (const FPerturbationRecord& Record : this->Schedule) {
+			this->ScheduleInfos.Add(Record.ToPerturbationsInfo());
 		}
 	}
 
-	return Ret;
+	OutOffset = this->ScheduleOffset;
+
+	return this->ScheduleInfos;
+}
+
+const TArray<FPerturbationRecord>& UFileHandlerComponent::GetPerturbationRecords(FVector& OutOffset) const
+{
+	OutOffset = this->ScheduleOffset;
+
+	return this->Schedule;
 }
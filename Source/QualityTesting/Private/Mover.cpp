@@ -4,12 +4,15 @@
 #include "Mover.h"
 #include "Engine/StaticMesh.h"
 #include "Engine/World.h"
+#include "PhysicsBodyInterface.h"
 
 // Sets default values
 AMover::AMover()
 {
  	// Set this actor to call Tick() every frame.  You can turn this off to improve performance if you don't need it.
 	PrimaryActorTick.bCanEverTick = true;
+	// The motion snapshot may only change while physics is not running.
+	PrimaryActorTick.TickGroup = TG_PrePhysics;
 	
 	struct FConstructorStatics
 	{
@@ -30,6 +33,14 @@ AMover::AMover()
 	ProbeMesh->BodyInstance.bOverrideMass = true;
 	ProbeMesh->BodyInstance.SetMassOverride(225.f);
 	RootComponent = ProbeMesh;
+
+	AccelerationTime = DriftTime = DeccelerationTime = 0.f;
+	ForceScale = TorqueScale = PerturbationsScale = 0.f;
+	InertiaTensor = FVector::OneVector;
+	MotionPhase = EMovementPhase::Idle;
+	MotionTime = SubstepTime = 0.f;
+	bMotionActive = false;
+	OnCalculateCustomPhysics.BindUObject(this, &AMover::StepMotion);
 }
 
 void AMover::SetAccelerationTime(float NewTime)
@@ -62,6 +73,84 @@ void AMover::SetPerturbationsScale(float NewScale)
 	this->PerturbationsScale = NewScale;
 }
 
+void AMover::StartMotion()
+{
+	// Blueprint subclasses provide the inertia tensor through PhysicsBodyInterface, as for the experiments.
+	InertiaTensor = GetClass()->ImplementsInterface(UPhysicsBodyInterface::StaticClass())
+		                ? IPhysicsBodyInterface::Execute_GetInertiaTensor(this)
+		                : ProbeMesh->BodyInstance.GetBodyInertiaTensor();
+
+	MotionPhase = EMovementPhase::Acceleration;
+	MotionTime = 0.f;
+	bMotionActive = true;
+}
+
+void AMover::StopMotion()
+{
+	MotionPhase = EMovementPhase::Idle;
+	bMotionActive = false;
+}
+
+EMovementPhase AMover::GetMotionPhase() const
+{
+	return MotionPhase;
+}
+
+bool AMover::IsMotionActive() const
+{
+	return bMotionActive;
+}
+
+void AMover::UpdateMotionSettings()
+{
+	MotionSettings.AccelerationEnd = AccelerationTime;
+	MotionSettings.DriftEnd = MotionSettings.AccelerationEnd + DriftTime;
+	MotionSettings.DecelerationEnd = MotionSettings.DriftEnd + DeccelerationTime;
+	MotionSettings.AccelerationForce = ForceScale + PerturbationsScale;
+	MotionSettings.DecelerationForce = PerturbationsScale - ForceScale;
+	MotionSettings.TorquePerUpAxis = FVector(TorqueScale) / InertiaTensor;
+}
+
+EMovementPhase AMover::FMotionSettings::GetPhaseAt(float Time) const
+{
+	// Same boundaries as UExperimentExecutionComponent::PerturbedMotion.
+	if (Time <= AccelerationEnd)
+	{
+		return EMovementPhase::Acceleration;
+	}
+	if (Time <= DriftEnd)
+	{
+		return EMovementPhase::Drift;
+	}
+	if (Time <= DecelerationEnd)
+	{
+		return EMovementPhase::Decceleration;
+	}
+	return EMovementPhase::Finished;
+}
+
+void AMover::StepMotion(float DeltaTime, FBodyInstance* BodyInstance)
+{
+	// Once per physics substep, the phase boundaries apply at substep resolution.
+	const FQuat Rotation = BodyInstance->GetUnrealWorldTransform_AssumesLocked().GetRotation();
+
+	switch (MotionSettings.GetPhaseAt(SubstepTime))
+	{
+	case EMovementPhase::Acceleration:
+		BodyInstance->AddForce(Rotation.GetForwardVector() * MotionSettings.AccelerationForce, false);
+		BodyInstance->AddTorqueInRadians(Rotation.GetUpVector() * MotionSettings.TorquePerUpAxis, false);
+		break;
+	case EMovementPhase::Decceleration:
+		BodyInstance->AddForce(Rotation.GetForwardVector() * MotionSettings.DecelerationForce, false);
+		BodyInstance->AddTorqueInRadians(Rotation.GetUpVector() * MotionSettings.TorquePerUpAxis, false);
+		break;
+	default:
+		break;
+	}
+
+	SubstepTime += DeltaTime;
+}
+
 // Called when the game starts or when spawned
 void AMover::BeginPlay()
 {
@@ -74,5 +163,27 @@ void AMover::Tick(float DeltaTime)
 {
 	Super::Tick(DeltaTime);
 
+	if (!bMotionActive)
+	{
+		return;
+	}
+
+	UpdateMotionSettings();
+	MotionPhase = MotionSettings.GetPhaseAt(MotionTime);
+
+	if (MotionPhase == EMovementPhase::Finished)
+	{
+		ProbeMesh->SetPhysicsLinearVelocity(FVector::ZeroVector);
+		ProbeMesh->SetPhysicsAngularVelocityInRadians(FVector::ZeroVector);
+		MotionPhase = EMovementPhase::Idle;
+		bMotionActive = false;
+		OnMotionFinished.Broadcast();
+		return;
+	}
+
+	// Custom physics is cleared after every simulation, so the callback is queued each frame.
+	SubstepTime = MotionTime;
+	ProbeMesh->BodyInstance.AddCustomPhysics(OnCalculateCustomPhysics);
+	MotionTime += DeltaTime;
 }
 
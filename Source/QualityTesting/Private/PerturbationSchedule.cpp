@@ -0,0 +1,75 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "PerturbationSchedule.h"
+
+void FPerturbationSchedule::Compile(TArrayView<const FPerturbationsInfo> Perturbations, float ThrustForce,
+                                    const FVector& InertiaTensor)
+{
+	Reset();
+	Segments.Reserve(Perturbations.Num() * 2);
+
+	for (const FPerturbationsInfo& Info : Perturbations)
+	{
+		const TArray<float>& Scales = Info.PerturbationsScaleList;
+		const TArray<float>& Torques = Info.TorqueScaleList;
+
+		AddSegment(Scales.Num() > 0 && Torques.Num() > 0 ? &Scales[0] : nullptr,
+		           Torques.Num() > 0 ? &Torques[0] : nullptr, 1.f, ThrustForce, InertiaTensor);
+		AddSegment(Scales.Num() > 1 && Torques.Num() > 1 ? &Scales[1] : nullptr,
+		           Torques.Num() > 1 ? &Torques[1] : nullptr, -1.f, ThrustForce, InertiaTensor);
+	}
+}
+
+void FPerturbationSchedule::Compile(TArrayView<const FPerturbationRecord> Perturbations, float ThrustForce,
+                                    const FVector& InertiaTensor)
+{
+	Reset();
+	Segments.Reserve(Perturbations.Num() * 2);
+
+	for (const FPerturbationRecord& Record : Perturbations)
+	{
+		AddSegment(&Record.PerturbationsScale[0], &Record.TorqueScale[0], 1.f, ThrustForce, InertiaTensor);
+		AddSegment(&Record.PerturbationsScale[1], &Record.TorqueScale[1], -1.f, ThrustForce, InertiaTensor);
+	}
+}
+
+void FPerturbationSchedule::Reset()
+{
+	Segments.Reset();
+}
+
+int32 FPerturbationSchedule::Num() const
+{
+	return Segments.Num() / 2;
+}
+
+const FPerturbationSegment* FPerturbationSchedule::Find(int32 PerturbationIndex, EMovementPhase Phase) const
+{
+	if (Phase != EMovementPhase::Acceleration && Phase != EMovementPhase::Decceleration)
+	{
+		return nullptr;
+	}
+
+	const int32 Index = PerturbationIndex * 2 + (Phase == EMovementPhase::Decceleration ? 1 : 0);
+	if (!Segments.IsValidIndex(Index) || !Segments[Index].bApplies)
+	{
+		return nullptr;
+	}
+
+	return &Segments[Index];
+}
+
+void FPerturbationSchedule::AddSegment(const float* Perturbation, const float* Torque, float ForceSign,
+                                       float ThrustForce, const FVector& InertiaTensor)
+{
+	FPerturbationSegment& Segment = Segments.AddZeroed_GetRef();
+	Segment.bApplies = Perturbation && Torque;
+
+	if (Segment.bApplies)
+	{
+		// Acceleration pushes with ThrustForce + P, deceleration with P - ThrustForce.
+		Segment.ForwardForce = *Perturbation + ForceSign * ThrustForce;
+		Segment.TorquePerUpAxis = FVector(*Torque) / InertiaTensor;
+	}
+}
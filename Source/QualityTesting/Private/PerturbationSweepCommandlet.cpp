@@ -0,0 +1,369 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "PerturbationSweepCommandlet.h"
+
+#include "Engine/Engine.h"
+#include "Engine/World.h"
+#include "ExperimentLogFormat.h"
+#include "ExperimentExecutionComponent.h"
+#include "FileHandlerComponent.h"
+#include "Misc/FileHelper.h"
+#include "PhysicsBodyInterface.h"
+#include "ProbeScene.h"
+
+namespace
+{
+	const TCHAR* DefaultProbeClass = TEXT("/Game/Blueprints/Player/BP_Mover.BP_Mover_C");
+}
+
+UPerturbationSweepCommandlet::UPerturbationSweepCommandlet()
+{
+	IsClient = false;
+	IsServer = false;
+	LogToConsole = true;
+
+	HelpDescription = TEXT("Runs all perturbations of a schedule headless and writes one result file per trial.");
+	HelpUsage = TEXT("-run=PerturbationSweep -nullrhi -Schedule=<path> -PhaseDelta=<s> -Thrust=<N> [-StepRate=120] "
+		"[-ProbeClass=<class path>] [-Output=Sweep/Trial] [-Binary] [-MaxTrialTime=60] [-Parallel[=N]] "
+		"[-VerifyParallel[=<cm>]]");
+
+	StartLocation = FVector::ZeroVector;
+	StartRotation = FRotator::ZeroRotator;
+	StepDelta = 1.f / 120.f;
+	MaxTrialTime = 60.f;
+	bBinaryOutput = false;
+	bVerifyParallel = false;
+	VerifyTolerance = 0.f;
+}
+
+int32 UPerturbationSweepCommandlet::Main(const FString& Params)
+{
+	FString SchedulePath;
+	FString ProbeClassPath = DefaultProbeClass;
+	float PhaseDelta = 0.f;
+	float ThrustForce = 0.f;
+	float StepRate = 120.f;
+	OutputName = TEXT("Sweep/Trial");
+
+	if (!FParse::Value(*Params, TEXT("Schedule="), SchedulePath) ||
+		!FParse::Value(*Params, TEXT("PhaseDelta="), PhaseDelta) ||
+		!FParse::Value(*Params, TEXT("Thrust="), ThrustForce))
+	{
+		UE_LOG(LogTemp, Error, TEXT("Usage: %s"), *HelpUsage);
+		return 1;
+	}
+
+	FParse::Value(*Params, TEXT("StepRate="), StepRate);
+	FParse::Value(*Params, TEXT("ProbeClass="), ProbeClassPath);
+	FParse::Value(*Params, TEXT("Output="), OutputName);
+	FParse::Value(*Params, TEXT("MaxTrialTime="), MaxTrialTime);
+	bBinaryOutput = FParse::Param(*Params, TEXT("Binary"));
+	bVerifyParallel = FParse::Value(*Params, TEXT("VerifyParallel="), VerifyTolerance) ||
+		FParse::Param(*Params, TEXT("VerifyParallel"));
+	int32 NumScenes = 0;
+	if (!FParse::Value(*Params, TEXT("Parallel="), NumScenes) && FParse::Param(*Params, TEXT("Parallel")))
+	{
+		NumScenes = FTaskGraphInterface::Get().GetNumWorkerThreads() + 1;
+	}
+	StepDelta = 1.f / FMath::Max(StepRate, 1.f);
+	UExperimentExecutionComponent::EnableFixedStepSubstepping(1.f / StepDelta);
+
+	UClass* ProbeClass = LoadClass<AActor>(nullptr, *ProbeClassPath);
+	if (!ProbeClass || !ProbeClass->ImplementsInterface(UPhysicsBodyInterface::StaticClass()))
+	{
+		UE_LOG(LogTemp, Error, TEXT("%s is not an actor class implementing PhysicsBodyInterface."), *ProbeClassPath);
+		return 1;
+	}
+
+	UWorld* World = UWorld::CreateWorld(EWorldType::Game, false, TEXT("PerturbationSweep"));
+	FWorldContext& WorldContext = GEngine->CreateNewWorldContext(EWorldType::Game);
+	WorldContext.SetCurrentWorld(World);
+	World->InitializeActorsForPlay(FURL());
+	World->BeginPlay();
+
+	int32 Failed = 0;
+	AActor* Probe = World->SpawnActor<AActor>(ProbeClass, FTransform::Identity);
+
+	if (Probe)
+	{
+		// Own components, so the probe's Blueprint bindings on its built-in ones do not fire.
+		UExperimentExecutionComponent* Execution = NewObject<UExperimentExecutionComponent>(Probe);
+		UFileHandlerComponent* FileHandler = NewObject<UFileHandlerComponent>(Probe);
+		Execution->RegisterComponent();
+		FileHandler->RegisterComponent();
+
+		StartRotation = Probe->GetActorRotation();
+
+		if (!FileHandler->ReadFromFile(SchedulePath))
+		{
+			Failed++;
+		}
+		else
+		{
+			const TArray<FPerturbationsInfo> Perturbations = FileHandler->GetPerturbationsInfo(StartLocation);
+			UE_LOG(LogTemp, Display, TEXT("Running %d trials from %s."), Perturbations.Num(), *SchedulePath);
+
+			FExecutionComponentInitializer Initializer;
+			Initializer.bIsExperimentCalibration = false;
+			Initializer.SaddlePointIndex = 0;
+			Initializer.InitialState = EExperimentState::PerturbedMotion;
+			Initializer.StartDelay = 0.f;
+			Initializer.PhaseDelta = PhaseDelta;
+			Initializer.ControlForceAbs = 0.f;
+			Initializer.ThrustForce = ThrustForce;
+			Initializer.TargetActor = Probe;
+			Initializer.bUseFixedTimestep = true;
+			Initializer.FixedStepRate = 1.f / StepDelta;
+
+			if (NumScenes > 0)
+			{
+				// The first trial also runs the serial way, and both results have to agree step by step.
+				// The parallel sweep runs afterwards, so the result file it writes is the parallel one.
+				TArray<FVector> SerialPath;
+				const bool bVerify = bVerifyParallel && Perturbations.Num() > 0;
+				if (bVerify)
+				{
+					Initializer.Perturbations = { Perturbations[0] };
+					Failed += RunTrial(0, Initializer, World, Execution, FileHandler, &SerialPath) ? 0 : 1;
+				}
+
+				TArray<FTransform> FinalTransforms;
+				TArray<FVector> ParallelPath;
+				Failed += RunParallelSweep(ProbeClass, Perturbations, Initializer, NumScenes, FinalTransforms,
+				                           ParallelPath);
+
+				if (bVerify)
+				{
+					float Deviation = 0.f;
+					for (int32 i = 0; i < FMath::Min(SerialPath.Num(), ParallelPath.Num()); ++i)
+					{
+						Deviation = FMath::Max(Deviation, FVector::Distance(SerialPath[i], ParallelPath[i]));
+					}
+
+					if (SerialPath.Num() != ParallelPath.Num() || Deviation > VerifyTolerance)
+					{
+						UE_LOG(LogTemp, Error, TEXT("Trial 0 differs from the serial run: %d and %d steps, up to %.4f cm apart (%.4f cm allowed)."),
+						       ParallelPath.Num(), SerialPath.Num(), Deviation, VerifyTolerance);
+						Failed++;
+					}
+					else
+					{
+						UE_LOG(LogTemp, Display, TEXT("Trial 0 matches the serial run over %d steps, up to %.4f cm apart."),
+						       SerialPath.Num(), Deviation);
+					}
+				}
+			}
+			else
+			{
+				const double StartSeconds = FPlatformTime::Seconds();
+				for (int32 i = 0; i < Perturbations.Num(); ++i)
+				{
+					Initializer.Perturbations = { Perturbations[i] };
+					Failed += RunTrial(i, Initializer, World, Execution, FileHandler) ? 0 : 1;
+				}
+
+				UE_LOG(LogTemp, Display, TEXT("Finished %d trials (%d failed) in %.2f s."),
+				       Perturbations.Num(), Failed, FPlatformTime::Seconds() - StartSeconds);
+			}
+		}
+	}
+	else
+	{
+		UE_LOG(LogTemp, Error, TEXT("Couldn't spawn probe %s."), *ProbeClassPath);
+		Failed++;
+	}
+
+	World->DestroyWorld(false);
+	GEngine->DestroyWorldContext(World);
+
+	return Failed > 0 ? 1 : 0;
+}
+
+bool UPerturbationSweepCommandlet::RunTrial(int32 TrialIndex, const FExecutionComponentInitializer& Initializer,
+                                            UWorld* World, UExperimentExecutionComponent* Execution,
+                                            UFileHandlerComponent* FileHandler, TArray<FVector>* OutPath)
+{
+	AActor* Probe = Initializer.TargetActor;
+	// Same start pose as an in-editor run of the schedule.
+	Probe->SetActorLocationAndRotation(StartLocation, StartRotation, false, nullptr, ETeleportType::ResetPhysics);
+
+	FileHandler->ClearWriteQueue();
+	Execution->SetupComponent(Initializer);
+
+	FExperimentTextLine Line;
+	Line.ExperimentState = TEXT("PerturbedMotion");
+
+	const int32 MaxSteps = FMath::CeilToInt(MaxTrialTime / StepDelta);
+	int32 Step = 0;
+	for (; Step < MaxSteps && Execution->GetCurrentState() != EExperimentState::Finished; ++Step)
+	{
+		World->Tick(LEVELTICK_All, StepDelta);
+
+		Line.Location = Probe->GetActorLocation();
+		FileHandler->AddToWriteQueue(Line);
+		if (OutPath)
+		{
+			OutPath->Add(Line.Location);
+		}
+	}
+
+	Execution->SetComponentTickEnabled(false);
+
+	if (Step == MaxSteps)
+	{
+		UE_LOG(LogTemp, Warning, TEXT("Trial %d did not finish within %.1f s."), TrialIndex, MaxTrialTime);
+	}
+
+	const FString FileName = FString::Printf(TEXT("%s_%05d"), *OutputName, TrialIndex);
+
+	return bBinaryOutput
+		       ? FileHandler->SaveToBinaryFile(FileName, TEXT("qtl"), false)
+		       : FileHandler->SaveToFile(FileName, TEXT("csv"));
+}
+
+int32 UPerturbationSweepCommandlet::RunParallelSweep(UClass* ProbeClass, const TArray<FPerturbationsInfo>& Perturbations,
+                                                     const FExecutionComponentInitializer& Initializer, int32 NumScenes,
+                                                     TArray<FTransform>& OutFinalTransforms,
+                                                     TArray<FVector>& OutFirstTrialPath)
+{
+	const int32 NumTrials = Perturbations.Num();
+	NumScenes = FMath::Clamp(NumScenes, 1, FMath::Max(NumTrials, 1));
+	UE_LOG(LogTemp, Display, TEXT("Running %d trials in %d parallel scenes."), NumTrials, NumScenes);
+
+	const TArray<FString> StateNames = { TEXT("PerturbedMotion") };
+	OutFinalTransforms.SetNum(NumTrials);
+	TArray<bool> Succeeded;
+	Succeeded.SetNumZeroed(NumTrials);
+
+	const double StartSeconds = FPlatformTime::Seconds();
+	const int32 MaxSteps = FMath::CeilToInt(MaxTrialTime / StepDelta);
+
+	// Each scene runs one trial at a time and takes the next one when it is done.
+	struct FSceneTrial
+	{
+		TUniquePtr<FProbeScene> Scene;
+		int32 TrialIndex = INDEX_NONE;
+		int32 Step = 0;
+		TArray<FExperimentSample> Samples;
+	};
+
+	int32 Failed = 0;
+	int32 NextTrial = 0;
+	TArray<FSceneTrial> SceneTrials;
+	SceneTrials.SetNum(NumScenes);
+	for (int32 i = 0; i < NumScenes; ++i)
+	{
+		SceneTrials[i].Scene = MakeUnique<FProbeScene>(ProbeClass, i);
+		if (!SceneTrials[i].Scene->IsValid())
+		{
+			UE_LOG(LogTemp, Error, TEXT("Couldn't spawn probe %s in scene %d."), *ProbeClass->GetPathName(), i);
+			SceneTrials.SetNum(i);
+			Failed++;
+			break;
+		}
+	}
+
+	TArray<FProbeScene*> ActiveScenes;
+	for (;;)
+	{
+		ActiveScenes.Reset();
+		for (FSceneTrial& SceneTrial : SceneTrials)
+		{
+			if (SceneTrial.TrialIndex == INDEX_NONE && NextTrial < NumTrials)
+			{
+				FExecutionComponentInitializer TrialInitializer = Initializer;
+				TrialInitializer.Perturbations = { Perturbations[NextTrial] };
+				SceneTrial.Scene->BeginTrial(TrialInitializer, StartLocation, StartRotation);
+				SceneTrial.TrialIndex = NextTrial++;
+				SceneTrial.Step = 0;
+				SceneTrial.Samples.Reset();
+			}
+			if (SceneTrial.TrialIndex != INDEX_NONE)
+			{
+				ActiveScenes.Add(SceneTrial.Scene.Get());
+			}
+		}
+
+		if (ActiveScenes.Num() == 0)
+		{
+			break;
+		}
+
+		FProbeScene::Step(ActiveScenes, StepDelta);
+
+		for (FSceneTrial& SceneTrial : SceneTrials)
+		{
+			if (SceneTrial.TrialIndex == INDEX_NONE)
+			{
+				continue;
+			}
+
+			// Sampled like RunTrial samples the serial probe after every world tick.
+			const FTransform Transform = SceneTrial.Scene->GetProbeTransform();
+			FExperimentSample& Sample = SceneTrial.Samples.AddUninitialized_GetRef();
+			Sample.FrameIndex = static_cast<uint32>(SceneTrial.Step);
+			Sample.StateId = 0;
+			Sample.Location = Transform.GetLocation();
+
+			const bool bFinished = SceneTrial.Scene->IsTrialFinished();
+			if (bFinished || ++SceneTrial.Step == MaxSteps)
+			{
+				const int32 i = SceneTrial.TrialIndex;
+				if (!bFinished)
+				{
+					UE_LOG(LogTemp, Warning, TEXT("Trial %d did not finish within %.1f s."), i, MaxTrialTime);
+				}
+
+				Succeeded[i] = SaveTrial(i, SceneTrial.Samples, StateNames);
+				OutFinalTransforms[i] = Transform;
+				if (i == 0)
+				{
+					OutFirstTrialPath.Reset(SceneTrial.Samples.Num());
+					for (const FExperimentSample& TrialSample : SceneTrial.Samples)
+					{
+						OutFirstTrialPath.Add(TrialSample.Location);
+					}
+				}
+				SceneTrial.TrialIndex = INDEX_NONE;
+			}
+		}
+	}
+
+	// Destroys the scene worlds.
+	SceneTrials.Reset();
+
+	TArray<FString> Summary;
+	Summary.Reserve(NumTrials + 1);
+	Summary.Add(TEXT("Trial, X, Y, Z, Pitch, Yaw, Roll"));
+	for (int32 i = 0; i < NumTrials; ++i)
+	{
+		const FVector Location = OutFinalTransforms[i].GetLocation();
+		const FRotator Rotation = OutFinalTransforms[i].Rotator();
+		Summary.Add(FString::Printf(TEXT("%d, %f, %f, %f, %f, %f, %f"), i, Location.X, Location.Y, Location.Z,
+		                            Rotation.Pitch, Rotation.Yaw, Rotation.Roll));
+		Failed += Succeeded[i] ? 0 : 1;
+	}
+
+	const FString SummaryPath = UFileHandlerComponent::MakeResultPath(OutputName + TEXT("_Summary"), TEXT("csv"));
+	if (!FFileHelper::SaveStringArrayToFile(Summary, *SummaryPath))
+	{
+		UE_LOG(LogTemp, Error, TEXT("Couldn't write to file %s. Write failed."), *SummaryPath);
+		Failed++;
+	}
+
+	UE_LOG(LogTemp, Display, TEXT("Finished %d trials (%d failed) in %.2f s."),
+	       NumTrials, Failed, FPlatformTime::Seconds() - StartSeconds);
+
+	return Failed;
+}
+
+bool UPerturbationSweepCommandlet::SaveTrial(int32 TrialIndex, TArrayView<const FExperimentSample> Samples,
+                                             const TArray<FString>& StateNames) const
+{
+	const FString FileName = FString::Printf(TEXT("%s_%05d"), *OutputName, TrialIndex);
+
+	return bBinaryOutput
+		       ? FExperimentLogWriter::SaveToFile(UFileHandlerComponent::MakeResultPath(FileName, TEXT("qtl")), Samples, StateNames, false)
+		       : UFileHandlerComponent::SaveSamplesToFile(UFileHandlerComponent::MakeResultPath(FileName, TEXT("csv")), Samples, StateNames);
+}
@@ -0,0 +1,88 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "ProbeScene.h"
+
+#include "Engine/Engine.h"
+#include "Engine/World.h"
+#include "ExperimentExecutionComponent.h"
+
+FProbeScene::FProbeScene(UClass* ProbeClass, int32 SceneIndex)
+	: World(nullptr)
+	, Probe(nullptr)
+	, Execution(nullptr)
+{
+	World = UWorld::CreateWorld(EWorldType::Game, false, *FString::Printf(TEXT("ProbeScene%d"), SceneIndex));
+	FWorldContext& WorldContext = GEngine->CreateNewWorldContext(EWorldType::Game);
+	WorldContext.SetCurrentWorld(World);
+	World->InitializeActorsForPlay(FURL());
+	World->BeginPlay();
+
+	Probe = World->SpawnActor<AActor>(ProbeClass, FTransform::Identity);
+	if (Probe)
+	{
+		// Own component, so the probe's Blueprint bindings on its built-in one do not fire.
+		Execution = NewObject<UExperimentExecutionComponent>(Probe);
+		Execution->RegisterComponent();
+	}
+}
+
+FProbeScene::~FProbeScene()
+{
+	World->DestroyWorld(false);
+	GEngine->DestroyWorldContext(World);
+}
+
+bool FProbeScene::IsValid() const
+{
+	return Execution != nullptr;
+}
+
+void FProbeScene::BeginTrial(const FExecutionComponentInitializer& Initializer, const FVector& StartLocation,
+                             const FRotator& StartRotation)
+{
+	Probe->SetActorLocationAndRotation(StartLocation, StartRotation, false, nullptr, ETeleportType::ResetPhysics);
+
+	FExecutionComponentInitializer SceneInitializer = Initializer;
+	SceneInitializer.TargetActor = Probe;
+	Execution->SetupComponent(SceneInitializer);
+
+	// Step() drives the experiment, the component tick never runs in a scene.
+	Execution->SetComponentTickEnabled(false);
+}
+
+bool FProbeScene::IsTrialFinished() const
+{
+	return Execution->GetCurrentState() == EExperimentState::Finished;
+}
+
+FTransform FProbeScene::GetProbeTransform() const
+{
+	return Probe->GetActorTransform();
+}
+
+void FProbeScene::Step(TArrayView<FProbeScene* const> Scenes, float StepDelta)
+{
+	// What UWorld::Tick does before and in the pre-physics group. SetupPhysicsTickFunctions hands the
+	// step and the substep settings to the physics scene, as it does at the start of a world tick.
+	for (FProbeScene* Scene : Scenes)
+	{
+		Scene->World->DeltaTimeSeconds = StepDelta;
+		Scene->World->TimeSeconds += StepDelta;
+		Scene->World->SetupPhysicsTickFunctions(StepDelta);
+		Scene->Execution->GatherBodyState(StepDelta);
+		Scene->Execution->AdvanceExperiment(StepDelta);
+		Scene->Execution->ApplyBodyCommands();
+	}
+
+	// Every scene starts simulating before the first one is waited for, so they run side by side
+	// on the physics worker threads. Finishing syncs the probe components to their bodies.
+	for (FProbeScene* Scene : Scenes)
+	{
+		Scene->World->StartPhysicsSim();
+	}
+	for (FProbeScene* Scene : Scenes)
+	{
+		Scene->World->FinishPhysicsSim();
+	}
+}
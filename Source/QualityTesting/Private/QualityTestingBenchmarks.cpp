@@ -0,0 +1,731 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "QualityTestingBenchmarks.h"
+
+#include "Dom/JsonObject.h"
+#include "Engine/Engine.h"
+#include "Engine/World.h"
+#include "ExperimentExecutionComponent.h"
+#include "ExperimentLogFormat.h"
+#include "FileHandlerComponent.h"
+#include "HAL/FileManager.h"
+#include "HAL/PlatformProperties.h"
+#include "Math/RandomStream.h"
+#include "Misc/AutomationTest.h"
+#include "Misc/EngineVersion.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "PhysicsBodyInterface.h"
+#include "QualityTestingFL.h"
+#include "ReachabilityIndex.h"
+#include "Serialization/JsonSerializer.h"
+
+namespace
+{
+	const TCHAR* DefaultProbeClass = TEXT("/Game/Blueprints/Player/BP_Mover.BP_Mover_C");
+
+	// Cases faster than this in the baseline are timer noise and never count as regressions.
+	constexpr double MinBaselineSeconds = 1e-4;
+
+	struct FTiming
+	{
+		double Best;
+		double Mean;
+	};
+
+	template <typename FunctionType>
+	FTiming Measure(int32 Runs, FunctionType&& Function)
+	{
+		FTiming Timing = { TNumericLimits<double>::Max(), 0.0 };
+		Runs = FMath::Max(Runs, 1);
+		for (int32 Run = 0; Run < Runs; ++Run)
+		{
+			const double Start = FPlatformTime::Seconds();
+			Function();
+			const double Seconds = FPlatformTime::Seconds() - Start;
+			Timing.Best = FMath::Min(Timing.Best, Seconds);
+			Timing.Mean += Seconds / Runs;
+		}
+		return Timing;
+	}
+
+	// The fixtures below are shared by the commandlet and the automation tests. Each is seeded by its size.
+
+	// Interval the reachability clouds are scattered around.
+	const FVector IntervalLower(-100.f, 0.f, 0.f);
+	const FVector IntervalUpper(100.f, 0.f, 0.f);
+
+	// Points scattered inside a sphere around the middle of the interval.
+	TArray<FVector> MakeReachabilityCloud(int32 Num)
+	{
+		FRandomStream Random(Num);
+		const FVector Center = (IntervalLower + IntervalUpper) * 0.5f;
+		const float Radius = (IntervalUpper - IntervalLower).Size() * 0.25f;
+
+		TArray<FVector> Points;
+		Points.SetNumUninitialized(Num);
+		for (FVector& Point : Points)
+		{
+			Point = Center + Random.GetUnitVector() * Radius * Random.FRand();
+		}
+		return Points;
+	}
+
+	// A schedule file and the records UFileHandlerComponent::ReadFromFile has to parse from it.
+	struct FScheduleFixture
+	{
+		FVector Offset;
+		TArray<FPerturbationRecord> Records;
+		FString Text;
+	};
+
+	FScheduleFixture MakeScheduleFixture(int32 NumRecords)
+	{
+		FRandomStream Random(NumRecords);
+		FScheduleFixture Fixture;
+		Fixture.Offset = FVector(1.5f, -2.25f, 3.125f);
+		Fixture.Records.SetNumUninitialized(NumRecords);
+
+		// Values are multiples of 1/64, so "%f" prints them exactly.
+		Fixture.Text = FString::Printf(TEXT("%f, %f, %f") LINE_TERMINATOR, Fixture.Offset.X, Fixture.Offset.Y, Fixture.Offset.Z);
+		for (FPerturbationRecord& Record : Fixture.Records)
+		{
+			Record.PerturbationsScale[0] = Random.RandRange(-128, 128) / 64.f;
+			Record.PerturbationsScale[1] = Random.RandRange(-128, 128) / 64.f;
+			Record.TorqueScale[0] = Random.RandRange(-128, 128) / 64.f;
+			Record.TorqueScale[1] = Random.RandRange(-128, 128) / 64.f;
+			Fixture.Text += FString::Printf(TEXT("%f, %f, %f, %f") LINE_TERMINATOR, Record.PerturbationsScale[0],
+			                                Record.PerturbationsScale[1], Record.TorqueScale[0], Record.TorqueScale[1]);
+		}
+		return Fixture;
+	}
+
+	// Result log rows, the first half in one state and the second half in the other.
+	struct FResultLogFixture
+	{
+		TArray<FString> StateNames;
+		TArray<FExperimentSample> Samples;
+	};
+
+	FResultLogFixture MakeResultLogFixture(int32 NumSamples)
+	{
+		FResultLogFixture Fixture;
+		Fixture.StateNames = { TEXT("ReachableZoneSearch"), TEXT("PerturbedMotion") };
+
+		const TArray<FVector> Locations = MakeReachabilityCloud(NumSamples);
+		Fixture.Samples.SetNumUninitialized(NumSamples);
+		for (int32 i = 0; i < NumSamples; ++i)
+		{
+			Fixture.Samples[i].FrameIndex = static_cast<uint32>(i);
+			Fixture.Samples[i].StateId = static_cast<uint8>(i * 2 < NumSamples ? 0 : 1);
+			Fixture.Samples[i].Location = Locations[i];
+		}
+		return Fixture;
+	}
+
+	bool SameJ0(float A, float B)
+	{
+		return A == B || (FMath::IsNaN(A) && FMath::IsNaN(B));
+	}
+
+	bool NearlyEqualRelative(float A, float B, float Tolerance)
+	{
+		if (!FMath::IsFinite(A) || !FMath::IsFinite(B))
+		{
+			return A == B || (FMath::IsNaN(A) && FMath::IsNaN(B));
+		}
+		return FMath::Abs(A - B) <= Tolerance * FMath::Max(1.f, FMath::Abs(B));
+	}
+}
+
+UQualityTestingBenchmarkCommandlet::UQualityTestingBenchmarkCommandlet()
+{
+	IsClient = false;
+	IsServer = false;
+	LogToConsole = true;
+
+	HelpDescription = TEXT("Benchmarks and cross-checks the QualityTesting math and I/O paths and writes a JSON report.");
+	HelpUsage = TEXT("-run=QualityTestingBenchmark -nullrhi [-MinPoints=100] [-MaxPoints=10000000] [-Runs=5] "
+		"[-IOSamples=100000] [-Report=Benchmarks/Report] [-Baseline=<path>] [-Tolerance=0.25] "
+		"[-ProbeClass=<class path>] [-NoWorld]");
+
+	Runs = 5;
+}
+
+int32 UQualityTestingBenchmarkCommandlet::Main(const FString& Params)
+{
+	int32 MinPoints = 100;
+	int32 MaxPoints = 10000000;
+	int32 IOSamples = 100000;
+	float Tolerance = 0.25f;
+	FString BaselinePath;
+	FString ProbeClassPath = DefaultProbeClass;
+	ReportName = TEXT("Benchmarks/Report");
+	Runs = 5;
+
+	FParse::Value(*Params, TEXT("MinPoints="), MinPoints);
+	FParse::Value(*Params, TEXT("MaxPoints="), MaxPoints);
+	FParse::Value(*Params, TEXT("IOSamples="), IOSamples);
+	FParse::Value(*Params, TEXT("Runs="), Runs);
+	FParse::Value(*Params, TEXT("Report="), ReportName);
+	FParse::Value(*Params, TEXT("Baseline="), BaselinePath);
+	FParse::Value(*Params, TEXT("Tolerance="), Tolerance);
+	FParse::Value(*Params, TEXT("ProbeClass="), ProbeClassPath);
+	const bool bNoWorld = FParse::Param(*Params, TEXT("NoWorld"));
+	Runs = FMath::Max(Runs, 1);
+
+	Cases.Reset();
+
+	for (int64 NumPoints = FMath::Max(MinPoints, 1); NumPoints <= MaxPoints; NumPoints *= 10)
+	{
+		RunMathCases(static_cast<int32>(NumPoints));
+	}
+
+	RunFileCases(FMath::Max(IOSamples, 1));
+
+	if (!bNoWorld)
+	{
+		RunExecutionCase(ProbeClassPath);
+	}
+
+	bool bSuccess = true;
+	if (!BaselinePath.IsEmpty())
+	{
+		bSuccess &= CompareWithBaseline(BaselinePath, Tolerance);
+	}
+
+	bSuccess &= WriteReport();
+
+	int32 Failed = 0;
+	for (const FBenchmarkCase& Case : Cases)
+	{
+		if (!Case.bPassed || Case.bRegressed)
+		{
+			UE_LOG(LogTemp, Error, TEXT("%s (%d) %s."), *Case.Name, Case.Num,
+			       Case.bPassed ? TEXT("regressed") : TEXT("does not match its reference"));
+			Failed++;
+		}
+	}
+
+	UE_LOG(LogTemp, Display, TEXT("%d benchmark cases, %d failed."), Cases.Num(), Failed);
+
+	return bSuccess && Failed == 0 ? 0 : 1;
+}
+
+void UQualityTestingBenchmarkCommandlet::AddCase(const FString& Name, int32 Num, double BestSeconds, double MeanSeconds,
+                                                 bool bPassed)
+{
+	FBenchmarkCase& Case = Cases.AddDefaulted_GetRef();
+	Case.Name = Name;
+	Case.Num = Num;
+	Case.BestSeconds = BestSeconds;
+	Case.MeanSeconds = MeanSeconds;
+	Case.BaselineSeconds = -1.0;
+	Case.bPassed = bPassed;
+	Case.bRegressed = false;
+
+	UE_LOG(LogTemp, Display, TEXT("%-32s %9d  best %10.3f ms  mean %10.3f ms  %s"),
+	       *Name, Num, BestSeconds * 1000.0, MeanSeconds * 1000.0, bPassed ? TEXT("ok") : TEXT("MISMATCH"));
+}
+
+void UQualityTestingBenchmarkCommandlet::RunMathCases(int32 NumPoints)
+{
+	const FVector& Lower = IntervalLower;
+	const FVector& Upper = IntervalUpper;
+	const TArray<FVector> Points = MakeReachabilityCloud(NumPoints);
+
+	// FindSaddlePoint, every path against the scalar reference.
+	float ScalarJ0 = 0.f, VectorJ0 = 0.f, ParallelJ0 = 0.f, IndexedJ0 = 0.f;
+	int32 ScalarIndex = -1, VectorIndex = -1, ParallelIndex = -1, IndexedIndex = -1;
+
+	const FTiming Scalar = Measure(Runs, [&]
+	{
+		ScalarIndex = UQualityTestingFL::FindSaddlePointScalar(Points, Lower, Upper, ScalarJ0);
+	});
+	AddCase(TEXT("FindSaddlePoint.Scalar"), NumPoints, Scalar.Best, Scalar.Mean, ScalarIndex >= 0);
+
+	const FTiming Vector = Measure(Runs, [&]
+	{
+		VectorIndex = UQualityTestingFL::FindSaddlePointVectorized(Points, Lower, Upper, VectorJ0, false);
+	});
+	AddCase(TEXT("FindSaddlePoint.SIMD"), NumPoints, Vector.Best, Vector.Mean,
+	        VectorIndex == ScalarIndex && SameJ0(VectorJ0, ScalarJ0));
+
+	const FTiming Parallel = Measure(Runs, [&]
+	{
+		ParallelIndex = UQualityTestingFL::FindSaddlePoint(Points, Lower, Upper, ParallelJ0);
+	});
+	AddCase(TEXT("FindSaddlePoint"), NumPoints, Parallel.Best, Parallel.Mean,
+	        ParallelIndex == ScalarIndex && SameJ0(ParallelJ0, ScalarJ0));
+
+	FReachabilityIndex Index;
+	const FTiming Build = Measure(1, [&]
+	{
+		Index.Build(Points);
+	});
+	AddCase(TEXT("ReachabilityIndex.Build"), NumPoints, Build.Best, Build.Mean, Index.Num() == NumPoints);
+
+	const FTiming Indexed = Measure(Runs, [&]
+	{
+		IndexedIndex = UQualityTestingFL::FindSaddlePointIndexed(Index, Lower, Upper, IndexedJ0);
+	});
+	AddCase(TEXT("FindSaddlePoint.Indexed"), NumPoints, Indexed.Best, Indexed.Mean,
+	        IndexedIndex == ScalarIndex && SameJ0(IndexedJ0, ScalarJ0));
+
+	// DistanceToInterval against the engine's point to segment distance.
+	const TPair<FVector, FVector> Interval(Lower, Upper);
+	TArray<float> Distances;
+	Distances.SetNumUninitialized(NumPoints);
+
+	const FTiming Distance = Measure(Runs, [&]
+	{
+		FVector Projection;
+		for (int32 i = 0; i < NumPoints; ++i)
+		{
+			Distances[i] = UQualityTestingFL::DistanceToInterval(Points[i], Interval, Projection);
+		}
+	});
+
+	bool bDistancesMatch = true;
+	for (int32 i = 0; i < NumPoints && bDistancesMatch; ++i)
+	{
+		bDistancesMatch = NearlyEqualRelative(Distances[i], FMath::PointDistToSegment(Points[i], Lower, Upper), 1e-4f);
+	}
+	AddCase(TEXT("DistanceToInterval"), NumPoints, Distance.Best, Distance.Mean, bDistancesMatch);
+
+	// EvaluateScore, the scalar function and the vectorized batch.
+	const float J0 = ScalarIndex >= 0 ? ScalarJ0 : 50.f;
+	TArray<float> ScalarScores, VectorScores;
+	ScalarScores.SetNumUninitialized(NumPoints);
+	VectorScores.SetNumUninitialized(NumPoints);
+
+	const FTiming Score = Measure(Runs, [&]
+	{
+		for (int32 i = 0; i < NumPoints; ++i)
+		{
+			ScalarScores[i] = UQualityTestingFL::EvaluateScore(J0, Points[i]);
+		}
+	});
+	AddCase(TEXT("EvaluateScore"), NumPoints, Score.Best, Score.Mean, true);
+
+	const FTiming Scores = Measure(Runs, [&]
+	{
+		UQualityTestingFL::EvaluateScoresVectorized(J0, Points, VectorScores);
+	});
+
+	bool bScoresMatch = true;
+	for (int32 i = 0; i < NumPoints && bScoresMatch; ++i)
+	{
+		bScoresMatch = NearlyEqualRelative(VectorScores[i], ScalarScores[i], 1e-5f);
+	}
+	AddCase(TEXT("EvaluateScore.SIMD"), NumPoints, Scores.Best, Scores.Mean, bScoresMatch);
+}
+
+void UQualityTestingBenchmarkCommandlet::RunFileCases(int32 NumSamples)
+{
+	IFileManager& FileManager = IFileManager::Get();
+
+	// Schedule text written here, parsed by UFileHandlerComponent::ReadFromFile.
+	const FString SchedulePath = UFileHandlerComponent::MakeResultPath(ReportName + TEXT("_Schedule"), TEXT("csv"));
+	const FScheduleFixture Schedule = MakeScheduleFixture(NumSamples);
+
+	bool bScheduleMatch = FFileHelper::SaveStringToFile(Schedule.Text, *SchedulePath);
+	UFileHandlerComponent* FileHandler = NewObject<UFileHandlerComponent>(GetTransientPackage());
+
+	const FTiming Parse = Measure(Runs, [&]
+	{
+		bScheduleMatch &= FileHandler->ReadFromFile(SchedulePath);
+	});
+
+	FVector Offset;
+	const TArray<FPerturbationRecord>& Records = FileHandler->GetPerturbationRecords(Offset);
+	bScheduleMatch &= Offset == Schedule.Offset && Records.Num() == Schedule.Records.Num();
+	for (int32 i = 0; i < Records.Num() && bScheduleMatch; ++i)
+	{
+		bScheduleMatch = FMemory::Memcmp(&Records[i], &Schedule.Records[i], sizeof(FPerturbationRecord)) == 0;
+	}
+	AddCase(TEXT("Schedule.Parse"), NumSamples, Parse.Best, Parse.Mean, bScheduleMatch);
+	FileManager.Delete(*SchedulePath);
+
+	// Result logs.
+	const FResultLogFixture Log = MakeResultLogFixture(NumSamples);
+	const TArray<FString>& StateNames = Log.StateNames;
+	const TArray<FExperimentSample>& Samples = Log.Samples;
+
+	const FString TextPath = UFileHandlerComponent::MakeResultPath(ReportName + TEXT("_Log"), TEXT("csv"));
+	bool bTextWritten = true;
+	const FTiming TextWrite = Measure(Runs, [&]
+	{
+		bTextWritten &= UFileHandlerComponent::SaveSamplesToFile(TextPath, Samples, StateNames);
+	});
+	AddCase(TEXT("ResultLog.Text.Write"), NumSamples, TextWrite.Best, TextWrite.Mean,
+	        bTextWritten && FileManager.FileSize(*TextPath) > 0);
+	FileManager.Delete(*TextPath);
+
+	const FString BinaryPath = UFileHandlerComponent::MakeResultPath(ReportName + TEXT("_Log"), TEXT("qtl"));
+	bool bBinaryWritten = true;
+	const FTiming BinaryWrite = Measure(Runs, [&]
+	{
+		bBinaryWritten &= FExperimentLogWriter::SaveToFile(BinaryPath, Samples, StateNames, false);
+	});
+	AddCase(TEXT("ResultLog.Binary.Write"), NumSamples, BinaryWrite.Best, BinaryWrite.Mean, bBinaryWritten);
+
+	bool bBinaryMatch = bBinaryWritten;
+	const FTiming BinaryRead = Measure(Runs, [&]
+	{
+		FExperimentLogReader Reader;
+		bBinaryMatch &= Reader.Open(BinaryPath) && Reader.Num() == NumSamples && Reader.GetStateNames() == StateNames;
+		for (int32 i = 0; i < NumSamples && bBinaryMatch; ++i)
+		{
+			bBinaryMatch = Reader.GetFrameIndices()[i] == Samples[i].FrameIndex &&
+				Reader.GetStateIds()[i] == Samples[i].StateId &&
+				Reader.GetLocation(i) == Samples[i].Location;
+		}
+	});
+	AddCase(TEXT("ResultLog.Binary.Read"), NumSamples, BinaryRead.Best, BinaryRead.Mean, bBinaryMatch);
+	FileManager.Delete(*BinaryPath);
+
+	// Compressed container, in memory so the timings are not dominated by the disk.
+	TArray<uint8> Payload;
+	FExperimentLogWriter::Serialize(Samples, StateNames, false, Payload);
+
+	const EResultCompression Formats[] = { EResultCompression::Zlib, EResultCompression::LZ4 };
+	for (const EResultCompression Format : Formats)
+	{
+		const FString FormatName = StaticEnum<EResultCompression>()->GetNameStringByValue(static_cast<int64>(Format));
+		TArray<uint8> Compressed, Decompressed;
+		bool bCompressed = true, bDecompressed = true;
+
+		const FTiming Compress = Measure(Runs, [&]
+		{
+			bCompressed &= FCompressedResult::Compress(Format, Payload, Compressed);
+		});
+		AddCase(TEXT("ResultLog.Compress.") + FormatName, NumSamples, Compress.Best, Compress.Mean,
+		        bCompressed && FCompressedResult::IsCompressed(Compressed.GetData(), Compressed.Num()));
+
+		const FTiming Decompress = Measure(Runs, [&]
+		{
+			bDecompressed &= FCompressedResult::Decompress(Compressed.GetData(), Compressed.Num(), Decompressed);
+		});
+		AddCase(TEXT("ResultLog.Decompress.") + FormatName, NumSamples, Decompress.Best, Decompress.Mean,
+		        bDecompressed && Decompressed == Payload);
+
+		UE_LOG(LogTemp, Display, TEXT("%s: %d of %d bytes (%.1f%%)."), *FormatName, Compressed.Num(), Payload.Num(),
+		       100.0 * Compressed.Num() / FMath::Max(Payload.Num(), 1));
+	}
+}
+
+void UQualityTestingBenchmarkCommandlet::RunExecutionCase(const FString& ProbeClassPath)
+{
+	UClass* ProbeClass = LoadClass<AActor>(nullptr, *ProbeClassPath);
+	if (!ProbeClass || !ProbeClass->ImplementsInterface(UPhysicsBodyInterface::StaticClass()))
+	{
+		UE_LOG(LogTemp, Error, TEXT("%s is not an actor class implementing PhysicsBodyInterface."), *ProbeClassPath);
+		AddCase(TEXT("ExperimentExecution.PerturbedMotion"), 0, 0.0, 0.0, false);
+		return;
+	}
+
+	UWorld* World = UWorld::CreateWorld(EWorldType::Game, false, TEXT("QualityTestingBenchmark"));
+	FWorldContext& WorldContext = GEngine->CreateNewWorldContext(EWorldType::Game);
+	WorldContext.SetCurrentWorld(World);
+	World->InitializeActorsForPlay(FURL());
+	World->BeginPlay();
+
+	int32 Steps = 0;
+	bool bFinished = false;
+	FTiming Timing = { 0.0, 0.0 };
+	AActor* Probe = World->SpawnActor<AActor>(ProbeClass, FTransform::Identity);
+
+	if (Probe)
+	{
+		// Own component, so the probe's Blueprint bindings on its built-in one do not fire.
+		UExperimentExecutionComponent* Execution = NewObject<UExperimentExecutionComponent>(Probe);
+		Execution->RegisterComponent();
+
+		FPerturbationRecord Perturbation;
+		Perturbation.PerturbationsScale[0] = Perturbation.PerturbationsScale[1] = 1.f;
+		Perturbation.TorqueScale[0] = Perturbation.TorqueScale[1] = 0.5f;
+
+		FExecutionComponentInitializer Initializer;
+		Initializer.bIsExperimentCalibration = false;
+		Initializer.SaddlePointIndex = 0;
+		Initializer.InitialState = EExperimentState::PerturbedMotion;
+		Initializer.StartDelay = 0.f;
+		Initializer.PhaseDelta = 1.f;
+		Initializer.ControlForceAbs = 0.f;
+		Initializer.ThrustForce = 1000.f;
+		Initializer.TargetActor = Probe;
+		Initializer.bUseFixedTimestep = true;
+		Initializer.FixedStepRate = 120.f;
+		Initializer.Perturbations = { Perturbation.ToPerturbationsInfo() };
+
+		const float StepDelta = 1.f / Initializer.FixedStepRate;
+		UExperimentExecutionComponent::EnableFixedStepSubstepping(Initializer.FixedStepRate);
+		const int32 MaxSteps = FMath::CeilToInt(60.f / StepDelta);
+
+		Timing = Measure(1, [&]
+		{
+			Execution->SetupComponent(Initializer);
+			for (; Steps < MaxSteps && Execution->GetCurrentState() != EExperimentState::Finished; ++Steps)
+			{
+				World->Tick(LEVELTICK_All, StepDelta);
+			}
+		});
+
+		bFinished = Execution->GetCurrentState() == EExperimentState::Finished;
+		Execution->SetComponentTickEnabled(false);
+	}
+	else
+	{
+		UE_LOG(LogTemp, Error, TEXT("Couldn't spawn probe %s."), *ProbeClassPath);
+	}
+
+	AddCase(TEXT("ExperimentExecution.PerturbedMotion"), Steps, Timing.Best, Timing.Mean, bFinished);
+
+	World->DestroyWorld(false);
+	GEngine->DestroyWorldContext(World);
+}
+
+bool UQualityTestingBenchmarkCommandlet::CompareWithBaseline(const FString& BaselinePath, float Tolerance)
+{
+	FString BaselineText;
+	TSharedPtr<FJsonObject> Baseline;
+	const TArray<TSharedPtr<FJsonValue>>* BaselineCases = nullptr;
+
+	if (!FFileHelper::LoadFileToString(BaselineText, *BaselinePath) ||
+		!FJsonSerializer::Deserialize(TJsonReaderFactory<>::Create(BaselineText), Baseline) ||
+		!Baseline.IsValid() || !Baseline->TryGetArrayField(TEXT("cases"), BaselineCases))
+	{
+		UE_LOG(LogTemp, Error, TEXT("Couldn't read baseline report %s."), *BaselinePath);
+		return false;
+	}
+
+	for (const TSharedPtr<FJsonValue>& Value : *BaselineCases)
+	{
+		const TSharedPtr<FJsonObject>* Object = nullptr;
+		FString Name;
+		int32 Num = 0;
+		double BestMs = 0.0;
+		if (!Value->TryGetObject(Object) || !(*Object)->TryGetStringField(TEXT("name"), Name) ||
+			!(*Object)->TryGetNumberField(TEXT("num"), Num) || !(*Object)->TryGetNumberField(TEXT("bestMs"), BestMs))
+		{
+			continue;
+		}
+
+		for (FBenchmarkCase& Case : Cases)
+		{
+			if (Case.Name == Name && Case.Num == Num)
+			{
+				Case.BaselineSeconds = BestMs / 1000.0;
+				Case.bRegressed = Case.BaselineSeconds >= MinBaselineSeconds &&
+					Case.BestSeconds > Case.BaselineSeconds * (1.0 + Tolerance);
+			}
+		}
+	}
+
+	return true;
+}
+
+bool UQualityTestingBenchmarkCommandlet::WriteReport() const
+{
+	const TSharedRef<FJsonObject> Report = MakeShared<FJsonObject>();
+	Report->SetStringField(TEXT("engine"), FEngineVersion::Current().ToString());
+	Report->SetStringField(TEXT("platform"), FPlatformProperties::IniPlatformName());
+	Report->SetStringField(TEXT("cpu"), FPlatformMisc::GetCPUBrand().TrimStartAndEnd());
+	Report->SetNumberField(TEXT("cores"), FPlatformMisc::NumberOfCoresIncludingHyperthreads());
+	Report->SetStringField(TEXT("date"), FDateTime::UtcNow().ToIso8601());
+	Report->SetNumberField(TEXT("runs"), Runs);
+
+	TArray<TSharedPtr<FJsonValue>> CaseValues;
+	for (const FBenchmarkCase& Case : Cases)
+	{
+		const TSharedRef<FJsonObject> Object = MakeShared<FJsonObject>();
+		Object->SetStringField(TEXT("name"), Case.Name);
+		Object->SetNumberField(TEXT("num"), Case.Num);
+		Object->SetNumberField(TEXT("bestMs"), Case.BestSeconds * 1000.0);
+		Object->SetNumberField(TEXT("meanMs"), Case.MeanSeconds * 1000.0);
+		if (Case.BaselineSeconds >= 0.0)
+		{
+			Object->SetNumberField(TEXT("baselineMs"), Case.BaselineSeconds * 1000.0);
+		}
+		Object->SetBoolField(TEXT("passed"), Case.bPassed);
+		Object->SetBoolField(TEXT("regressed"), Case.bRegressed);
+		CaseValues.Add(MakeShared<FJsonValueObject>(Object));
+	}
+	Report->SetArrayField(TEXT("cases"), CaseValues);
+
+	FString ReportText;
+	const FString ReportPath = UFileHandlerComponent::MakeResultPath(ReportName, TEXT("json"));
+	const bool bSuccess = FJsonSerializer::Serialize(Report, TJsonWriterFactory<>::Create(&ReportText)) &&
+		FFileHelper::SaveStringToFile(ReportText, *ReportPath);
+
+	if (!bSuccess)
+	{
+		UE_LOG(LogTemp, Error, TEXT("Couldn't write to file %s. Write failed."), *ReportPath);
+	}
+	else
+	{
+		UE_LOG(LogTemp, Display, TEXT("Report written to %s."), *ReportPath);
+	}
+
+	return bSuccess;
+}
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+// The commandlet's reference checks without the timing, for CI:
+// -ExecCmds="Automation RunTests QualityTesting"
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FQualityTestingSaddlePointTest, "QualityTesting.Math.FindSaddlePoint",
+                                 EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::ProductFilter)
+
+bool FQualityTestingSaddlePointTest::RunTest(const FString& Parameters)
+{
+	const FVector& Lower = IntervalLower;
+	const FVector& Upper = IntervalUpper;
+
+	for (int32 NumPoints = 100; NumPoints <= 100000; NumPoints *= 10)
+	{
+		const TArray<FVector> Points = MakeReachabilityCloud(NumPoints);
+
+		float ScalarJ0 = 0.f, VectorJ0 = 0.f, ParallelJ0 = 0.f, IndexedJ0 = 0.f;
+		const int32 ScalarIndex = UQualityTestingFL::FindSaddlePointScalar(Points, Lower, Upper, ScalarJ0);
+		const int32 VectorIndex = UQualityTestingFL::FindSaddlePointVectorized(Points, Lower, Upper, VectorJ0, false);
+		const int32 ParallelIndex = UQualityTestingFL::FindSaddlePoint(Points, Lower, Upper, ParallelJ0);
+
+		FReachabilityIndex Index;
+		Index.Build(Points);
+		const int32 IndexedIndex = UQualityTestingFL::FindSaddlePointIndexed(Index, Lower, Upper, IndexedJ0);
+
+		TestTrue(FString::Printf(TEXT("Scalar saddle point of %d points"), NumPoints), ScalarIndex >= 0);
+		TestEqual(FString::Printf(TEXT("SIMD saddle point of %d points"), NumPoints), VectorIndex, ScalarIndex);
+		TestTrue(FString::Printf(TEXT("SIMD J0 of %d points"), NumPoints), SameJ0(VectorJ0, ScalarJ0));
+		TestEqual(FString::Printf(TEXT("Parallel saddle point of %d points"), NumPoints), ParallelIndex, ScalarIndex);
+		TestTrue(FString::Printf(TEXT("Parallel J0 of %d points"), NumPoints), SameJ0(ParallelJ0, ScalarJ0));
+		TestEqual(FString::Printf(TEXT("Indexed saddle point of %d points"), NumPoints), IndexedIndex, ScalarIndex);
+		TestTrue(FString::Printf(TEXT("Indexed J0 of %d points"), NumPoints), SameJ0(IndexedJ0, ScalarJ0));
+	}
+
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FQualityTestingDistanceToIntervalTest, "QualityTesting.Math.DistanceToInterval",
+                                 EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::ProductFilter)
+
+bool FQualityTestingDistanceToIntervalTest::RunTest(const FString& Parameters)
+{
+	const FVector& Lower = IntervalLower;
+	const FVector& Upper = IntervalUpper;
+	const TPair<FVector, FVector> Interval(Lower, Upper);
+	const TArray<FVector> Points = MakeReachabilityCloud(10000);
+
+	int32 Mismatches = 0;
+	for (const FVector& Point : Points)
+	{
+		FVector Projection;
+		const float Distance = UQualityTestingFL::DistanceToInterval(Point, Interval, Projection);
+		Mismatches += NearlyEqualRelative(Distance, FMath::PointDistToSegment(Point, Lower, Upper), 1e-4f) ? 0 : 1;
+	}
+
+	TestEqual(TEXT("Distances that differ from FMath::PointDistToSegment"), Mismatches, 0);
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FQualityTestingScheduleTest, "QualityTesting.IO.Schedule",
+                                 EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::ProductFilter)
+
+bool FQualityTestingScheduleTest::RunTest(const FString& Parameters)
+{
+	const FString SchedulePath = FPaths::CreateTempFilename(*FPaths::ProjectSavedDir(), TEXT("Schedule"), TEXT(".csv"));
+	const FScheduleFixture Schedule = MakeScheduleFixture(1000);
+
+	if (!TestTrue(TEXT("Schedule written"), FFileHelper::SaveStringToFile(Schedule.Text, *SchedulePath)))
+	{
+		return false;
+	}
+
+	UFileHandlerComponent* FileHandler = NewObject<UFileHandlerComponent>(GetTransientPackage());
+	const bool bRead = FileHandler->ReadFromFile(SchedulePath);
+	IFileManager::Get().Delete(*SchedulePath);
+
+	if (!TestTrue(TEXT("Schedule parsed"), bRead))
+	{
+		return false;
+	}
+
+	FVector Offset;
+	const TArray<FPerturbationRecord>& Records = FileHandler->GetPerturbationRecords(Offset);
+	TestEqual(TEXT("Schedule offset"), Offset, Schedule.Offset);
+
+	if (TestEqual(TEXT("Schedule records"), Records.Num(), Schedule.Records.Num()))
+	{
+		int32 Mismatches = 0;
+		for (int32 i = 0; i < Records.Num(); ++i)
+		{
+			Mismatches += FMemory::Memcmp(&Records[i], &Schedule.Records[i], sizeof(FPerturbationRecord)) == 0 ? 0 : 1;
+		}
+		TestEqual(TEXT("Records that differ from the written schedule"), Mismatches, 0);
+	}
+
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FQualityTestingResultLogTest, "QualityTesting.IO.ResultLog",
+                                 EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::ProductFilter)
+
+bool FQualityTestingResultLogTest::RunTest(const FString& Parameters)
+{
+	constexpr int32 NumSamples = 10000;
+	const FResultLogFixture Log = MakeResultLogFixture(NumSamples);
+	const TArray<FString>& StateNames = Log.StateNames;
+	const TArray<FExperimentSample>& Samples = Log.Samples;
+
+	const FString BinaryPath = FPaths::CreateTempFilename(*FPaths::ProjectSavedDir(), TEXT("Log"), TEXT(".qtl"));
+	if (!TestTrue(TEXT(".qtl written"), FExperimentLogWriter::SaveToFile(BinaryPath, Samples, StateNames, false)))
+	{
+		return false;
+	}
+
+	{
+		FExperimentLogReader Reader;
+		if (TestTrue(TEXT(".qtl opened"), Reader.Open(BinaryPath)) &&
+			TestEqual(TEXT(".qtl samples"), Reader.Num(), NumSamples))
+		{
+			TestTrue(TEXT(".qtl state names"), Reader.GetStateNames() == StateNames);
+
+			int32 Mismatches = 0;
+			for (int32 i = 0; i < NumSamples; ++i)
+			{
+				const bool bMatch = Reader.GetFrameIndices()[i] == Samples[i].FrameIndex &&
+					Reader.GetStateIds()[i] == Samples[i].StateId &&
+					Reader.GetLocation(i) == Samples[i].Location;
+				Mismatches += bMatch ? 0 : 1;
+			}
+			TestEqual(TEXT(".qtl samples that differ from the written ones"), Mismatches, 0);
+		}
+	}
+	IFileManager::Get().Delete(*BinaryPath);
+
+	TArray<uint8> Payload;
+	FExperimentLogWriter::Serialize(Samples, StateNames, false, Payload);
+
+	const EResultCompression Formats[] = { EResultCompression::Zlib, EResultCompression::LZ4 };
+	for (const EResultCompression Format : Formats)
+	{
+		const FString FormatName = StaticEnum<EResultCompression>()->GetNameStringByValue(static_cast<int64>(Format));
+		TArray<uint8> Compressed, Decompressed;
+
+		if (TestTrue(FormatName + TEXT(" compressed"), FCompressedResult::Compress(Format, Payload, Compressed)))
+		{
+			TestTrue(FormatName + TEXT(" detected"), FCompressedResult::IsCompressed(Compressed.GetData(), Compressed.Num()));
+			TestTrue(FormatName + TEXT(" decompressed"),
+			         FCompressedResult::Decompress(Compressed.GetData(), Compressed.Num(), Decompressed));
+			TestTrue(FormatName + TEXT(" round trip"), Decompressed == Payload);
+		}
+	}
+
+	return true;
+}
+
+#endif
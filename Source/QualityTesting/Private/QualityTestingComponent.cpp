@@ -11,28 +11,257 @@ UQualityTestingComponent::UQualityTestingComponent()
 	// Set this component to be initialized when the game starts, and to be ticked every frame.  You can turn these features
 	// off to improve performance if you don't need them.
 	PrimaryComponentTick.bCanEverTick = false;
+
+	SaddlePointIdx = -1;
+	J0 = 0.f;
+	SaddlePoint = MinReachableBound = MaxReachableBound = FVector::ZeroVector;
+	PointsBounds.Init();
+	CandidateIdx = -1;
+	CandidateDistance = 0.f;
+	CandidateProjection = FVector::ZeroVector;
+	UncoveredCount = 0;
+	bCoverageDirty = false;
+	UnindexedScans = 0;
 }
 
-bool UQualityTestingComponent::FindSaddlePoint(const TArray<FVector> Points, const FVector& MinBound,
+bool UQualityTestingComponent::FindSaddlePoint(TArray<FVector> Points, const FVector& MinBound,
 	const FVector& MaxBound)
 {
 	MinReachableBound = MinBound;
 	MaxReachableBound = MaxBound;
 
-	SaddlePointIdx = UQualityTestingFL::FindSaddlePoint(Points, MinBound, MaxBound, J0);
+	// Keep the points so a live search can continue from here.
+	ReachabilityPoints = MoveTemp(Points);
+	PointsBounds = FBox(ReachabilityPoints);
+	ReachabilityIndex.Reset();
+	UnindexedScans = 0;
+
+	// A single query is one linear pass, building the index first would only add to it.
+	SaddlePointIdx = UQualityTestingFL::FindSaddlePoint(ReachabilityPoints, MinBound, MaxBound, J0);
 
 	if (SaddlePointIdx != -1) {
-		SaddlePoint = Points[SaddlePointIdx];
+		SaddlePoint = ReachabilityPoints[SaddlePointIdx];
+
+		// The saddle point is the candidate and already covers every point.
+		CandidateIdx = SaddlePointIdx;
+		CandidateDistance = UQualityTestingFL::DistanceToInterval(SaddlePoint,
+			TPair<FVector, FVector>(MinReachableBound, MaxReachableBound), CandidateProjection);
+		UncoveredCount = 0;
+		bCoverageDirty = false;
+	}
+	else {
+		RebuildCandidate();
 	}
 
 	return SaddlePointIdx != -1;
 }
 
+void UQualityTestingComponent::BeginIncrementalSearch(const FVector& MinBound, const FVector& MaxBound)
+{
+	MinReachableBound = MinBound;
+	MaxReachableBound = MaxBound;
+	ReachabilityPoints.Reset();
+	PointsBounds.Init();
+	ReachabilityIndex.Reset();
+	UnindexedScans = 0;
+	RebuildCandidate();
+	UpdateSaddlePoint();
+}
+
+bool UQualityTestingComponent::AddReachabilityPoint(const FVector& Point)
+{
+	const int32 Index = ReachabilityPoints.Add(Point);
+	PointsBounds += Point;
+
+	FVector Projection;
+	const float Distance = UQualityTestingFL::DistanceToInterval(
+		Point, TPair<FVector, FVector>(MinReachableBound, MaxReachableBound), Projection);
+
+	if (CandidateDistance < Distance) {
+		// Radius and center both moved, earlier coverage results no longer apply.
+		CandidateIdx = Index;
+		CandidateDistance = Distance;
+		CandidateProjection = Projection;
+		bCoverageDirty = true;
+		return true;
+	}
+
+	if (!bCoverageDirty && FVector::Distance(CandidateProjection, Point) > CandidateDistance) {
+		UncoveredCount++;
+	}
+
+	return false;
+}
+
+void UQualityTestingComponent::AddReachabilityPoints(const TArray<FVector>& Points)
+{
+	ReachabilityPoints.Reserve(ReachabilityPoints.Num() + Points.Num());
+
+	for (const FVector& Point : Points) {
+		AddReachabilityPoint(Point);
+	}
+}
+
+void UQualityTestingComponent::SetReachableBounds(const FVector& MinBound, const FVector& MaxBound)
+{
+	MinReachableBound = MinBound;
+	MaxReachableBound = MaxBound;
+	RebuildCandidate();
+}
+
+bool UQualityTestingComponent::UpdateSaddlePoint()
+{
+	ResolveCoverage();
+
+	if (CandidateIdx != -1 && UncoveredCount == 0) {
+		SaddlePointIdx = CandidateIdx;
+		J0 = CandidateDistance;
+		SaddlePoint = ReachabilityPoints[CandidateIdx];
+	}
+	else {
+		SaddlePointIdx = -1;
+		J0 = ReachabilityPoints.Num() > 0 ? NAN : 0.f;
+	}
+
+	return SaddlePointIdx != -1;
+}
+
+void UQualityTestingComponent::RebuildCandidate()
+{
+	const TPair<FVector, FVector> Interval(MinReachableBound, MaxReachableBound);
+
+	UpdateReachabilityIndex();
+	CandidateIdx = ReachabilityIndex.FindFarthestFromSegment(MinReachableBound, MaxReachableBound,
+		CandidateDistance, CandidateProjection);
+
+	for (int32 i = ReachabilityIndex.Num(); i < ReachabilityPoints.Num(); ++i) {
+		FVector Projection;
+		const float Distance = UQualityTestingFL::DistanceToInterval(ReachabilityPoints[i], Interval, Projection);
+		if (CandidateDistance < Distance) {
+			CandidateIdx = i;
+			CandidateDistance = Distance;
+			CandidateProjection = Projection;
+		}
+	}
+
+	bCoverageDirty = true;
+}
+
+void UQualityTestingComponent::ResolveCoverage()
+{
+	if (!bCoverageDirty) {
+		return;
+	}
+
+	bCoverageDirty = false;
+	UncoveredCount = 0;
+
+	if (CandidateIdx == -1) {
+		return;
+	}
+
+	// All points lie inside the bounding box, so if its furthest corner is covered, every point is.
+	// The margin keeps float rounding from deciding differently than the per-point test.
+	float FurthestCornerSquared = 0.f;
+	for (int32 Corner = 0; Corner < 8; ++Corner) {
+		const FVector CornerPoint(
+			(Corner & 1) ? PointsBounds.Max.X : PointsBounds.Min.X,
+			(Corner & 2) ? PointsBounds.Max.Y : PointsBounds.Min.Y,
+			(Corner & 4) ? PointsBounds.Max.Z : PointsBounds.Min.Z);
+		FurthestCornerSquared = FMath::Max(FurthestCornerSquared, FVector::DistSquared(CornerPoint, CandidateProjection));
+	}
+
+	if (FurthestCornerSquared <= FMath::Square(CandidateDistance) * (1.f - 1e-4f)) {
+		return;
+	}
+
+	UpdateReachabilityIndex();
+	UncoveredCount = ReachabilityIndex.Num() - ReachabilityIndex.CountWithinRadius(CandidateProjection, CandidateDistance);
+
+	for (int32 i = ReachabilityIndex.Num(); i < ReachabilityPoints.Num(); ++i) {
+		if (FVector::Distance(CandidateProjection, ReachabilityPoints[i]) > CandidateDistance) {
+			UncoveredCount++;
+		}
+	}
+}
+
+void UQualityTestingComponent::BuildReachabilityIndex()
+{
+	// The candidate does not depend on the index, only the cost of finding it does.
+	ReachabilityIndex.Build(ReachabilityPoints);
+	UnindexedScans = 0;
+}
+
+void UQualityTestingComponent::UpdateReachabilityIndex() const
+{
+	const int32 UnindexedCount = ReachabilityPoints.Num() - ReachabilityIndex.Num();
+
+	// Streamed points are only worth a rebuild once they rival the indexed ones, which keeps the
+	// total build cost amortized O(N log N). A first pass stays linear, the index pays off from
+	// the second query over the same points on.
+	if (UnindexedCount < FMath::Max(MinIndexedPoints, ReachabilityIndex.Num())) {
+		return;
+	}
+
+	if (++UnindexedScans < 2) {
+		return;
+	}
+
+	ReachabilityIndex.Build(ReachabilityPoints);
+	UnindexedScans = 0;
+}
+
+int32 UQualityTestingComponent::EvaluateReachableBounds(const FVector& MinBound, const FVector& MaxBound,
+	float& OutJ0) const
+{
+	UpdateReachabilityIndex();
+
+	if (ReachabilityIndex.Num() == ReachabilityPoints.Num()) {
+		return UQualityTestingFL::FindSaddlePointIndexed(ReachabilityIndex, MinBound, MaxBound, OutJ0);
+	}
+
+	return UQualityTestingFL::FindSaddlePoint(ReachabilityPoints, MinBound, MaxBound, OutJ0);
+}
+
+int32 UQualityTestingComponent::CountReachabilityPointsWithin(const FVector& Center, float Radius) const
+{
+	UpdateReachabilityIndex();
+	int32 Count = ReachabilityIndex.CountWithinRadius(Center, Radius);
+
+	for (int32 i = ReachabilityIndex.Num(); i < ReachabilityPoints.Num(); ++i) {
+		Count += FVector::Distance(Center, ReachabilityPoints[i]) <= Radius ? 1 : 0;
+	}
+
+	return Count;
+}
+
+int32 UQualityTestingComponent::FindNearestReachabilityPoint(const FVector& Point, float& OutDistance) const
+{
+	UpdateReachabilityIndex();
+	int32 NearestIdx = ReachabilityIndex.FindNearest(Point, OutDistance);
+
+	for (int32 i = ReachabilityIndex.Num(); i < ReachabilityPoints.Num(); ++i) {
+		const float Distance = FVector::Distance(Point, ReachabilityPoints[i]);
+		if (NearestIdx == -1 || Distance < OutDistance) {
+			NearestIdx = i;
+			OutDistance = Distance;
+		}
+	}
+
+	return NearestIdx;
+}
+
 float UQualityTestingComponent::EvaluateScore(FVector TestingPoint) const
 {
 	return UQualityTestingFL::EvaluateScore(J0, TestingPoint);
 }
 
+FScoreStatistics UQualityTestingComponent::EvaluateScores(const TArray<FVector>& TestingPoints,
+	const TArray<float>& Percentiles, TArray<float>& OutScores) const
+{
+	return UQualityTestingFL::EvaluateScores(J0, TestingPoints, Percentiles, OutScores);
+}
+
 int32 UQualityTestingComponent::GetSaddlePointIdx() const
 {
 	return SaddlePointIdx;
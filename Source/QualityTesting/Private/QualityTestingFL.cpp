@@ -3,10 +3,237 @@
 
 #include "QualityTestingFL.h"
 
+#include "Async/ParallelFor.h"
+#include "ReachabilityIndex.h"
+
+namespace
+{
+	// Inputs at least this large are split across worker threads.
+	constexpr int32 ParallelThreshold = 1 << 16;
+	constexpr int32 ParallelChunkSize = 1 << 14;
+	// SIMD distances use a reciprocal instead of a division, so anything this close to a
+	// decision boundary is settled with the exact scalar math.
+	constexpr float BoundaryTolerance = 1e-4f;
+
+	// Points are transposed into SoA blocks of this size on the stack before scoring.
+	constexpr int32 ScoreBlockSize = 256;
+
+	using FAlignedFloatArray = TArray<float, TAlignedHeapAllocator<16>>;
+
+	struct FPointsSoA
+	{
+		FAlignedFloatArray X;
+		FAlignedFloatArray Y;
+		FAlignedFloatArray Z;
+		int32 Num = 0;
+		int32 PaddedNum = 0;
+
+		explicit FPointsSoA(TArrayView<const FVector> Points)
+			: Num(Points.Num())
+			, PaddedNum(Align(Points.Num(), 4))
+		{
+			X.SetNumUninitialized(PaddedNum);
+			Y.SetNumUninitialized(PaddedNum);
+			Z.SetNumUninitialized(PaddedNum);
+			for (int32 i = 0; i < PaddedNum; ++i)
+			{
+				// Padding repeats the first point, it cannot change the maximum or the coverage.
+				const FVector& Point = Points[i < Num ? i : 0];
+				X[i] = Point.X;
+				Y[i] = Point.Y;
+				Z[i] = Point.Z;
+			}
+		}
+	};
+
+	void RunChunked(int32 Num, bool bParallel, TFunctionRef<void(int32 Begin, int32 End)> Body)
+	{
+		if (!bParallel || Num < ParallelThreshold)
+		{
+			Body(0, Num);
+			return;
+		}
+
+		const int32 NumChunks = FMath::DivideAndRoundUp(Num, ParallelChunkSize);
+		ParallelFor(NumChunks, [&](int32 Chunk)
+		{
+			// Chunk size is a multiple of 4, so every chunk starts on a SIMD batch.
+			const int32 Begin = Chunk * ParallelChunkSize;
+			Body(Begin, FMath::Min(Begin + ParallelChunkSize, Num));
+		});
+	}
+
+	// Squared distance of points [Begin, End) to the segment A + t * D, written to OutDistSq.
+	void SegmentDistanceSqKernel(const FPointsSoA& Points, int32 Begin, int32 End,
+	                             const FVector& A, const FVector& D, float InvLengthSq, float* OutDistSq)
+	{
+		const VectorRegister AX = VectorSetFloat1(A.X);
+		const VectorRegister AY = VectorSetFloat1(A.Y);
+		const VectorRegister AZ = VectorSetFloat1(A.Z);
+		const VectorRegister DX = VectorSetFloat1(D.X);
+		const VectorRegister DY = VectorSetFloat1(D.Y);
+		const VectorRegister DZ = VectorSetFloat1(D.Z);
+		const VectorRegister InvLen = VectorSetFloat1(InvLengthSq);
+		const VectorRegister Zero = VectorZero();
+		const VectorRegister One = VectorOne();
+
+		for (int32 i = Begin; i < End; i += 4)
+		{
+			const VectorRegister PX = VectorLoadAligned(&Points.X[i]);
+			const VectorRegister PY = VectorLoadAligned(&Points.Y[i]);
+			const VectorRegister PZ = VectorLoadAligned(&Points.Z[i]);
+
+			const VectorRegister RX = VectorSubtract(PX, AX);
+			const VectorRegister RY = VectorSubtract(PY, AY);
+			const VectorRegister RZ = VectorSubtract(PZ, AZ);
+
+			VectorRegister T = VectorMultiply(RX, DX);
+			T = VectorMultiplyAdd(RY, DY, T);
+			T = VectorMultiplyAdd(RZ, DZ, T);
+			T = VectorMin(VectorMax(VectorMultiply(T, InvLen), Zero), One);
+
+			// P - (A + t * D) = R - t * D
+			const VectorRegister EX = VectorSubtract(RX, VectorMultiply(T, DX));
+			const VectorRegister EY = VectorSubtract(RY, VectorMultiply(T, DY));
+			const VectorRegister EZ = VectorSubtract(RZ, VectorMultiply(T, DZ));
+
+			VectorRegister DistSq = VectorMultiply(EX, EX);
+			DistSq = VectorMultiplyAdd(EY, EY, DistSq);
+			DistSq = VectorMultiplyAdd(EZ, EZ, DistSq);
+			VectorStoreAligned(DistSq, &OutDistSq[i]);
+		}
+	}
+
+	// Returns false as soon as a point in [Begin, End) lies further than Radius from Center.
+	bool CoverageKernel(const FPointsSoA& Points, TArrayView<const FVector> Source, int32 Begin, int32 End,
+	                    const FVector& Center, float Radius)
+	{
+		const VectorRegister CX = VectorSetFloat1(Center.X);
+		const VectorRegister CY = VectorSetFloat1(Center.Y);
+		const VectorRegister CZ = VectorSetFloat1(Center.Z);
+		const VectorRegister Inside = VectorSetFloat1(Radius * Radius * (1.f - BoundaryTolerance));
+		const VectorRegister Outside = VectorSetFloat1(Radius * Radius * (1.f + BoundaryTolerance));
+
+		for (int32 i = Begin; i < End; i += 4)
+		{
+			const VectorRegister EX = VectorSubtract(VectorLoadAligned(&Points.X[i]), CX);
+			const VectorRegister EY = VectorSubtract(VectorLoadAligned(&Points.Y[i]), CY);
+			const VectorRegister EZ = VectorSubtract(VectorLoadAligned(&Points.Z[i]), CZ);
+
+			VectorRegister DistSq = VectorMultiply(EX, EX);
+			DistSq = VectorMultiplyAdd(EY, EY, DistSq);
+			DistSq = VectorMultiplyAdd(EZ, EZ, DistSq);
+
+			if (VectorMaskBits(VectorCompareGT(DistSq, Outside)) != 0)
+			{
+				return false;
+			}
+
+			const int32 Undecided = VectorMaskBits(VectorCompareGT(DistSq, Inside));
+			for (int32 Lane = 0; Lane < 4; ++Lane)
+			{
+				const int32 Index = i + Lane < Points.Num ? i + Lane : 0;
+				if ((Undecided & (1 << Lane)) && FVector::Distance(Center, Source[Index]) > Radius)
+				{
+					return false;
+				}
+			}
+		}
+
+		return true;
+	}
+}
 
 int32 UQualityTestingFL::FindSaddlePoint(const TArray<FVector>& Points,
                                          const FVector& RZ_LowerBound, const FVector& RZ_UpperBound,
                                          float& OutJ0)
+{
+	return FindSaddlePointVectorized(Points, RZ_LowerBound, RZ_UpperBound, OutJ0);
+}
+
+int32 UQualityTestingFL::FindSaddlePointVectorized(TArrayView<const FVector> Points,
+                                                   const FVector& RZ_LowerBound, const FVector& RZ_UpperBound,
+                                                   float& OutJ0, bool bAllowParallel)
+{
+	const FVector Direction = RZ_UpperBound - RZ_LowerBound;
+	const float LengthSquared = Direction.SizeSquared();
+
+	if (Points.Num() == 0 || LengthSquared <= 0.f)
+	{
+		// Nothing to vectorize, and a degenerate interval keeps the scalar NaN behaviour.
+		return FindSaddlePointScalar(Points, RZ_LowerBound, RZ_UpperBound, OutJ0);
+	}
+
+	const FPointsSoA SoA(Points);
+	FAlignedFloatArray DistSq;
+	DistSq.SetNumUninitialized(SoA.PaddedNum);
+
+	RunChunked(SoA.PaddedNum, bAllowParallel, [&](int32 Begin, int32 End)
+	{
+		SegmentDistanceSqKernel(SoA, Begin, End, RZ_LowerBound, Direction, 1.f / LengthSquared, DistSq.GetData());
+	});
+
+	float MaxDistSq = 0.f;
+	for (int32 i = 0; i < SoA.Num; ++i)
+	{
+		MaxDistSq = FMath::Max(MaxDistSq, DistSq[i]);
+	}
+
+	// Re-run the exact scalar selection over every point that could be the maximum,
+	// in index order, so ties resolve to the same index as the scalar path.
+	const TPair<FVector, FVector> Interval(RZ_LowerBound, RZ_UpperBound);
+	const float CandidateThreshold = MaxDistSq * (1.f - BoundaryTolerance);
+	float MaxDistToRZ{ 0.f };
+	int32 SaddlePointIndex{ -1 };
+	FVector SaddlePointProj = FVector::ZeroVector;
+
+	for (int32 i = 0; i < SoA.Num; ++i)
+	{
+		if (DistSq[i] >= CandidateThreshold)
+		{
+			FVector Proj;
+			const float DistToRZ = DistanceToInterval(Points[i], Interval, Proj);
+			if (MaxDistToRZ < DistToRZ)
+			{
+				MaxDistToRZ = DistToRZ;
+				SaddlePointIndex = i;
+				SaddlePointProj = Proj;
+			}
+		}
+	}
+
+	if (SaddlePointIndex == -1)
+	{
+		// Every point lies on the interval, the scalar path reports this as not found.
+		OutJ0 = NAN;
+		return -1;
+	}
+
+	const int32 NumChunks = bAllowParallel && SoA.PaddedNum >= ParallelThreshold
+		                        ? FMath::DivideAndRoundUp(SoA.PaddedNum, ParallelChunkSize)
+		                        : 1;
+	TArray<bool> ChunkCovered;
+	ChunkCovered.SetNumZeroed(NumChunks);
+
+	RunChunked(SoA.PaddedNum, NumChunks > 1, [&](int32 Begin, int32 End)
+	{
+		ChunkCovered[Begin / ParallelChunkSize] = CoverageKernel(SoA, Points, Begin, End, SaddlePointProj, MaxDistToRZ);
+	});
+
+	OutJ0 = MaxDistToRZ;
+
+	if (ChunkCovered.Contains(false))
+	{
+		SaddlePointIndex = -1;
+		OutJ0 = NAN;
+	}
+
+	return SaddlePointIndex;
+}
+
+int32 UQualityTestingFL::FindSaddlePointScalar(TArrayView<const FVector> Points,
+                                               const FVector& RZ_LowerBound, const FVector& RZ_UpperBound,
+                                               float& OutJ0)
 {
 	const TPair<FVector, FVector> Interval(RZ_LowerBound, RZ_UpperBound);
 	float MaxDistToRZ{ 0.f };
@@ -48,11 +275,146 @@ int32 UQualityTestingFL::FindSaddlePoint(const TArray<FVector>& Points,
 	return SaddlePointIndex;
 }
 
+int32 UQualityTestingFL::FindSaddlePointIndexed(const FReachabilityIndex& Index,
+                                                const FVector& RZ_LowerBound, const FVector& RZ_UpperBound,
+                                                float& OutJ0)
+{
+	FVector SaddlePointProj;
+	const int32 SaddlePointIndex = Index.FindFarthestFromSegment(RZ_LowerBound, RZ_UpperBound, OutJ0, SaddlePointProj);
+
+	if (SaddlePointIndex == -1 || !Index.AllWithinRadius(SaddlePointProj, OutJ0))
+	{
+		OutJ0 = Index.IsEmpty() ? 0.f : NAN;
+		return -1;
+	}
+
+	return SaddlePointIndex;
+}
+
 float UQualityTestingFL::EvaluateScore(const float& J0, const FVector& TestingPoint)
 {
 	return J0 / TestingPoint.Size() * 100.f;
 }
 
+FScoreStatistics UQualityTestingFL::EvaluateScores(const float& J0, const TArray<FVector>& TestingPoints,
+                                                  const TArray<float>& Percentiles, TArray<float>& OutScores)
+{
+	OutScores.SetNumUninitialized(TestingPoints.Num());
+	EvaluateScoresVectorized(J0, TestingPoints, OutScores);
+
+	return ComputeScoreStatistics(OutScores, Percentiles);
+}
+
+void UQualityTestingFL::EvaluateScoresVectorized(float J0, TArrayView<const FVector> TestingPoints, TArrayView<float> OutScores)
+{
+	check(OutScores.Num() == TestingPoints.Num());
+
+	MS_ALIGN(16) float X[ScoreBlockSize] GCC_ALIGN(16);
+	MS_ALIGN(16) float Y[ScoreBlockSize] GCC_ALIGN(16);
+	MS_ALIGN(16) float Z[ScoreBlockSize] GCC_ALIGN(16);
+	MS_ALIGN(16) float Scores[ScoreBlockSize] GCC_ALIGN(16);
+
+	const VectorRegister Scale = VectorSetFloat1(J0 * 100.f);
+	const VectorRegister Zero = VectorZero();
+
+	for (int32 BlockBegin = 0; BlockBegin < TestingPoints.Num(); BlockBegin += ScoreBlockSize)
+	{
+		const int32 BlockNum = FMath::Min(ScoreBlockSize, TestingPoints.Num() - BlockBegin);
+		const int32 PaddedNum = Align(BlockNum, 4);
+
+		for (int32 i = 0; i < PaddedNum; ++i)
+		{
+			// Padding repeats the first point of the block, its scores are never copied out.
+			const FVector& Point = TestingPoints[BlockBegin + (i < BlockNum ? i : 0)];
+			X[i] = Point.X;
+			Y[i] = Point.Y;
+			Z[i] = Point.Z;
+		}
+
+		for (int32 i = 0; i < PaddedNum; i += 4)
+		{
+			const VectorRegister PX = VectorLoadAligned(&X[i]);
+			const VectorRegister PY = VectorLoadAligned(&Y[i]);
+			const VectorRegister PZ = VectorLoadAligned(&Z[i]);
+
+			VectorRegister SizeSquared = VectorMultiply(PX, PX);
+			SizeSquared = VectorMultiplyAdd(PY, PY, SizeSquared);
+			SizeSquared = VectorMultiplyAdd(PZ, PZ, SizeSquared);
+
+			VectorStoreAligned(VectorMultiply(Scale, VectorReciprocalSqrtAccurate(SizeSquared)), &Scores[i]);
+
+			// The reciprocal square root of zero is not reliable, use the scalar division there.
+			const int32 AtOrigin = VectorMaskBits(VectorCompareEQ(SizeSquared, Zero));
+			for (int32 Lane = 0; AtOrigin != 0 && Lane < 4; ++Lane)
+			{
+				if (AtOrigin & (1 << Lane))
+				{
+					Scores[i + Lane] = EvaluateScore(J0, FVector::ZeroVector);
+				}
+			}
+		}
+
+		FMemory::Memcpy(&OutScores[BlockBegin], Scores, BlockNum * sizeof(float));
+	}
+}
+
+FScoreStatistics UQualityTestingFL::ComputeScoreStatistics(TArrayView<const float> Scores, TArrayView<const float> Percentiles)
+{
+	FScoreStatistics Statistics;
+	Statistics.Percentiles.Init(NAN, Percentiles.Num());
+
+	TArray<float> Finite;
+	if (Percentiles.Num() > 0)
+	{
+		Finite.Reserve(Scores.Num());
+	}
+
+	double Sum = 0.0;
+	Statistics.Min = TNumericLimits<float>::Max();
+	Statistics.Max = TNumericLimits<float>::Lowest();
+
+	for (const float Score : Scores)
+	{
+		if (!FMath::IsFinite(Score))
+		{
+			continue;
+		}
+
+		Statistics.Count++;
+		Statistics.Min = FMath::Min(Statistics.Min, Score);
+		Statistics.Max = FMath::Max(Statistics.Max, Score);
+		Sum += Score;
+
+		if (Percentiles.Num() > 0)
+		{
+			Finite.Add(Score);
+		}
+	}
+
+	if (Statistics.Count == 0)
+	{
+		Statistics.Min = Statistics.Max = Statistics.Mean = NAN;
+		return Statistics;
+	}
+
+	Statistics.Mean = static_cast<float>(Sum / Statistics.Count);
+
+	if (Percentiles.Num() > 0)
+	{
+		Finite.Sort();
+
+		for (int32 i = 0; i < Percentiles.Num(); ++i)
+		{
+			const float Rank = FMath::Clamp(Percentiles[i], 0.f, 100.f) / 100.f * (Finite.Num() - 1);
+			const int32 Lower = FMath::FloorToInt(Rank);
+			const int32 Upper = FMath::Min(Lower + 1, Finite.Num() - 1);
+			Statistics.Percentiles[i] = FMath::Lerp(Finite[Lower], Finite[Upper], Rank - Lower);
+		}
+	}
+
+	return Statistics;
+}
+
 float UQualityTestingFL::DistanceToInterval(FVector Point, const TPair<FVector, FVector>& Interval, FVector& OutProjection)
 {
 	const float LengthSquared = (Interval.Get<0>() - Interval.Get<1>()).SizeSquared();
@@ -0,0 +1,325 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "ReachabilityIndex.h"
+
+#include "QualityTestingFL.h"
+
+namespace
+{
+	constexpr int32 LeafSize = 16;
+	// Node bounds are only trusted when they decide a query by more than float rounding,
+	// anything closer is settled per sample with the exact test.
+	constexpr float BoundTolerance = 1e-4f;
+
+	float MaxDistanceSquared(const FBox& Box, const FVector& Point)
+	{
+		return FVector(
+			FMath::Max(FMath::Abs(Point.X - Box.Min.X), FMath::Abs(Point.X - Box.Max.X)),
+			FMath::Max(FMath::Abs(Point.Y - Box.Min.Y), FMath::Abs(Point.Y - Box.Max.Y)),
+			FMath::Max(FMath::Abs(Point.Z - Box.Min.Z), FMath::Abs(Point.Z - Box.Max.Z))).SizeSquared();
+	}
+}
+
+struct FReachabilityIndex::FFarthestQuery
+{
+	TPair<FVector, FVector> Interval;
+	FVector Direction;
+	float InvLengthSquared;
+
+	float BestDistance = 0.f;
+	int32 BestIndex = INDEX_NONE;
+	FVector BestProjection = FVector::ZeroVector;
+
+	float SegmentDistance(const FVector& Point) const
+	{
+		const FVector Relative = Point - Interval.Get<0>();
+		const float Param = FMath::Clamp(FVector::DotProduct(Relative, Direction) * InvLengthSquared, 0.f, 1.f);
+		return (Relative - Direction * Param).Size();
+	}
+
+	// Distance to a segment is convex, so over a box it peaks at one of the corners.
+	float UpperBound(const FBox& Box) const
+	{
+		float Bound = 0.f;
+		for (int32 Corner = 0; Corner < 8; ++Corner)
+		{
+			Bound = FMath::Max(Bound, SegmentDistance(FVector(
+				(Corner & 1) ? Box.Max.X : Box.Min.X,
+				(Corner & 2) ? Box.Max.Y : Box.Min.Y,
+				(Corner & 4) ? Box.Max.Z : Box.Min.Z)));
+		}
+		return Bound * (1.f + BoundTolerance);
+	}
+};
+
+void FReachabilityIndex::Build(TArrayView<const FVector> InPoints)
+{
+	Reset();
+
+	Points.Append(InPoints.GetData(), InPoints.Num());
+	SourceIndices.SetNumUninitialized(Points.Num());
+	for (int32 i = 0; i < SourceIndices.Num(); ++i)
+	{
+		SourceIndices[i] = i;
+	}
+
+	if (Points.Num() > 0)
+	{
+		Nodes.Reserve(2 * FMath::DivideAndRoundUp(Points.Num(), LeafSize));
+		BuildNode(0, Points.Num());
+	}
+}
+
+void FReachabilityIndex::Reset()
+{
+	Nodes.Reset();
+	Points.Reset();
+	SourceIndices.Reset();
+}
+
+int32 FReachabilityIndex::Num() const
+{
+	return Points.Num();
+}
+
+bool FReachabilityIndex::IsEmpty() const
+{
+	return Points.Num() == 0;
+}
+
+int32 FReachabilityIndex::CountWithinRadius(const FVector& Center, float Radius) const
+{
+	return Nodes.Num() > 0 ? CountWithinRadius(0, Center, Radius, Radius * Radius) : 0;
+}
+
+bool FReachabilityIndex::AllWithinRadius(const FVector& Center, float Radius) const
+{
+	return Nodes.Num() == 0 || AllWithinRadius(0, Center, Radius, Radius * Radius);
+}
+
+int32 FReachabilityIndex::FindNearest(const FVector& Point, float& OutDistance) const
+{
+	float BestDistanceSquared = TNumericLimits<float>::Max();
+	int32 BestIndex = INDEX_NONE;
+
+	if (Nodes.Num() > 0)
+	{
+		FindNearest(0, Point, BestDistanceSquared, BestIndex);
+	}
+
+	OutDistance = BestIndex != INDEX_NONE ? FMath::Sqrt(BestDistanceSquared) : 0.f;
+	return BestIndex;
+}
+
+int32 FReachabilityIndex::FindFarthestFromSegment(const FVector& A, const FVector& B, float& OutDistance,
+                                                  FVector& OutProjection) const
+{
+	FFarthestQuery Query;
+	Query.Interval = TPair<FVector, FVector>(A, B);
+	Query.Direction = B - A;
+
+	const float LengthSquared = Query.Direction.SizeSquared();
+	if (Nodes.Num() > 0 && LengthSquared > 0.f)
+	{
+		Query.InvLengthSquared = 1.f / LengthSquared;
+		FindFarthest(0, Query);
+	}
+
+	OutDistance = Query.BestDistance;
+	OutProjection = Query.BestProjection;
+	return Query.BestIndex;
+}
+
+int32 FReachabilityIndex::BuildNode(int32 Begin, int32 End)
+{
+	const int32 NodeIndex = Nodes.AddUninitialized();
+	FNode& Node = Nodes[NodeIndex];
+	Node.Bounds = FBox(&Points[Begin], End - Begin);
+	Node.Begin = Begin;
+	Node.End = End;
+	Node.Left = Node.Right = INDEX_NONE;
+
+	if (End - Begin <= LeafSize)
+	{
+		return NodeIndex;
+	}
+
+	const FVector Extent = Node.Bounds.GetSize();
+	const int32 Axis = Extent.X >= Extent.Y && Extent.X >= Extent.Z ? 0 : (Extent.Y >= Extent.Z ? 1 : 2);
+	const int32 Middle = Begin + (End - Begin) / 2;
+	SelectNth(Begin, End, Middle, Axis);
+
+	// Nodes may reallocate while the children are built.
+	const int32 Left = BuildNode(Begin, Middle);
+	const int32 Right = BuildNode(Middle, End);
+	Nodes[NodeIndex].Left = Left;
+	Nodes[NodeIndex].Right = Right;
+
+	return NodeIndex;
+}
+
+void FReachabilityIndex::SelectNth(int32 Begin, int32 End, int32 Nth, int32 Axis)
+{
+	// Hoare quickselect, keeps SourceIndices in step with Points.
+	while (End - Begin > 1)
+	{
+		const float Pivot = Points[Begin + (End - Begin) / 2][Axis];
+		int32 i = Begin;
+		int32 j = End - 1;
+
+		while (i <= j)
+		{
+			while (Points[i][Axis] < Pivot)
+			{
+				++i;
+			}
+			while (Points[j][Axis] > Pivot)
+			{
+				--j;
+			}
+			if (i <= j)
+			{
+				Swap(Points[i], Points[j]);
+				Swap(SourceIndices[i], SourceIndices[j]);
+				++i;
+				--j;
+			}
+		}
+
+		if (Nth <= j)
+		{
+			End = j + 1;
+		}
+		else if (Nth >= i)
+		{
+			Begin = i;
+		}
+		else
+		{
+			return;
+		}
+	}
+}
+
+int32 FReachabilityIndex::CountWithinRadius(int32 NodeIndex, const FVector& Center, float Radius, float RadiusSquared) const
+{
+	const FNode& Node = Nodes[NodeIndex];
+
+	if (Node.Bounds.ComputeSquaredDistanceToPoint(Center) > RadiusSquared * (1.f + BoundTolerance))
+	{
+		return 0;
+	}
+	if (MaxDistanceSquared(Node.Bounds, Center) <= RadiusSquared * (1.f - BoundTolerance))
+	{
+		return Node.End - Node.Begin;
+	}
+
+	if (Node.Left == INDEX_NONE)
+	{
+		int32 Count = 0;
+		for (int32 i = Node.Begin; i < Node.End; ++i)
+		{
+			Count += FVector::Distance(Center, Points[i]) <= Radius ? 1 : 0;
+		}
+		return Count;
+	}
+
+	return CountWithinRadius(Node.Left, Center, Radius, RadiusSquared) +
+		CountWithinRadius(Node.Right, Center, Radius, RadiusSquared);
+}
+
+bool FReachabilityIndex::AllWithinRadius(int32 NodeIndex, const FVector& Center, float Radius, float RadiusSquared) const
+{
+	const FNode& Node = Nodes[NodeIndex];
+
+	if (MaxDistanceSquared(Node.Bounds, Center) <= RadiusSquared * (1.f - BoundTolerance))
+	{
+		return true;
+	}
+	if (Node.Bounds.ComputeSquaredDistanceToPoint(Center) > RadiusSquared * (1.f + BoundTolerance))
+	{
+		return false;
+	}
+
+	if (Node.Left == INDEX_NONE)
+	{
+		for (int32 i = Node.Begin; i < Node.End; ++i)
+		{
+			if (FVector::Distance(Center, Points[i]) > Radius)
+			{
+				return false;
+			}
+		}
+		return true;
+	}
+
+	return AllWithinRadius(Node.Left, Center, Radius, RadiusSquared) &&
+		AllWithinRadius(Node.Right, Center, Radius, RadiusSquared);
+}
+
+void FReachabilityIndex::FindNearest(int32 NodeIndex, const FVector& Point, float& BestDistanceSquared, int32& BestIndex) const
+{
+	const FNode& Node = Nodes[NodeIndex];
+
+	if (Node.Bounds.ComputeSquaredDistanceToPoint(Point) > BestDistanceSquared)
+	{
+		return;
+	}
+
+	if (Node.Left == INDEX_NONE)
+	{
+		for (int32 i = Node.Begin; i < Node.End; ++i)
+		{
+			const float DistanceSquared = FVector::DistSquared(Point, Points[i]);
+			if (DistanceSquared < BestDistanceSquared ||
+				(DistanceSquared == BestDistanceSquared && SourceIndices[i] < BestIndex))
+			{
+				BestDistanceSquared = DistanceSquared;
+				BestIndex = SourceIndices[i];
+			}
+		}
+		return;
+	}
+
+	const bool bLeftFirst = Nodes[Node.Left].Bounds.ComputeSquaredDistanceToPoint(Point) <=
+		Nodes[Node.Right].Bounds.ComputeSquaredDistanceToPoint(Point);
+	FindNearest(bLeftFirst ? Node.Left : Node.Right, Point, BestDistanceSquared, BestIndex);
+	FindNearest(bLeftFirst ? Node.Right : Node.Left, Point, BestDistanceSquared, BestIndex);
+}
+
+void FReachabilityIndex::FindFarthest(int32 NodeIndex, FFarthestQuery& Query) const
+{
+	const FNode& Node = Nodes[NodeIndex];
+
+	if (Node.Left == INDEX_NONE)
+	{
+		for (int32 i = Node.Begin; i < Node.End; ++i)
+		{
+			FVector Projection;
+			const float Distance = UQualityTestingFL::DistanceToInterval(Points[i], Query.Interval, Projection);
+			// Same strict comparison as the linear search, so a sample exactly on the segment never wins.
+			if (Query.BestDistance < Distance ||
+				(Distance == Query.BestDistance && Query.BestIndex != INDEX_NONE && SourceIndices[i] < Query.BestIndex))
+			{
+				Query.BestDistance = Distance;
+				Query.BestIndex = SourceIndices[i];
+				Query.BestProjection = Projection;
+			}
+		}
+		return;
+	}
+
+	const float LeftBound = Query.UpperBound(Nodes[Node.Left].Bounds);
+	const float RightBound = Query.UpperBound(Nodes[Node.Right].Bounds);
+	const bool bLeftFirst = LeftBound >= RightBound;
+
+	if ((bLeftFirst ? LeftBound : RightBound) >= Query.BestDistance)
+	{
+		FindFarthest(bLeftFirst ? Node.Left : Node.Right, Query);
+	}
+	if ((bLeftFirst ? RightBound : LeftBound) >= Query.BestDistance)
+	{
+		FindFarthest(bLeftFirst ? Node.Right : Node.Left, Query);
+	}
+}
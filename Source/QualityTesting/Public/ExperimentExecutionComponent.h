@@ -3,9 +3,12 @@
 #pragma once
 
 #include "CoreMinimal.h"
+#include "ExperimentJournal.h"
 #include "FileHandlerComponent.h"
+#include "PerturbationSchedule.h"
 #include "QualityTestingTypes.h"
 #include "Components/ActorComponent.h"
+#include "PhysicsEngine/BodyInstance.h"
 #include "ExperimentExecutionComponent.generated.h"
 
 USTRUCT(BlueprintType)
@@ -39,6 +42,24 @@ struct FExecutionComponentInitializer
 
 	UPROPERTY(BlueprintReadWrite)
 	TArray<FPerturbationsInfo> Perturbations;
+
+	// Step the motion phases at FixedStepRate instead of the render frame rate. The forces of each step are
+	// applied in the physics substeps that cover it. The project does not enable substepping, SetupComponent
+	// warns when it is off and headless runs turn it on with EnableFixedStepSubstepping.
+	UPROPERTY(BlueprintReadWrite)
+	bool bUseFixedTimestep = false;
+
+	// Steps per second used when bUseFixedTimestep is set.
+	UPROPERTY(BlueprintReadWrite)
+	float FixedStepRate = 120.f;
+
+	// Tick from UExperimentSubsystem together with every other batched experiment in the world.
+	UPROPERTY(BlueprintReadWrite)
+	bool bUseBatchedTick = false;
+
+	// Keep a per-tick journal of everything applied to the body, see SaveJournal.
+	UPROPERTY(BlueprintReadWrite)
+	bool bRecordJournal = false;
 };
 
 DECLARE_DYNAMIC_MULTICAST_DELEGATE(FExecutionComponentFinished);
@@ -70,6 +91,41 @@ public:
 	UFUNCTION(BlueprintPure)
 	EMovementPhase GetCurrentPhase() const;
 
+	UFUNCTION(BlueprintPure)
+	float GetCurrentTime() const;
+
+	// Writes the journal recorded since the last SetupComponent to Saved/Results/<FileName>.<FileExtension>.
+	UFUNCTION(BlueprintCallable)
+	bool SaveJournal(const FString& FileName, const FString& FileExtension = TEXT("qtj")) const;
+
+	// Re-drives TargetActor from a recorded journal, one journal tick per component tick, by applying
+	// each tick's recorded force and impulse again. Ticking the world with the recorded DeltaTimes keeps
+	// the body on the recorded path as far as physics is deterministic, GetReplayDeviation tells how far.
+	// Fixed-step journals are rejected, their forces were applied per physics substep, not once per tick.
+	UFUNCTION(BlueprintCallable)
+	bool StartReplay(const FString& JournalPath, AActor* ReplayTarget);
+	bool StartReplayFromJournal(TSharedRef<const FExperimentJournal> InJournal, AActor* ReplayTarget);
+
+	UFUNCTION(BlueprintPure)
+	bool IsReplaying() const;
+
+	// Largest distance between the replayed and the recorded actor location so far.
+	UFUNCTION(BlueprintPure)
+	float GetReplayDeviation() const;
+
+	const FExperimentJournal& GetJournal() const;
+
+	// Turns physics substepping on for this process, with substeps no longer than one fixed step.
+	// Only for dedicated experiment runs such as the commandlets, it changes every body in every world.
+	static void EnableFixedStepSubstepping(float FixedStepRate);
+
+	// One tick split in three for UExperimentSubsystem. GatherBodyState and ApplyBodyCommands touch
+	// the body and run on the game thread. AdvanceExperiment only touches this component's own
+	// state, so different components can advance on different threads.
+	void GatherBodyState(float DeltaTime);
+	void AdvanceExperiment(float DeltaTime);
+	void ApplyBodyCommands();
+
 	UPROPERTY(BlueprintAssignable)
 	FExecutionComponentFinished OnComponentFinished;
 
@@ -83,6 +139,14 @@ public:
 	FExecutionComponentSetupFailed OnSetupFailed;
 	
 private:
+	// Force and torque of one fixed step in body space, so they follow the body as physics rotates it.
+	struct FFixedStepCommand
+	{
+		float Duration;
+		FVector Force;
+		FVector Torque;
+	};
+
 	bool bIsCalibration;
 	int32 CurrentPerturbationIndex;
 	EExperimentState ExperimentState;
@@ -94,21 +158,66 @@ private:
 	float DecelerationTime;
 	float ThrustForce;
 	float ControlForceAbs;
+	bool bUseFixedTimestep;
+	float FixedStepDelta;
+	float TimeAccumulator;
+	bool bUseBatchedTick;
+	// Body rotation at the start of the tick, motion directions are taken from it.
+	FQuat BodyRotation;
+	FQuat InitialBodyRotation;
+	// Everything a tick does to the body is collected here and applied by ApplyBodyCommands.
+	FVector PendingForce;
+	FVector PendingTorque;
+	FVector PendingImpulse;
+	FVector PendingAngularImpulse;
+	TArray<FFixedStepCommand> PendingSteps;
+	// Steps handed to the physics callback. Written on the game thread before physics starts, then
+	// read by the callback only, which also owns the cursor until physics is done.
+	TArray<FFixedStepCommand> PhysicsSteps;
+	int32 PhysicsStepIndex;
+	float PhysicsStepTime;
+	FCalculateCustomPhysics OnCalculateCustomPhysics;
+	bool bPendingVelocityReset;
+	bool bPendingTeleport;
+	FVector PendingTeleportLocation;
+	FRotator PendingTeleportRotation;
+	int32 PendingPerturbationCompletions;
 	FVector InitialPosition;
 	FRotator InitialRotation;
 	FVector ActorInertiaTensor;
-	TArray<FPerturbationsInfo> PerturbationsInfos;
+	FPerturbationSchedule CompiledSchedule;
 	TWeakObjectPtr<UPrimitiveComponent> PhysicsBody;
 	TWeakObjectPtr<AActor> TargetActor;
+	bool bRecordJournal;
+	FExperimentJournal Journal;
+	FExperimentJournalTick RecordingTick;
+	TSharedPtr<const FExperimentJournal> ReplayJournal;
+	int32 ReplayTickIndex;
+	float ReplayDeviation;
 
 protected:
 	// Called when the game starts
 	virtual void BeginPlay() override;
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
 
+	void StepExperiment(float TimeDelta);
 	void ForwardMotion(float TimeDelta);
 	void ControllableMotion(float TimeDelta);
 	void PerturbedMotion(float TimeDelta);
-	void ApplyControl() const;
-
-	FVector NewtonsTorqueToRadians(FVector Direction, float TorqueScale) const;
+	void ApplyControl(float TimeDelta);
+	void ApplySegment(const FPerturbationSegment* Segment, float TimeDelta);
+
+	// Forces are handed to the body once per frame by ApplyBodyCommands. In fixed timestep mode they are
+	// kept per step and applied by StepPhysics in every physics substep, so they do not depend on frame rate.
+	void ApplyForce(const FVector& Force, float TimeDelta);
+	void ApplyTorque(const FVector& Torque, float TimeDelta);
+	void QueuePhysicsSteps();
+	void StepPhysics(float DeltaTime, FBodyInstance* BodyInstance);
+	void ResetBodyVelocity();
+	void ResetBodyPose();
+	void UnregisterFromBatch();
+
+	void BeginJournalTick(float DeltaTime);
+	void EndJournalTick();
+	void ReplayStep();
 };
@@ -0,0 +1,68 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "QualityTestingTypes.h"
+
+// Everything UExperimentExecutionComponent did to its body during one component tick.
+struct QUALITYTESTING_API FExperimentJournalTick
+{
+	enum EFlags : uint8
+	{
+		// Force and Torque are impulses summed over the fixed steps of the frame.
+		Impulse = 1 << 0,
+		VelocityReset = 1 << 1,
+		Teleport = 1 << 2,
+		PerturbationComplete = 1 << 3,
+		// Set on save, tell the loader which optional fields follow.
+		HasForce = 1 << 4,
+		HasTorque = 1 << 5,
+	};
+
+	uint32 TickIndex = 0;
+	float DeltaTime = 0.f;
+	// State after the tick.
+	float CurrentTime = 0.f;
+	EExperimentState State = EExperimentState::WaitingForStart;
+	EMovementPhase Phase = EMovementPhase::Acceleration;
+	uint8 Flags = 0;
+	// Actor location when the tick started, used to check a replay for drift.
+	FVector Location = FVector::ZeroVector;
+	FVector Force = FVector::ZeroVector;
+	FVector Torque = FVector::ZeroVector;
+	FVector TeleportLocation = FVector::ZeroVector;
+	FRotator TeleportRotation = FRotator::ZeroRotator;
+
+	friend FArchive& operator<<(FArchive& Ar, FExperimentJournalTick& Tick);
+};
+
+/**
+ * Binary per-tick journal of an experiment session (.qtj).
+ * Forces and torques are stored in world space as they were handed to the body,
+ * so a replay needs neither the schedule nor the input that produced them.
+ */
+class QUALITYTESTING_API FExperimentJournal
+{
+public:
+	static constexpr uint32 MagicValue = 0x4A455451; // "QTEJ"
+	static constexpr uint16 CurrentVersion = 1;
+
+	void Reset();
+
+	bool SaveToFile(const FString& FilePath) const;
+	bool LoadFromFile(const FString& FilePath);
+
+	// Sum of all tick deltas, the session's real duration.
+	float GetDuration() const;
+
+	EExperimentState InitialState = EExperimentState::WaitingForStart;
+	float FixedStepDelta = 0.f;
+	FVector StartLocation = FVector::ZeroVector;
+	FRotator StartRotation = FRotator::ZeroRotator;
+	FVector StartLinearVelocity = FVector::ZeroVector;
+	FVector StartAngularVelocity = FVector::ZeroVector;
+	TArray<FExperimentJournalTick> Ticks;
+
+	friend FArchive& operator<<(FArchive& Ar, FExperimentJournal& Journal);
+};
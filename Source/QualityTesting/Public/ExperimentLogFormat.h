@@ -0,0 +1,135 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "ExperimentRecorder.h"
+#include "QualityTestingTypes.h"
+
+class IMappedFileHandle;
+class IMappedFileRegion;
+
+/**
+ * Read-only view of a whole file. Memory-mapped where the platform supports it,
+ * loaded into an owned buffer otherwise.
+ */
+class QUALITYTESTING_API FMappedFileView
+{
+public:
+	FMappedFileView();
+	~FMappedFileView();
+
+	bool Open(const FString& FilePath);
+	void Close();
+
+	const uint8* GetData() const;
+	int64 GetSize() const;
+
+private:
+	TUniquePtr<IMappedFileHandle> MappedFile;
+	TUniquePtr<IMappedFileRegion> MappedRegion;
+	TArray<uint8> FallbackData;
+
+	const uint8* Data;
+	int64 DataSize;
+};
+
+/**
+ * Binary columnar experiment log (.qtl).
+ *
+ * Layout: FExperimentLogHeader, state dictionary (uint16 length + UTF-8 bytes per state),
+ * then one column per field: frame index (uint32), state id (uint8), X, Y, Z (float or double).
+ * Every column starts on an 8-byte boundary so a mapped file can be read in place.
+ */
+struct QUALITYTESTING_API FExperimentLogHeader
+{
+	static constexpr uint32 MagicValue = 0x4C455451; // "QTEL"
+	static constexpr uint16 CurrentVersion = 1;
+
+	uint32 Magic;
+	uint16 Version;
+	uint8 bDoublePrecision;
+	uint8 Reserved;
+	uint32 SampleCount;
+	uint32 StateCount;
+	uint64 StateTableOffset;
+	uint64 FrameColumnOffset;
+	uint64 StateColumnOffset;
+	uint64 LocationColumnOffsets[3];
+};
+
+class QUALITYTESTING_API FExperimentLogWriter
+{
+public:
+	static bool SaveToFile(const FString& FilePath, TArrayView<const FExperimentSample> Samples,
+	                       const TArray<FString>& StateNames, bool bDoublePrecision);
+
+	// Builds the whole file in memory, so it can be written from any thread.
+	static void Serialize(TArrayView<const FExperimentSample> Samples, const TArray<FString>& StateNames,
+	                      bool bDoublePrecision, TArray<uint8>& OutBuffer);
+};
+
+/**
+ * Compressed result file: FCompressedResultHeader followed by one FCompression block.
+ * The payload is the file that would have been written uncompressed (text rows or .qtl).
+ */
+struct QUALITYTESTING_API FCompressedResultHeader
+{
+	static constexpr uint32 MagicValue = 0x5A435451; // "QTCZ"
+	static constexpr uint16 CurrentVersion = 1;
+
+	uint32 Magic;
+	uint16 Version;
+	uint8 Format;
+	uint8 Reserved;
+	uint64 UncompressedSize;
+	uint64 CompressedSize;
+};
+
+class QUALITYTESTING_API FCompressedResult
+{
+public:
+	// Returns false if the payload could not be compressed. EResultCompression::None copies the payload as is.
+	static bool Compress(EResultCompression Compression, TArrayView<const uint8> Payload, TArray<uint8>& OutData);
+
+	// Passes data without a FCompressedResultHeader through unchanged.
+	static bool Decompress(const uint8* Data, int64 Size, TArray<uint8>& OutPayload);
+
+	static bool IsCompressed(const uint8* Data, int64 Size);
+};
+
+/**
+ * Reads a .qtl file through a memory mapping. Columns are exposed as views into the mapping,
+ * nothing is copied except the state names.
+ */
+class QUALITYTESTING_API FExperimentLogReader
+{
+public:
+	FExperimentLogReader();
+	~FExperimentLogReader();
+
+	bool Open(const FString& FilePath);
+	void Close();
+
+	int32 Num() const;
+	bool IsDoublePrecision() const;
+
+	TArrayView<const uint32> GetFrameIndices() const;
+	TArrayView<const uint8> GetStateIds() const;
+	TArrayView<const float> GetFloatColumn(int32 Axis) const;
+	TArrayView<const double> GetDoubleColumn(int32 Axis) const;
+
+	FVector GetLocation(int32 Index) const;
+	const FString& GetStateName(int32 Index) const;
+	const TArray<FString>& GetStateNames() const;
+
+private:
+	bool Parse();
+	bool FitsInData(uint64 Offset, uint64 Count, uint64 ElementSize) const;
+
+	FMappedFileView File;
+	const uint8* Data;
+	int64 DataSize;
+	const FExperimentLogHeader* Header;
+	TArray<FString> StateNames;
+};
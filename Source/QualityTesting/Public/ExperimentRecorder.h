@@ -0,0 +1,98 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Containers/CircularQueue.h"
+#include "HAL/Runnable.h"
+#include "HAL/ThreadSafeBool.h"
+#include "HAL/ThreadSafeCounter64.h"
+
+class IFileHandle;
+class FRunnableThread;
+struct FExperimentTextLine;
+
+/**
+ * Fixed-size trajectory sample as it travels from the game thread to the writer thread.
+ * The experiment state is stored as an index into the recorder's state dictionary.
+ * FrameIndex is GFrameCounter when the sample was taken. It goes to the frame column of .qtl files,
+ * text rows keep the SaveToFile layout and leave it out.
+ */
+struct QUALITYTESTING_API FExperimentSample
+{
+	// State dictionaries hold at most this many names. Later states all share this id.
+	static constexpr uint8 OverflowStateId = MAX_uint8;
+	static const TCHAR* OverflowStateName;
+
+	// Returns the id of StateName, adding it to the dictionary if needed.
+	static uint8 InternState(TArray<FString>& StateNames, TMap<FString, uint8>& StateIds, const FString& StateName);
+
+	uint32 FrameIndex;
+	uint8 StateId;
+	FVector Location;
+};
+
+/**
+ * Streams experiment samples to an append-only file.
+ * Push() is called from the game thread and never blocks: samples go into a fixed-capacity
+ * ring and a background thread drains them to disk in chunks. Memory use does not grow
+ * with session length.
+ */
+class QUALITYTESTING_API FExperimentRecorder : public FRunnable
+{
+public:
+	explicit FExperimentRecorder(uint32 InCapacity);
+	virtual ~FExperimentRecorder() override;
+
+	bool Open(const FString& FilePath);
+	void Close();
+
+	// Returns false if the ring is full and the sample was dropped.
+	bool Push(const FExperimentTextLine& TextLine);
+	bool Push(const FExperimentSample& Sample);
+
+	// Writes out everything pushed so far. Blocks only if bWait is set.
+	void Flush(bool bWait);
+
+	// Samples pushed before this call go to the current file, everything after to NewFilePath.
+	void Rotate(const FString& NewFilePath);
+
+	uint8 InternState(const FString& StateName);
+
+	bool IsOpen() const;
+	int64 GetDroppedCount() const;
+
+	// FRunnable
+	virtual uint32 Run() override;
+	virtual void Stop() override;
+
+private:
+	void Drain();
+	bool WriteChunk();
+	bool OpenFileHandle(const FString& FilePath);
+	const FString& GetStateName(uint8 StateId);
+
+	TCircularQueue<FExperimentSample> Ring;
+
+	FRunnableThread* Thread;
+	FEvent* WakeEvent;
+	FEvent* FlushedEvent;
+	FThreadSafeBool bStopRequested;
+
+	TUniquePtr<IFileHandle> FileHandle;
+	FString ChunkText;
+
+	FCriticalSection StateLock;
+	TArray<FString> StateNames;
+	TMap<FString, uint8> StateIds;
+	TArray<FString> WriterStateNames;
+
+	FCriticalSection RotateLock;
+	FString PendingFilePath;
+	int64 RotateAtSample;
+
+	FThreadSafeCounter64 PushedCount;
+	FThreadSafeCounter64 WrittenCount;
+	FThreadSafeCounter64 FlushRequestedAt;
+	FThreadSafeCounter64 DroppedCount;
+};
@@ -0,0 +1,26 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Commandlets/Commandlet.h"
+#include "ExperimentReplayCommandlet.generated.h"
+
+/**
+ * Replays a recorded experiment journal headless, ticking a private world with the recorded
+ * frame deltas as fast as the CPU allows. Writes the replayed trajectory and reports how far
+ * it drifted from the recorded one. -Repeat runs the replay several times for profiling.
+ *
+ * UE4Editor-Cmd QualityTesting.uproject -run=ExperimentReplay -nullrhi -Journal=<path>
+ *     [-ProbeClass=<class path>] [-Output=Replay/Session] [-Binary] [-Repeat=1] [-MaxDeviation=<cm>]
+ */
+UCLASS()
+class QUALITYTESTING_API UExperimentReplayCommandlet : public UCommandlet
+{
+	GENERATED_BODY()
+
+public:
+	UExperimentReplayCommandlet();
+
+	virtual int32 Main(const FString& Params) override;
+};
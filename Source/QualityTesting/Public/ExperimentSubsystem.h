@@ -0,0 +1,74 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Engine/EngineBaseTypes.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "ExperimentSubsystem.generated.h"
+
+class UExperimentExecutionComponent;
+class UExperimentSubsystem;
+
+USTRUCT()
+struct FExperimentBatchTickFunction : public FTickFunction
+{
+	GENERATED_BODY()
+
+	UExperimentSubsystem* Target = nullptr;
+
+	virtual void ExecuteTick(float DeltaTime, ELevelTick TickType, ENamedThreads::Type CurrentThread,
+	                         const FGraphEventRef& MyCompletionGraphEvent) override;
+	virtual FString DiagnosticMessage() override;
+};
+
+template <>
+struct TStructOpsTypeTraits<FExperimentBatchTickFunction> : public TStructOpsTypeTraitsBase2<FExperimentBatchTickFunction>
+{
+	enum
+	{
+		WithCopy = false
+	};
+};
+
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FExperimentBatchUpdated, int32, NumActiveExperiments);
+
+/**
+ * Ticks every experiment set up with bUseBatchedTick from one pre-physics tick function instead of
+ * one component tick each. A frame gathers all body rotations, advances all experiments (in parallel
+ * from QualityTesting.BatchParallelThreshold experiments on), then applies the resulting forces and
+ * fires notifications on the game thread in registration order.
+ */
+UCLASS()
+class QUALITYTESTING_API UExperimentSubsystem : public UWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	virtual void Deinitialize() override;
+
+	void RegisterExperiment(UExperimentExecutionComponent* Experiment);
+	void UnregisterExperiment(UExperimentExecutionComponent* Experiment);
+
+	void TickExperiments(float DeltaTime);
+
+	UFUNCTION(BlueprintPure)
+	int32 GetNumActiveExperiments() const;
+
+	// Broadcast once per frame after all batched experiments were advanced.
+	UPROPERTY(BlueprintAssignable)
+	FExperimentBatchUpdated OnBatchUpdated;
+
+private:
+	UPROPERTY(Transient)
+	TArray<UExperimentExecutionComponent*> Experiments;
+
+	// Valid entries of Experiments for the running frame, so notifications may register and unregister freely.
+	UPROPERTY(Transient)
+	TArray<UExperimentExecutionComponent*> TickingExperiments;
+
+	TArray<UExperimentExecutionComponent*> FinishedExperiments;
+	bool bExperimentsChanged = false;
+
+	FExperimentBatchTickFunction BatchTickFunction;
+};
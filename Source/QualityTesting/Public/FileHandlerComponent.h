@@ -3,7 +3,10 @@
 #pragma once
 
 #include "CoreMinimal.h"
+#include "Async/Future.h"
 #include "Components/ActorComponent.h"
+#include "ExperimentRecorder.h"
+#include "QualityTestingTypes.h"
 #include "FileHandlerComponent.generated.h"
 
 
@@ -32,6 +35,17 @@ struct QUALITYTESTING_API FPerturbationsInfo
 	TArray<float> TorqueScaleList;
 };
 
+// Flat form of one schedule line: acceleration and deceleration values for both lists.
+struct QUALITYTESTING_API FPerturbationRecord
+{
+	float PerturbationsScale[2];
+	float TorqueScale[2];
+
+	FPerturbationsInfo ToPerturbationsInfo() const;
+};
+
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_TwoParams(FFileHandlerSaveCompleted, const FString&, FilePath, bool, bSuccess);
+
 UCLASS( ClassGroup=(Custom), meta=(BlueprintSpawnableComponent) )
 class QUALITYTESTING_API UFileHandlerComponent : public UActorComponent
 {
@@ -44,19 +58,90 @@ public:
 	UFUNCTION(BlueprintCallable)
 	void AddToWriteQueue(const FExperimentTextLine& TextLine);
 
+	UFUNCTION(BlueprintCallable)
+	void ClearWriteQueue();
+
 	UFUNCTION(BlueprintCallable)
 	bool SaveToFile(const FString& FileName, const FString& FileExtension);
 
+	// Writes the queue as a binary columnar log, see FExperimentLogHeader.
+	UFUNCTION(BlueprintCallable)
+	bool SaveToBinaryFile(const FString& FileName, const FString& FileExtension = TEXT("qtl"), bool bDoublePrecision = false);
+
+	// Hands the queue to a background task and returns immediately, the queue is left empty.
+	// Text rows are written as UTF-8. Compressed files start with FCompressedResultHeader.
+	UFUNCTION(BlueprintCallable)
+	void SaveToFileAsync(const FString& FileName, const FString& FileExtension,
+	                     EResultCompression Compression = EResultCompression::None);
+
+	UFUNCTION(BlueprintCallable)
+	void SaveToBinaryFileAsync(const FString& FileName, const FString& FileExtension = TEXT("qtl"),
+	                           bool bDoublePrecision = false, EResultCompression Compression = EResultCompression::None);
+
+	// Blocks until every async save started by this component is on disk.
+	UFUNCTION(BlueprintCallable)
+	void WaitForPendingSaves();
+
+	UFUNCTION(BlueprintPure)
+	int32 GetNumPendingSaves() const;
+
+	// Raised on the game thread when an async save has finished.
+	UPROPERTY(BlueprintAssignable)
+	FFileHandlerSaveCompleted OnSaveCompleted;
+
 	UFUNCTION(BlueprintPure)
 	TArray<FPerturbationsInfo> GetPerturbationsInfo(FVector& OutOffset) const;
 
+	// Schedule parsed by the last successful ReadFromFile. No copies are made.
+	const TArray<FPerturbationRecord>& GetPerturbationRecords(FVector& OutOffset) const;
+
 	UFUNCTION(BlueprintCallable)
 	bool ReadFromFile(const FString& FilePath);
+
+	// While streaming, AddToWriteQueue appends to Saved/Results/<name>.<ext> in the background instead of WriteCache.
+	UFUNCTION(BlueprintCallable)
+	bool StartStreaming(const FString& FileName, const FString& FileExtension, int32 Capacity = 8192);
+
+	UFUNCTION(BlueprintCallable)
+	void StopStreaming();
+
+	UFUNCTION(BlueprintCallable)
+	void FlushStream(bool bWait);
+
+	UFUNCTION(BlueprintCallable)
+	bool RotateStream(const FString& FileName, const FString& FileExtension);
+
+	UFUNCTION(BlueprintPure)
+	bool IsStreaming() const;
+
+	// Saved/Results/<FileName>.<FileExtension>
+	static FString MakeResultPath(const FString& FileName, const FString& FileExtension);
+
+	// Writes samples as the same text rows SaveToFile produces.
+	static bool SaveSamplesToFile(const FString& AbsolutePath, TArrayView<const FExperimentSample> Samples,
+	                              const TArray<FString>& StateNames);
+
+protected:
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
 	
 private:
-	static FString SerializeTextLine(const FExperimentTextLine& TextLine);
-	static FPerturbationsInfo DeserializeTextLine(const FString& TextLine);
+	static FString SerializeTextLine(const FString& ExperimentState, const FVector& Location);
+	static bool ParseSchedule(const uint8* Data, int64 Size, const FString& SourceName,
+	                          FVector& OutOffset, TArray<FPerturbationRecord>& OutRecords);
+
+	static void SerializeSamplesToText(TArrayView<const FExperimentSample> Samples, const TArray<FString>& StateNames,
+	                                   TArray<uint8>& OutBuffer);
+
+	uint8 InternState(const FString& ExperimentState);
+	void LaunchSave(const FString& AbsolutePath, bool bBinary, bool bDoublePrecision, EResultCompression Compression);
+
+	TArray<FExperimentSample> WriteCache;
+	TArray<FString> WriteStateNames;
+	TMap<FString, uint8> WriteStateIds;
+	FVector ScheduleOffset;
+	TArray<FPerturbationRecord> Schedule;
+	mutable TArray<FPerturbationsInfo> ScheduleInfos;
 
-	TArray<FString> WriteCache;
-	TArray<FString> ReadCache;
+	TSharedPtr<FExperimentRecorder> Recorder;
+	TArray<TFuture<bool>> PendingSaves;
 };
@@ -4,10 +4,14 @@
 
 #include "CoreMinimal.h"
 #include "GameFramework/Actor.h"
+#include "PhysicsEngine/BodyInstance.h"
+#include "QualityTestingTypes.h"
 #include "Mover.generated.h"
 
 class UStaticMeshComponent;
 
+DECLARE_DYNAMIC_MULTICAST_DELEGATE(FMoverMotionFinished);
+
 UCLASS(Blueprintable)
 class QUALITYTESTING_API AMover : public AActor
 {
@@ -35,6 +39,23 @@ public:
 	UFUNCTION(BlueprintCallable)
 	void SetPerturbationsScale(float NewScale);
 
+	// Runs the acceleration/drift/deceleration profile natively, stepped by the physics callback.
+	// The configuration can be changed while the motion runs, it is picked up on the next frame.
+	UFUNCTION(BlueprintCallable)
+	void StartMotion();
+
+	UFUNCTION(BlueprintCallable)
+	void StopMotion();
+
+	UFUNCTION(BlueprintPure)
+	EMovementPhase GetMotionPhase() const;
+
+	UFUNCTION(BlueprintPure)
+	bool IsMotionActive() const;
+
+	UPROPERTY(BlueprintAssignable)
+	FMoverMotionFinished OnMotionFinished;
+
 protected:
 	// Called when the game starts or when spawned
 	virtual void BeginPlay() override;
@@ -46,21 +67,56 @@ public:
 	UPROPERTY(Category = Mesh, VisibleDefaultsOnly, BlueprintReadOnly, meta = (AllowPrivateAccess = "true"))
 	UStaticMeshComponent* ProbeMesh;
 
-	UPROPERTY(Category = Configuration, VisibleDefaultsOnly, meta = (AllowPrivateAccess = "true"), BlueprintSetter = SetAccelerationTime)
+	// Phase durations in seconds.
+	UPROPERTY(Category = Configuration, EditAnywhere, BlueprintReadWrite, meta = (AllowPrivateAccess = "true", ClampMin = "0"), BlueprintSetter = SetAccelerationTime)
 	float AccelerationTime;
 
-	UPROPERTY(Category = Configuration, VisibleDefaultsOnly, meta = (AllowPrivateAccess = "true"), BlueprintSetter = SetDriftTime)
+	UPROPERTY(Category = Configuration, EditAnywhere, BlueprintReadWrite, meta = (AllowPrivateAccess = "true", ClampMin = "0"), BlueprintSetter = SetDriftTime)
 	float DriftTime;
 
-	UPROPERTY(Category = Configuration, VisibleDefaultsOnly, meta = (AllowPrivateAccess = "true"), BlueprintSetter = SetDeccelerationTime)
+	UPROPERTY(Category = Configuration, EditAnywhere, BlueprintReadWrite, meta = (AllowPrivateAccess = "true", ClampMin = "0"), BlueprintSetter = SetDeccelerationTime)
 	float DeccelerationTime;
 
-	UPROPERTY(Category = Configuration, VisibleDefaultsOnly, meta = (AllowPrivateAccess = "true"), BlueprintSetter = SetForceScale)
+	// Thrust along the forward vector, in Newtons.
+	UPROPERTY(Category = Configuration, EditAnywhere, BlueprintReadWrite, meta = (AllowPrivateAccess = "true"), BlueprintSetter = SetForceScale)
 	float ForceScale;
-	
-	UPROPERTY(Category = Configuration, VisibleDefaultsOnly, meta = (AllowPrivateAccess = "true"), BlueprintSetter = SetTorqueScale)
+
+	// Torque around the up vector while thrusting, divided by the inertia tensor like the perturbation torques.
+	UPROPERTY(Category = Configuration, EditAnywhere, BlueprintReadWrite, meta = (AllowPrivateAccess = "true"), BlueprintSetter = SetTorqueScale)
 	float TorqueScale;
 
-	UPROPERTY(Category = Configuration, VisibleDefaultsOnly, meta = (AllowPrivateAccess = "true"), BlueprintSetter = SetTorqueScale)
+	// Added to the thrust in both powered phases, as a perturbation does in PerturbedMotion.
+	UPROPERTY(Category = Configuration, EditAnywhere, BlueprintReadWrite, meta = (AllowPrivateAccess = "true"), BlueprintSetter = SetPerturbationsScale)
 	float PerturbationsScale;
+
+private:
+	// Snapshot of the configuration, taken on the game thread before each frame's simulation.
+	// All ends are cumulative times since StartMotion, converted once from the phase durations.
+	struct FMotionSettings
+	{
+		float AccelerationEnd;
+		float DriftEnd;
+		float DecelerationEnd;
+		float AccelerationForce;
+		float DecelerationForce;
+		FVector TorquePerUpAxis;
+
+		EMovementPhase GetPhaseAt(float Time) const;
+	};
+
+	void UpdateMotionSettings();
+	void StepMotion(float DeltaTime, FBodyInstance* BodyInstance);
+
+	FCalculateCustomPhysics OnCalculateCustomPhysics;
+	FVector InertiaTensor;
+
+	// Game thread only. The phase state machine runs in Tick.
+	EMovementPhase MotionPhase;
+	float MotionTime;
+	bool bMotionActive;
+
+	// Written by Tick before the simulation starts. StepMotion only reads the settings and only
+	// advances its own clock, so the physics callback shares no state with StartMotion/StopMotion.
+	FMotionSettings MotionSettings;
+	float SubstepTime;
 };
@@ -0,0 +1,42 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "FileHandlerComponent.h"
+#include "QualityTestingTypes.h"
+
+// Force and torque of one powered phase, ready to apply.
+struct QUALITYTESTING_API FPerturbationSegment
+{
+	// Along the body's forward vector.
+	float ForwardForce;
+	// Multiplied component-wise with the body's up vector, already divided by the inertia tensor.
+	FVector TorquePerUpAxis;
+	// False where the source lists were too short, the phase then applies nothing.
+	bool bApplies;
+};
+
+/**
+ * Perturbations compiled once per setup into a flat table of two segments each,
+ * acceleration then deceleration, so the motion tick does a single indexed lookup
+ * instead of copying the source lists and converting the torque every tick.
+ */
+class QUALITYTESTING_API FPerturbationSchedule
+{
+public:
+	void Compile(TArrayView<const FPerturbationsInfo> Perturbations, float ThrustForce, const FVector& InertiaTensor);
+	void Compile(TArrayView<const FPerturbationRecord> Perturbations, float ThrustForce, const FVector& InertiaTensor);
+	void Reset();
+
+	int32 Num() const;
+
+	// Segment for a powered phase, nullptr for other phases, out of range indices or phases that apply nothing.
+	const FPerturbationSegment* Find(int32 PerturbationIndex, EMovementPhase Phase) const;
+
+private:
+	void AddSegment(const float* Perturbation, const float* Torque, float ForceSign, float ThrustForce,
+	                const FVector& InertiaTensor);
+
+	TArray<FPerturbationSegment> Segments;
+};
@@ -0,0 +1,61 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Commandlets/Commandlet.h"
+#include "PerturbationSweepCommandlet.generated.h"
+
+class UExperimentExecutionComponent;
+class UFileHandlerComponent;
+struct FExecutionComponentInitializer;
+struct FExperimentSample;
+struct FPerturbationsInfo;
+
+/**
+ * Runs every perturbation of a schedule in a private game world without rendering,
+ * stepping the world as fast as the CPU allows and writing one result file per trial.
+ *
+ * With -Parallel[=N] the trials run in N FProbeScene worlds, each with its own physics scene and probe.
+ * The scenes are stepped in lockstep and their physics simulates concurrently. A summary with the final
+ * pose of every trial is written in trial order. With -VerifyParallel[=<cm>] the first trial also runs
+ * the serial way first, and the sweep fails unless both runs sample the same number of steps and every
+ * sampled location agrees within that distance. The default of 0 requires identical results.
+ *
+ * UE4Editor-Cmd QualityTesting.uproject -run=PerturbationSweep -nullrhi
+ *     -Schedule=<path> -PhaseDelta=<s> -Thrust=<N> [-StepRate=120] [-ProbeClass=<class path>]
+ *     [-Output=Sweep/Trial] [-Binary] [-MaxTrialTime=60] [-Parallel[=N]] [-VerifyParallel[=<cm>]]
+ */
+UCLASS()
+class QUALITYTESTING_API UPerturbationSweepCommandlet : public UCommandlet
+{
+	GENERATED_BODY()
+
+public:
+	UPerturbationSweepCommandlet();
+
+	virtual int32 Main(const FString& Params) override;
+
+private:
+	// OutPath, if given, receives the probe location after every step.
+	bool RunTrial(int32 TrialIndex, const FExecutionComponentInitializer& Initializer,
+	              UWorld* World, UExperimentExecutionComponent* Execution, UFileHandlerComponent* FileHandler,
+	              TArray<FVector>* OutPath = nullptr);
+
+	// OutFirstTrialPath receives the probe location after every step of trial 0.
+	int32 RunParallelSweep(UClass* ProbeClass, const TArray<FPerturbationsInfo>& Perturbations,
+	                       const FExecutionComponentInitializer& Initializer, int32 NumScenes,
+	                       TArray<FTransform>& OutFinalTransforms, TArray<FVector>& OutFirstTrialPath);
+
+	bool SaveTrial(int32 TrialIndex, TArrayView<const FExperimentSample> Samples, const TArray<FString>& StateNames) const;
+
+	FString OutputName;
+	// Where every trial starts: the schedule offset and the rotation the probe spawned with.
+	FVector StartLocation;
+	FRotator StartRotation;
+	float StepDelta;
+	float MaxTrialTime;
+	bool bBinaryOutput;
+	bool bVerifyParallel;
+	float VerifyTolerance;
+};
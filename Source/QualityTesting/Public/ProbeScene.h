@@ -0,0 +1,41 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+class AActor;
+class UExperimentExecutionComponent;
+class UWorld;
+struct FExecutionComponentInitializer;
+
+/**
+ * Private game world with its own physics scene and its own spawned probe, so trials in different
+ * scenes share nothing. Step() advances the experiments of several scenes on the game thread, then
+ * simulates all their physics scenes at the same time.
+ *
+ * Only the probe's experiment and the physics scene are stepped, the rest of the world is not ticked.
+ */
+class QUALITYTESTING_API FProbeScene
+{
+public:
+	FProbeScene(UClass* ProbeClass, int32 SceneIndex);
+	~FProbeScene();
+
+	bool IsValid() const;
+
+	// Teleports the probe to the start pose and sets its experiment up. TargetActor is replaced by this scene's probe.
+	void BeginTrial(const FExecutionComponentInitializer& Initializer, const FVector& StartLocation,
+	                const FRotator& StartRotation);
+	bool IsTrialFinished() const;
+
+	FTransform GetProbeTransform() const;
+
+	// One fixed step of every given scene, the same work a world tick does for the probe in the serial sweep.
+	static void Step(TArrayView<FProbeScene* const> Scenes, float StepDelta);
+
+private:
+	UWorld* World;
+	AActor* Probe;
+	UExperimentExecutionComponent* Execution;
+};
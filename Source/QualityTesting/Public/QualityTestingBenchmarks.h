@@ -0,0 +1,59 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Commandlets/Commandlet.h"
+#include "QualityTestingBenchmarks.generated.h"
+
+/**
+ * Times the QualityTesting math and I/O paths, checks every fast path against its reference
+ * and writes Saved/Results/<Report>.json.
+ *
+ * Math cases run for every power of ten between -MinPoints and -MaxPoints. File cases run the schedule
+ * parser and the result log writers and readers with -IOSamples rows. Unless -NoWorld is given, a phase case
+ * runs one perturbation through UExperimentExecutionComponent in a private world.
+ *
+ * With -Baseline=<report.json> a case that got more than -Tolerance slower than in the baseline counts as failed.
+ * The exit code is non-zero if any case failed. The same reference checks, without timing, run as the
+ * QualityTesting.* automation tests.
+ *
+ * UE4Editor-Cmd QualityTesting.uproject -run=QualityTestingBenchmark -nullrhi [-MinPoints=100] [-MaxPoints=10000000]
+ *     [-Runs=5] [-IOSamples=100000] [-Report=Benchmarks/Report] [-Baseline=<path>] [-Tolerance=0.25]
+ *     [-ProbeClass=<class path>] [-NoWorld]
+ */
+UCLASS()
+class QUALITYTESTING_API UQualityTestingBenchmarkCommandlet : public UCommandlet
+{
+	GENERATED_BODY()
+
+public:
+	UQualityTestingBenchmarkCommandlet();
+
+	virtual int32 Main(const FString& Params) override;
+
+private:
+	struct FBenchmarkCase
+	{
+		FString Name;
+		int32 Num;
+		double BestSeconds;
+		double MeanSeconds;
+		double BaselineSeconds;
+		bool bPassed;
+		bool bRegressed;
+	};
+
+	void AddCase(const FString& Name, int32 Num, double BestSeconds, double MeanSeconds, bool bPassed);
+
+	void RunMathCases(int32 NumPoints);
+	void RunFileCases(int32 NumSamples);
+	void RunExecutionCase(const FString& ProbeClassPath);
+
+	bool CompareWithBaseline(const FString& BaselinePath, float Tolerance);
+	bool WriteReport() const;
+
+	TArray<FBenchmarkCase> Cases;
+	FString ReportName;
+	int32 Runs;
+};
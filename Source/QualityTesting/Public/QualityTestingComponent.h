@@ -4,6 +4,8 @@
 
 #include "CoreMinimal.h"
 #include "Components/ActorComponent.h"
+#include "QualityTestingFL.h"
+#include "ReachabilityIndex.h"
 #include "QualityTestingComponent.generated.h"
 
 
@@ -16,20 +18,88 @@ public:
 	// Sets default values for this component's properties
 	UQualityTestingComponent();
 
+	// Keeps the points so a live search can continue from the result. C++ callers that are done
+	// with their array can MoveTemp it in instead of paying for a copy.
 	UFUNCTION(BlueprintCallable)
-	bool FindSaddlePoint(const TArray<FVector> Points,
+	bool FindSaddlePoint(TArray<FVector> Points,
 		const FVector& MinBound, const FVector& MaxBound);
 
+	// Starts a live search with no points. Points added afterwards keep the saddle point up to date.
+	UFUNCTION(BlueprintCallable)
+	void BeginIncrementalSearch(const FVector& MinBound, const FVector& MaxBound);
+
+	// O(1). Returns true if the point became the new saddle point candidate. A new candidate means
+	// the next UpdateSaddlePoint recounts coverage over all points, so a stream that keeps moving
+	// outward and queries after every point costs O(N) per point, O(N^2) in total.
+	UFUNCTION(BlueprintCallable)
+	bool AddReachabilityPoint(const FVector& Point);
+
+	UFUNCTION(BlueprintCallable)
+	void AddReachabilityPoints(const TArray<FVector>& Points);
+
+	// Changing the bounds is the only operation that rescans all points.
+	UFUNCTION(BlueprintCallable)
+	void SetReachableBounds(const FVector& MinBound, const FVector& MaxBound);
+
+	// Same result FindSaddlePoint would give for all points added so far.
+	UFUNCTION(BlueprintCallable)
+	bool UpdateSaddlePoint();
+
+	// Indexes every point added so far. Bounds changes and coverage checks over indexed points
+	// then cost a tree query instead of a full pass. Repeated queries over enough points build
+	// the index on their own, so this is only needed to pay the build cost up front.
+	UFUNCTION(BlueprintCallable)
+	void BuildReachabilityIndex();
+
+	// Saddle point and J0 for other bounds, without changing the current result.
+	UFUNCTION(BlueprintCallable)
+	int32 EvaluateReachableBounds(const FVector& MinBound, const FVector& MaxBound, float& OutJ0) const;
+
+	UFUNCTION(BlueprintPure)
+	int32 CountReachabilityPointsWithin(const FVector& Center, float Radius) const;
+
+	UFUNCTION(BlueprintPure)
+	int32 FindNearestReachabilityPoint(const FVector& Point, float& OutDistance) const;
+
 	UFUNCTION(BlueprintPure)
 	float EvaluateScore(FVector TestingPoint) const;
 
+	// Scores every point against the current J0, see UQualityTestingFL::EvaluateScores.
+	UFUNCTION(BlueprintCallable)
+	FScoreStatistics EvaluateScores(const TArray<FVector>& TestingPoints, const TArray<float>& Percentiles,
+		TArray<float>& OutScores) const;
+
 	UFUNCTION(BlueprintPure)
 	int32 GetSaddlePointIdx() const;
 
 private:
+	void RebuildCandidate();
+	void ResolveCoverage();
+	// Called before every full pass over the unindexed points.
+	void UpdateReachabilityIndex() const;
+
+	// Below this many unindexed points a linear pass beats building the tree.
+	static constexpr int32 MinIndexedPoints = 1024;
+
 	int32 SaddlePointIdx;
 	float J0;
 	FVector SaddlePoint;
 	FVector MinReachableBound;
 	FVector MaxReachableBound;
+
+	// Incremental search state. The candidate is the point furthest from the bounds interval;
+	// it is the saddle point once every point lies within CandidateDistance of CandidateProjection.
+	TArray<FVector> ReachabilityPoints;
+	FBox PointsBounds;
+	int32 CandidateIdx;
+	float CandidateDistance;
+	FVector CandidateProjection;
+	int32 UncoveredCount;
+	bool bCoverageDirty;
+
+	// Covers the first ReachabilityIndex.Num() points, later ones are checked linearly.
+	// Built lazily from const queries as well, hence mutable.
+	mutable FReachabilityIndex ReachabilityIndex;
+	// Full passes over the current unindexed points since the index was last built.
+	mutable int32 UnindexedScans;
 };
@@ -6,6 +6,30 @@
 #include "Kismet/BlueprintFunctionLibrary.h"
 #include "QualityTestingFL.generated.h"
 
+class FReachabilityIndex;
+
+USTRUCT(BlueprintType)
+struct QUALITYTESTING_API FScoreStatistics
+{
+	GENERATED_BODY()
+
+	UPROPERTY(BlueprintReadOnly)
+	int32 Count = 0;
+
+	UPROPERTY(BlueprintReadOnly)
+	float Min = 0.f;
+
+	UPROPERTY(BlueprintReadOnly)
+	float Max = 0.f;
+
+	UPROPERTY(BlueprintReadOnly)
+	float Mean = 0.f;
+
+	// One value per requested percentile, linearly interpolated between ranks.
+	UPROPERTY(BlueprintReadOnly)
+	TArray<float> Percentiles;
+};
+
 /**
  * 
  */
@@ -23,5 +47,33 @@ public:
 	UFUNCTION(BlueprintCallable)
 	static float EvaluateScore(const float& J0, const FVector& TestingPoint);
 
+	// Scores a whole trajectory in one call. Percentiles are in [0, 100].
+	UFUNCTION(BlueprintCallable)
+	static FScoreStatistics EvaluateScores(const float& J0, const TArray<FVector>& TestingPoints,
+	                                       const TArray<float>& Percentiles, TArray<float>& OutScores);
+
+	// Same as EvaluateScore for every point, four points at a time. OutScores must be as long as TestingPoints.
+	static void EvaluateScoresVectorized(float J0, TArrayView<const FVector> TestingPoints, TArrayView<float> OutScores);
+
+	// Non-finite scores (points at the origin) are left out of the statistics.
+	static FScoreStatistics ComputeScoreStatistics(TArrayView<const float> Scores, TArrayView<const float> Percentiles);
+
 	static float DistanceToInterval(FVector Point, const TPair<FVector, FVector>& Interval, FVector& OutProjection);
+
+	// Reference implementation: two scalar passes over AoS points.
+	static int32 FindSaddlePointScalar(TArrayView<const FVector> Points,
+	                                   const FVector& RZ_LowerBound, const FVector& RZ_UpperBound,
+	                                   float& OutJ0);
+
+	// Same result as FindSaddlePointScalar. Works on an SoA copy of the points four at a time
+	// and splits large inputs across worker threads.
+	static int32 FindSaddlePointVectorized(TArrayView<const FVector> Points,
+	                                       const FVector& RZ_LowerBound, const FVector& RZ_UpperBound,
+	                                       float& OutJ0, bool bAllowParallel = true);
+
+	// Same result as FindSaddlePointScalar over the points the index was built from.
+	// Usually touches only a few leaves, so repeated queries with different bounds stay cheap.
+	static int32 FindSaddlePointIndexed(const FReachabilityIndex& Index,
+	                                    const FVector& RZ_LowerBound, const FVector& RZ_UpperBound,
+	                                    float& OutJ0);
 };
@@ -19,3 +19,11 @@ enum class EMovementPhase : uint8
 	Finished		UMETA(DisplayName="Finished"),
 	Idle			UMETA(DisplayName="Idle"),
 };
+
+UENUM(BlueprintType)
+enum class EResultCompression : uint8
+{
+	None	UMETA(DisplayName="None"),
+	Zlib	UMETA(DisplayName="Zlib"),
+	LZ4		UMETA(DisplayName="LZ4"),
+};
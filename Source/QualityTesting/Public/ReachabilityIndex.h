@@ -0,0 +1,59 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+/**
+ * Static k-d tree over a set of reachability samples.
+ * Built once per dataset, then answers radius, nearest and farthest-from-segment queries
+ * without visiting every sample. Results are indices into the array the index was built from,
+ * and distance tests match the linear code in UQualityTestingFL exactly.
+ */
+class QUALITYTESTING_API FReachabilityIndex
+{
+public:
+	void Build(TArrayView<const FVector> InPoints);
+	void Reset();
+
+	int32 Num() const;
+	bool IsEmpty() const;
+
+	// Number of samples with FVector::Distance(Center, Sample) <= Radius.
+	int32 CountWithinRadius(const FVector& Center, float Radius) const;
+
+	// Same test as CountWithinRadius, but stops at the first sample outside.
+	bool AllWithinRadius(const FVector& Center, float Radius) const;
+
+	// Lowest index on ties. Returns INDEX_NONE if the index is empty.
+	int32 FindNearest(const FVector& Point, float& OutDistance) const;
+
+	// Sample with the largest UQualityTestingFL::DistanceToInterval, lowest index on ties.
+	// Returns INDEX_NONE if every sample lies on the segment or the segment is degenerate.
+	int32 FindFarthestFromSegment(const FVector& A, const FVector& B, float& OutDistance, FVector& OutProjection) const;
+
+private:
+	struct FNode
+	{
+		FBox Bounds;
+		int32 Begin;
+		int32 End;
+		int32 Left;
+		int32 Right;
+	};
+
+	struct FFarthestQuery;
+
+	int32 BuildNode(int32 Begin, int32 End);
+	void SelectNth(int32 Begin, int32 End, int32 Nth, int32 Axis);
+
+	int32 CountWithinRadius(int32 NodeIndex, const FVector& Center, float Radius, float RadiusSquared) const;
+	bool AllWithinRadius(int32 NodeIndex, const FVector& Center, float Radius, float RadiusSquared) const;
+	void FindNearest(int32 NodeIndex, const FVector& Point, float& BestDistanceSquared, int32& BestIndex) const;
+	void FindFarthest(int32 NodeIndex, FFarthestQuery& Query) const;
+
+	TArray<FNode> Nodes;
+	// Samples reordered so every node covers a contiguous range.
+	TArray<FVector> Points;
+	TArray<int32> SourceIndices;
+};
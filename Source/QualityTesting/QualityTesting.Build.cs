@@ -9,6 +9,8 @@ public class QualityTesting : ModuleRules
 		PCHUsage = PCHUsageMode.UseExplicitOrSharedPCHs;
 
 		PublicDependencyModuleNames.AddRange(new string[] { "Core", "CoreUObject", "Engine", "InputCore" });
+
+		PrivateDependencyModuleNames.AddRange(new string[] { "Json" });
 		
 		PublicIncludePaths.AddRange(new string[] { "QualityTesting/Public" });
 	}